@@ -0,0 +1,206 @@
+#pragma once
+// Minimal google-benchmark style runner: auto-calibrated iteration counts,
+// median of repetitions, console table and google-benchmark compatible JSON.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace bench
+{
+    using clock = std::chrono::steady_clock;
+
+    // --- optimizer barriers ------------------------------------------------------
+
+    template<typename T>
+    inline void do_not_optimize(const T& v) noexcept
+    {
+        #if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : "r,m"(v) : "memory");
+        #else
+            static volatile const void* sink;
+            sink = &v;
+        #endif
+    }
+
+    inline void clobber() noexcept
+    {
+        #if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : : "memory");
+        #else
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        #endif
+    }
+
+    // --- state (passed to every benchmark body) ----------------------------------
+
+    class state
+    {
+        std::size_t iters_;
+
+    public:
+        explicit state(std::size_t iters) noexcept : iters_(iters) {}
+        std::size_t iterations() const noexcept { return iters_; }
+    };
+
+    struct entry
+    {
+        std::string                 name;
+        std::size_t                 bytes_per_iter = 0;   // 0: no throughput column
+        std::size_t                 items_per_iter = 0;
+        std::function<void(state&)> body;                 // runs state.iterations() times
+    };
+
+    struct result
+    {
+        std::string name;
+        std::size_t iterations = 0;
+        double      ns_per_iter = 0;
+        double      bytes_per_sec = 0;
+        double      items_per_sec = 0;
+    };
+
+    // --- registry / runner -------------------------------------------------------
+
+    class runner
+    {
+        std::vector<entry> entries_;
+        double             min_time_ = 0.25;     // seconds per repetition
+        int                reps_     = 3;
+        std::string        filter_;
+        std::string        json_path_;
+
+        static double time_once(const entry& e, std::size_t iters)
+        {
+            state st{ iters };
+            auto const t0 = clock::now();
+            e.body(st);
+            auto const t1 = clock::now();
+            return std::chrono::duration<double>(t1 - t0).count();
+        }
+
+        result measure(const entry& e) const
+        {
+            // grow the iteration count until one run takes a tenth of the budget
+            std::size_t iters = 1;
+            double t = time_once(e, iters);
+            while (t < min_time_ / 10 && iters < (std::size_t{ 1 } << 40)) {
+                iters *= t <= 0 ? 10 : std::max<std::size_t>(2, static_cast<std::size_t>(min_time_ / 10 / t));
+                t = time_once(e, iters);
+            }
+            iters = std::max<std::size_t>(1, static_cast<std::size_t>(static_cast<double>(iters) * min_time_ / std::max(t, 1e-9)));
+
+            std::vector<double> per_iter;
+            for (int r = 0; r < reps_; ++r)
+                per_iter.push_back(time_once(e, iters) / static_cast<double>(iters));
+            std::sort(per_iter.begin(), per_iter.end());
+            double const sec = per_iter[per_iter.size() / 2];
+
+            result out;
+            out.name          = e.name;
+            out.iterations    = iters;
+            out.ns_per_iter   = sec * 1e9;
+            out.bytes_per_sec = e.bytes_per_iter ? static_cast<double>(e.bytes_per_iter) / sec : 0;
+            out.items_per_sec = e.items_per_iter ? static_cast<double>(e.items_per_iter) / sec : 0;
+            return out;
+        }
+
+        static std::string escape(std::string_view s)
+        {
+            std::string o;
+            for (char c : s) {
+                if (c == '"' || c == '\\') o += '\\';
+                o += c;
+            }
+            return o;
+        }
+
+        void write_json(const std::vector<result>& rs) const
+        {
+            std::FILE* f = json_path_ == "-" ? stdout : std::fopen(json_path_.c_str(), "w");
+            if (!f) { std::fprintf(stderr, "cannot open %s\n", json_path_.c_str()); return; }
+
+            std::fprintf(f, "{\n  \"context\": {\n    \"executable\": \"stx_bench\",\n");
+            std::fprintf(f, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+            std::fprintf(f, "    \"library_build_type\": \"%s\"\n  },\n",
+                #if defined(NDEBUG)
+                    "release"
+                #else
+                    "debug"
+                #endif
+            );
+            std::fprintf(f, "  \"benchmarks\": [\n");
+            for (std::size_t i = 0; i < rs.size(); ++i) {
+                auto const& r = rs[i];
+                std::fprintf(f, "    {\n      \"name\": \"%s\",\n      \"run_type\": \"iteration\",\n", escape(r.name).c_str());
+                std::fprintf(f, "      \"iterations\": %zu,\n      \"real_time\": %.4f,\n      \"cpu_time\": %.4f,\n      \"time_unit\": \"ns\"", r.iterations, r.ns_per_iter, r.ns_per_iter);
+                if (r.bytes_per_sec > 0) std::fprintf(f, ",\n      \"bytes_per_second\": %.1f", r.bytes_per_sec);
+                if (r.items_per_sec > 0) std::fprintf(f, ",\n      \"items_per_second\": %.1f", r.items_per_sec);
+                std::fprintf(f, "\n    }%s\n", i + 1 < rs.size() ? "," : "");
+            }
+            std::fprintf(f, "  ]\n}\n");
+            if (f != stdout) std::fclose(f);
+        }
+
+    public:
+        void add(std::string name, std::size_t bytes, std::size_t items, std::function<void(state&)> body)
+        {
+            entries_.push_back({ std::move(name), bytes, items, std::move(body) });
+        }
+
+        // --filter=<substr>  --min-time=<sec>  --reps=<n>  --json=<path|->  --list
+        int main(int argc, char** argv)
+        {
+            bool list = false;
+            for (int i = 1; i < argc; ++i) {
+                std::string_view a = argv[i];
+                auto val = [&](std::string_view key) -> const char* {
+                    return a.starts_with(key) ? argv[i] + key.size() : nullptr;
+                };
+                if      (auto v = val("--filter="))   filter_ = v;
+                else if (auto v = val("--min-time=")) min_time_ = std::atof(v);
+                else if (auto v = val("--reps="))     reps_ = std::max(1, std::atoi(v));
+                else if (auto v = val("--json="))     json_path_ = v;
+                else if (a == "--json")               json_path_ = "-";
+                else if (a == "--list")               list = true;
+                else {
+                    std::fprintf(stderr, "usage: %s [--filter=S] [--min-time=SEC] [--reps=N] [--json[=PATH]] [--list]\n", argv[0]);
+                    return 2;
+                }
+            }
+
+            std::vector<result> rs;
+            bool const table = json_path_ != "-";
+            if (table && !list)
+                std::printf("%-44s %14s %12s %14s\n", "benchmark", "ns/op", "iterations", "throughput");
+
+            for (auto const& e : entries_) {
+                if (!filter_.empty() && e.name.find(filter_) == std::string::npos)
+                    continue;
+                if (list) { std::printf("%s\n", e.name.c_str()); continue; }
+
+                auto r = measure(e);
+                if (table) {
+                    char tp[32] = "";
+                    if (r.bytes_per_sec > 0)      std::snprintf(tp, sizeof tp, "%.2f GiB/s", r.bytes_per_sec / (1 << 30));
+                    else if (r.items_per_sec > 0) std::snprintf(tp, sizeof tp, "%.2f M/s", r.items_per_sec / 1e6);
+                    std::printf("%-44s %14.2f %12zu %14s\n", r.name.c_str(), r.ns_per_iter, r.iterations, tp);
+                    std::fflush(stdout);
+                }
+                rs.push_back(std::move(r));
+            }
+
+            if (!json_path_.empty() && !list)
+                write_json(rs);
+            return 0;
+        }
+    };
+}
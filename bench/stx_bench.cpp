@@ -0,0 +1,895 @@
+// stx_bench: throughput / ns-per-op for the hot primitives, each next to a raw
+// memcpy / pointer baseline so abstraction overhead shows up as a ratio.
+//
+//   stx_bench [--filter=memcur] [--min-time=0.5] [--json=out.json]
+
+#include "harness.hpp"
+
+#include <lbyte/stx.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+using namespace lbyte::stx;
+
+namespace
+{
+    constexpr usize sizes[] = { usize{ 4 } << 10, usize{ 256 } << 10, usize{ 16 } << 20 };
+
+    std::string label(usize n)
+    {
+        if (n >= (usize{ 1 } << 20)) return std::to_string(n >> 20) + "M";
+        if (n >= (usize{ 1 } << 10)) return std::to_string(n >> 10) + "K";
+        return std::to_string(n);
+    }
+
+    std::vector<u8> random_bytes(usize n, u64 seed = 42)
+    {
+        std::vector<u8> v(n);
+        std::mt19937_64 rng{ seed };
+        for (auto& b : v) b = static_cast<u8>(rng());
+        return v;
+    }
+
+    // --- mem::read --------------------------------------------------------------
+
+    void reads(bench::runner& r)
+    {
+        for (auto n : sizes) {
+            auto buf = std::make_shared<std::vector<u8>>(random_bytes(n));
+            auto out = std::make_shared<std::vector<u8>>(n);
+
+            r.add("baseline/memcpy/" + label(n), n, 0, [buf, out](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    std::memcpy(out->data(), buf->data(), buf->size());
+                    bench::clobber();
+                }
+            });
+
+            r.add("baseline/raw_u32_loop/" + label(n), n, n / 4, [buf](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    u32 acc = 0;
+                    for (usize k = 0; k + 4 <= buf->size(); k += 4) {
+                        u32 v;
+                        std::memcpy(&v, buf->data() + k, 4);
+                        acc += v;
+                    }
+                    bench::do_not_optimize(acc);
+                }
+            });
+
+            r.add("mem::read<u32>/" + label(n), n, n / 4, [buf](bench::state& st) {
+                auto const base = rcast<uptr>(buf->data());
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    u32 acc = 0;
+                    for (usize k = 0; k + 4 <= buf->size(); k += 4)
+                        acc += mem::read<u32>(base + k);
+                    bench::do_not_optimize(acc);
+                }
+            });
+
+            r.add("mem::read_be<u32>/" + label(n), n, n / 4, [buf](bench::state& st) {
+                auto const base = rcast<uptr>(buf->data());
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    u32 acc = 0;
+                    for (usize k = 0; k + 4 <= buf->size(); k += 4)
+                        acc += mem::read_be<u32>(base + k);
+                    bench::do_not_optimize(acc);
+                }
+            });
+
+            r.add("mem::read_be_n<u32>/" + label(n), n, n / 4, [buf](bench::state& st) {
+                std::vector<u32> out(buf->size() / 4);
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    mem::read_be_n(buf->data(), std::span{ out });
+                    bench::clobber();
+                }
+            });
+        }
+    }
+
+    // --- ptr::walk (pointer chase) ----------------------------------------------
+
+    void walks(bench::runner& r)
+    {
+        for (auto n : sizes) {
+            // random cyclic permutation of nodes, each slot holds the next address
+            auto const count = n / sizeof(uptr);
+            auto nodes = std::make_shared<std::vector<uptr>>(count);
+            std::vector<usize> order(count);
+            std::iota(order.begin(), order.end(), usize{ 0 });
+            std::shuffle(order.begin() + 1, order.end(), std::mt19937_64{ 7 });
+            for (usize k = 0; k < count; ++k)
+                (*nodes)[order[k]] = rcast<uptr>(nodes->data() + order[(k + 1) % count]);
+
+            r.add("baseline/raw_chase/" + label(n), 0, count, [nodes, count](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    auto* p = rcast<const uptr*>(nodes->data());
+                    for (usize k = 0; k < count; ++k)
+                        p = rcast<const uptr*>(*p);
+                    bench::do_not_optimize(p);
+                }
+            });
+
+            r.add("ptr::walk/" + label(n), 0, count, [nodes, count](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    ptr<uptr> p{ nodes->data() };
+                    for (usize k = 0; k < count; ++k)
+                        p = p.walk(off_s{ 0 });
+                    bench::do_not_optimize(p);
+                }
+            });
+        }
+    }
+
+    // --- memcur::pop ------------------------------------------------------------
+
+    struct record { u32 id; u16 kind; u16 flags; u64 value; };
+
+    void pops(bench::runner& r)
+    {
+        for (auto n : sizes) {
+            auto buf = std::make_shared<std::vector<u8>>(random_bytes(n));
+            auto const recs = n / sizeof(record);
+
+            r.add("baseline/raw_ptr_records/" + label(n), n, recs, [buf, recs](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    auto const* p = buf->data();
+                    u64 acc = 0;
+                    for (usize k = 0; k < recs; ++k) {
+                        record rec;
+                        std::memcpy(&rec, p, sizeof rec);
+                        p += sizeof rec;
+                        acc += rec.id ^ rec.value;
+                    }
+                    bench::do_not_optimize(acc);
+                }
+            });
+
+            r.add("memcur::pop<record>/" + label(n), n, recs, [buf, recs](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    memcur cur{ buf->data(), buf->size() };
+                    u64 acc = 0;
+                    for (usize k = 0; k < recs; ++k) {
+                        auto rec = cur.pop<record>();
+                        acc += rec.id ^ rec.value;
+                    }
+                    bench::do_not_optimize(acc);
+                }
+            });
+
+            r.add("memcur::pop<u16>/" + label(n), n, n / 2, [buf](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    memcur cur{ buf->data(), buf->size() };
+                    u32 acc = 0;
+                    for (usize k = 0; k < buf->size() / 2; ++k)
+                        acc += cur.pop<u16>();
+                    bench::do_not_optimize(acc);
+                }
+            });
+        }
+    }
+
+    // --- io::read: istream vs map_file vs io::file -------------------------------
+
+    std::filesystem::path temp_file(usize n)
+    {
+        return std::filesystem::temp_directory_path() / ("stx_bench_" + label(n) + ".bin");
+    }
+
+    // random input file, written by the first benchmark that runs on it so
+    // --list and filtered-out runs never touch the disk
+    class temp_input
+    {
+        std::filesystem::path path_;
+        usize                 size_;
+        std::once_flag        once_;
+
+    public:
+        explicit temp_input(usize n) : path_(temp_file(n)), size_(n) {}
+
+        auto path() -> const std::filesystem::path&
+        {
+            std::call_once(once_, [this] {
+                auto data = random_bytes(size_);
+                std::ofstream{ path_, std::ios::binary }.write(rcast<const char*>(data.data()), static_cast<std::streamsize>(size_));
+            });
+            return path_;
+        }
+    };
+
+    void file_reads(bench::runner& r)
+    {
+        constexpr usize rec = 4096;
+
+        for (auto n : sizes) {
+            auto const in   = std::make_shared<temp_input>(n);
+            auto const recs = n / rec;
+
+            r.add("io::read/istream/" + label(n), n, recs, [in, recs](bench::state& st) {
+                std::ifstream file{ in->path(), std::ios::binary };
+                std::array<u8, rec> out;
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    for (usize k = 0; k < recs; ++k)
+                        (void)io::read<u8>(file, std::span{ out }, off_s{ static_cast<off_s::value_type>(k * rec) });
+                    bench::clobber();
+                }
+            });
+
+            r.add("io::read/map_file/" + label(n), n, recs, [in, recs](bench::state& st) {
+                auto m = map_file::open(in->path(), map_flag::populate).value();
+                std::array<u8, rec> out;
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    m.seek(off_s{ 0 });
+                    for (usize k = 0; k < recs; ++k) {
+                        m.pop_into(out);
+                        bench::do_not_optimize(out);
+                    }
+                }
+            });
+
+            r.add("io::read/file_read_at/" + label(n), n, recs, [in, recs](bench::state& st) {
+                auto f = io::file::open(in->path()).value();
+                std::array<std::byte, rec> out;
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    for (usize k = 0; k < recs; ++k)
+                        (void)f.read_at(off_s{ static_cast<off_s::value_type>(k * rec) }, out);
+                    bench::clobber();
+                }
+            });
+
+            r.add("io::read/file_batch/" + label(n), n, recs, [in, recs](bench::state& st) {
+                auto f = io::file::open(in->path()).value();
+                std::vector<std::byte> out(recs * rec);
+                std::vector<io::read_req> reqs;
+                for (usize k = 0; k < recs; ++k)
+                    reqs.push_back({ off_s{ static_cast<off_s::value_type>(k * rec) }, std::span{ out }.subspan(k * rec, rec) });
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    auto res = io::read(f, reqs);
+                    bench::do_not_optimize(res.data());
+                }
+            });
+        }
+    }
+
+    // serializer-shaped output: 64-byte pieces back to back
+    void file_writes(bench::runner& r)
+    {
+        constexpr usize piece = 64;
+
+        for (auto n : sizes) {
+            auto const path = std::make_shared<std::filesystem::path>(temp_file(n));
+            auto const data = std::make_shared<std::vector<u8>>(random_bytes(n));
+            auto const pieces = n / piece;
+
+            r.add("baseline/file_write_at/" + label(n), n, pieces, [path, data, pieces](bench::state& st) {
+                auto f = io::file::open(*path, io::file_mode::create).value();
+                auto const bytes = std::as_bytes(std::span{ *data });
+                for (usize i = 0; i < st.iterations(); ++i)
+                    for (usize k = 0; k < pieces; ++k)
+                        (void)f.write_at(off_s{ static_cast<off_s::value_type>(k * piece) }, bytes.subspan(k * piece, piece));
+            });
+
+            r.add("io::write/file_batch/" + label(n), n, pieces, [path, data, pieces](bench::state& st) {
+                auto f = io::file::open(*path, io::file_mode::create).value();
+                auto const bytes = std::as_bytes(std::span{ *data });
+                std::vector<io::write_req> reqs;
+                for (usize k = 0; k < pieces; ++k)
+                    reqs.push_back({ off_s{ static_cast<off_s::value_type>(k * piece) }, bytes.subspan(k * piece, piece) });
+                for (usize i = 0; i < st.iterations(); ++i)
+                    bench::do_not_optimize(io::write(f, reqs));
+            });
+        }
+    }
+
+    // --- ct::fixed_string / ct::str -----------------------------------------------
+
+    void strings(bench::runner& r)
+    {
+        r.add("baseline/std_string_ctor", 0, 1, [](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                std::string s{ "section .text not found in module" };
+                bench::do_not_optimize(s);
+            }
+        });
+
+        r.add("ct::str/str()", 0, 1, [](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                auto s = ct::str<"\n    section .text not found in module\n", ct::fmt::trim_block>.str();
+                bench::do_not_optimize(s);
+            }
+        });
+    }
+
+    // --- time::cycles / time::probe ----------------------------------------------
+
+    void clocks(bench::runner& r)
+    {
+        r.add("baseline/steady_clock_now", 0, 1, [](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                auto t = time::steady_clock::now();
+                bench::do_not_optimize(t);
+            }
+        });
+
+        r.add("time::cycles", 0, 1, [](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                auto t = time::cycles();
+                bench::do_not_optimize(t);
+            }
+        });
+
+        r.add("time::probe/scope", 0, 1, [](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                auto _ = time::probe<"bench.scope">{};
+                bench::clobber();
+            }
+        });
+    }
+
+    // --- timestamp batches ------------------------------------------------------
+
+    void timestamps(bench::runner& r)
+    {
+        // archive-index shaped: 64 Ki entries, valid 1980-2107 times
+        constexpr usize entries = 64 << 10;
+        std::mt19937 rng{ 11 };
+        auto dos = std::make_shared<std::vector<u32>>(entries);
+        auto ft  = std::make_shared<std::vector<u64>>(entries);
+        for (usize k = 0; k < entries; ++k) {
+            (*dos)[k] = (rng() % 128) << 25 | (rng() % 12 + 1) << 21 | (rng() % 28 + 1) << 16
+                      | (rng() % 24) << 11 | (rng() % 60) << 5 | (rng() % 30);
+            (*ft)[k]  = 116'444'736'000'000'000ULL + u64{ rng() } * 10'000'000 + rng() % 10'000'000;
+        }
+
+        r.add("baseline/from_dos_loop", 0, entries, [dos](bench::state& st) {
+            std::vector<u64> out(entries);
+            for (usize i = 0; i < st.iterations(); ++i) {
+                for (usize k = 0; k < entries; ++k) out[k] = time::to_unix(time::from_dos((*dos)[k]));
+                bench::do_not_optimize(out.data());
+                bench::clobber();
+            }
+        });
+
+        r.add("time::from_dos/batch", 0, entries, [dos](bench::state& st) {
+            std::vector<u64> out(entries);
+            for (usize i = 0; i < st.iterations(); ++i) {
+                time::from_dos(*dos, out);
+                bench::do_not_optimize(out.data());
+                bench::clobber();
+            }
+        });
+
+        r.add("baseline/from_filetime_loop", 0, entries, [ft](bench::state& st) {
+            std::vector<u64> out(entries);
+            for (usize i = 0; i < st.iterations(); ++i) {
+                for (usize k = 0; k < entries; ++k) out[k] = time::to_unix(time::from_filetime((*ft)[k]));
+                bench::do_not_optimize(out.data());
+                bench::clobber();
+            }
+        });
+
+        r.add("time::from_filetime/batch", 0, entries, [ft](bench::state& st) {
+            std::vector<u64> out(entries);
+            for (usize i = 0; i < st.iterations(); ++i) {
+                time::from_filetime(*ft, out);
+                bench::do_not_optimize(out.data());
+                bench::clobber();
+            }
+        });
+    }
+
+    // --- mem::arena ------------------------------------------------------------
+
+    void allocs(bench::runner& r)
+    {
+        constexpr usize tables = 1000;
+
+        r.add("baseline/heap_dirty_vector", 0, tables, [](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                for (usize k = 0; k < tables; ++k) {
+                    io::dirty_vector<u8> v(32 + k % 512);
+                    bench::do_not_optimize(v.data());
+                }
+            }
+        });
+
+        r.add("mem::arena/dirty_vector", 0, tables, [](bench::state& st) {
+            mem::arena pass;
+            for (usize i = 0; i < st.iterations(); ++i) {
+                for (usize k = 0; k < tables; ++k) {
+                    io::dirty_vector<u8, mem::arena_allocator<u8>> v(32 + k % 512, pass);
+                    bench::do_not_optimize(v.data());
+                }
+                pass.reset();
+            }
+        });
+    }
+
+    // --- strtab ------------------------------------------------------------------
+
+    void string_tables(bench::runner& r)
+    {
+        for (auto n : sizes) {
+            auto tab = std::make_shared<std::string>();
+            for (usize k = 0; tab->size() < n; ++k) {
+                *tab += "symbol_" + std::to_string(k * 2654435761u % 100000);
+                tab->push_back('\0');
+            }
+            tab->resize(n);
+            auto const strs = strtab::count(std::as_bytes(std::span{ *tab }));
+
+            r.add("baseline/strnlen_loop/" + label(n), n, strs, [tab](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    std::vector<std::string_view> out;
+                    for (const char *p = tab->data(), *e = p + tab->size(); p < e;) {
+                        auto const len = strnlen(p, static_cast<usize>(e - p));
+                        if (len) out.emplace_back(p, len);
+                        p += len + 1;
+                    }
+                    bench::do_not_optimize(out.data());
+                }
+            });
+
+            r.add("strtab::views/" + label(n), n, strs, [tab](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    auto out = strtab::views(std::as_bytes(std::span{ *tab }));
+                    bench::do_not_optimize(out.data());
+                }
+            });
+        }
+    }
+
+    // --- bit fields ---------------------------------------------------------------
+
+    template<usize Width, typename T>
+    void bitfield_case(bench::runner& r, usize n)
+    {
+        auto buf    = std::make_shared<std::vector<u8>>(random_bytes(n + 8));
+        auto fields = std::make_shared<std::vector<T>>(n * 8 / Width);
+        auto const tag = std::to_string(Width) + "x" + std::to_string(8 * sizeof(T)) + "/" + label(n);
+
+        // one unaligned load + shift + mask per field
+        r.add("baseline/bit_extract_loop/" + tag, n, fields->size(), [buf, fields](bench::state& st) {
+            constexpr u64 mask = (u64{ 1 } << Width) - 1;
+            for (usize i = 0; i < st.iterations(); ++i) {
+                auto* out = fields->data();
+                for (usize k = 0, bit = 0; k < fields->size(); ++k, bit += Width) {
+                    u64 v;
+                    std::memcpy(&v, buf->data() + bit / 8, 8);
+                    out[k] = static_cast<T>((v >> (bit % 8)) & mask);
+                }
+                bench::clobber();
+            }
+        });
+
+        r.add("unpack_bits/" + tag, n, fields->size(), [buf, fields](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                bench::do_not_optimize(unpack_bits<Width>(std::span<const u8>{ *buf }, std::span<T>{ *fields }));
+                bench::clobber();
+            }
+        });
+
+        r.add("pack_bits/" + tag, n, fields->size(), [buf, fields](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                bench::do_not_optimize(pack_bits<Width>(std::span<const T>{ *fields }, std::span<u8>{ *buf }));
+                bench::clobber();
+            }
+        });
+    }
+
+    void bitfields(bench::runner& r)
+    {
+        for (auto n : sizes) {
+            bitfield_case<1,  u8 >(r, n);
+            bitfield_case<5,  u8 >(r, n);
+            bitfield_case<12, u16>(r, n);
+            bitfield_case<20, u32>(r, n);
+        }
+    }
+
+    // --- ct::phf ------------------------------------------------------------------
+
+    void lookups(bench::runner& r)
+    {
+        constexpr std::array<std::string_view, 24> names{
+            ".text", ".rdata", ".data", ".pdata", ".rsrc", ".reloc", ".idata", ".edata",
+            ".tls", ".CRT", ".bss", ".didat", ".gfids", ".00cfg", ".xdata", ".debug",
+            "UPX0", "UPX1", ".aspack", ".adata", ".MPRESS1", ".MPRESS2", ".themida", ".vmp0",
+        };
+        constexpr auto& set = ct::phf<".text", ".rdata", ".data", ".pdata", ".rsrc", ".reloc", ".idata", ".edata",
+                                      ".tls", ".CRT", ".bss", ".didat", ".gfids", ".00cfg", ".xdata", ".debug",
+                                      "UPX0", "UPX1", ".aspack", ".adata", ".MPRESS1", ".MPRESS2", ".themida", ".vmp0">;
+
+        // every key once, in a scrambled order, plus as many misses
+        auto probes = std::make_shared<std::vector<std::string>>();
+        for (usize k = 0; k < names.size(); ++k) {
+            probes->emplace_back(names[k * 7 % names.size()]);
+            probes->emplace_back(std::string{ names[k] } + "$");
+        }
+
+        r.add("baseline/if_chain/24", 0, probes->size(), [probes, names](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                for (auto const& p : *probes) {
+                    usize at = names.size();
+                    for (usize k = 0; k < names.size(); ++k)
+                        if (p == names[k]) { at = k; break; }
+                    bench::do_not_optimize(at);
+                }
+            }
+        });
+
+        r.add("ct::phf::find/24", 0, probes->size(), [probes, &set](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                for (auto const& p : *probes)
+                    bench::do_not_optimize(set.find(p));
+            }
+        });
+    }
+
+    // --- addr -------------------------------------------------------------------
+
+    void translations(bench::runner& r)
+    {
+        // 16 sections of 0x1800 bytes, one page apart, 4K probes each: half
+        // random across the image, half in runs of 64 inside one section
+        auto regions = std::make_shared<std::vector<addr::region>>();
+        for (u32 i = 0; i < 16; ++i)
+            regions->push_back({ rva_s{ 0x1000 + i * 0x2000 }, 0x1800, off_s{ 0x400 + i * 0x1800 }, 0x1800 });
+        auto const m = std::make_shared<addr::map>(addr::map::build(*regions).value());
+
+        std::mt19937 rng{ 7 };
+        auto random = std::make_shared<std::vector<rva_s>>();
+        auto runs   = std::make_shared<std::vector<rva_s>>();
+        for (usize i = 0; i < 4096; ++i) {
+            random->push_back(rva_s{ 0x1000 + rng() % 0x20000 });
+            auto const sec = (i / 64) % 16;
+            runs->push_back(rva_s{ 0x1000 + sec * 0x2000 + rng() % 0x1800 });
+        }
+
+        auto linear = [regions](rva_s x) -> off_s {
+            for (auto const& s : *regions)
+                if (x.get() - s.rva.get() < s.virtual_size)
+                    return off_s{ s.raw.get() + (x.get() - s.rva.get()) };
+            return off_s{ -1 };
+        };
+
+        for (auto const& [name, probes] : { std::pair{ "random", random }, std::pair{ "runs", runs } }) {
+            r.add(std::string{ "baseline/linear_walk/" } + name, 0, probes->size(), [probes, linear](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i)
+                    for (auto x : *probes)
+                        bench::do_not_optimize(linear(x));
+            });
+
+            r.add(std::string{ "addr::map::to_off/" } + name, 0, probes->size(), [probes, m](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i)
+                    for (auto x : *probes)
+                        bench::do_not_optimize(m->to_off(x));
+            });
+        }
+    }
+
+    // --- hash -------------------------------------------------------------------
+
+    void hashes(bench::runner& r)
+    {
+        for (auto n : sizes) {
+            auto buf = std::make_shared<std::vector<u8>>(random_bytes(n));
+
+            r.add("baseline/crc32_bytewise/" + label(n), n, 0, [buf](bench::state& st) {
+                auto const& t = hash::details::crc_table<hash::details::crc32_poly>[0];
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    u32 c = ~0u;
+                    for (auto b : *buf)
+                        c = (c >> 8) ^ t[(c ^ b) & 0xFF];
+                    bench::do_not_optimize(c);
+                }
+            });
+
+            r.add("hash::crc32/" + label(n), n, 0, [buf](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i)
+                    bench::do_not_optimize(hash::crc32(*buf));
+            });
+
+            r.add("hash::crc32c/" + label(n), n, 0, [buf](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i)
+                    bench::do_not_optimize(hash::crc32c(*buf));
+            });
+
+            r.add("hash::xxh32/" + label(n), n, 0, [buf](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i)
+                    bench::do_not_optimize(hash::xxh32(*buf));
+            });
+
+            r.add("hash::xxh64/" + label(n), n, 0, [buf](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i)
+                    bench::do_not_optimize(hash::xxh64(*buf));
+            });
+        }
+    }
+
+    // --- digests ----------------------------------------------------------------
+
+    void digests(bench::runner& r)
+    {
+        for (auto n : sizes) {
+            auto buf = std::make_shared<std::vector<u8>>(random_bytes(n));
+
+            r.add("baseline/sha256_scalar/" + label(n), n, 0, [buf](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    std::array<u32, 8> s{};
+                    digest::details::sha256_scalar(s.data(), buf->data(), buf->size() / 64);
+                    bench::do_not_optimize(s);
+                }
+            });
+
+            r.add("digest::sha256/" + label(n), n, 0, [buf](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i)
+                    bench::do_not_optimize(digest::compute<digest::sha256>(std::as_bytes(std::span{ *buf })));
+            });
+
+            r.add("baseline/adler32_scalar/" + label(n), n, 0, [buf](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    u32 a = 1, b = 0;
+                    digest::details::adler_scalar(a, b, buf->data(), buf->size());
+                    bench::do_not_optimize(a + b);
+                }
+            });
+
+            r.add("digest::adler32/" + label(n), n, 0, [buf](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i)
+                    bench::do_not_optimize(digest::compute<digest::adler32>(std::as_bytes(std::span{ *buf })));
+            });
+
+            r.add("digest::crc32c_parallel/" + label(n), n, 0, [buf](bench::state& st) {
+                auto const bytes = std::as_bytes(std::span{ *buf });
+                digest::parallel const opt{ .chunk_size = usize{ 1 } << 20 };
+                for (usize i = 0; i < st.iterations(); ++i)
+                    bench::do_not_optimize(digest::compute<digest::crc32c>(bytes, opt));
+            });
+        }
+    }
+
+    // --- fixed signatures -------------------------------------------------------
+
+    template<usize N>
+    void signature(bench::runner& r, const ct::byte_block<N>& blk)
+    {
+        // every 64-byte record starts with the signature except for one flipped byte
+        constexpr usize records = 256;   // 16 KiB: L1-resident, compare-bound
+        auto buf = std::make_shared<std::vector<u8>>(random_bytes(records * 64 + N));
+        for (usize k = 0; k < records; ++k) {
+            std::memcpy(buf->data() + k * 64, blk.data(), N);
+            if (k % 8 == 7) (*buf)[k * 64 + k % N] ^= 1;
+        }
+
+        // opaque length: what a generic header check pays
+        r.add("baseline/memcmp/" + std::to_string(N), records * N, records, [buf, blk](bench::state& st) {
+            usize volatile len = N;
+            usize const n = len;
+            for (usize i = 0; i < st.iterations(); ++i) {
+                usize hits = 0;
+                for (usize k = 0; k < records; ++k)
+                    hits += std::memcmp(buf->data() + k * 64, blk.data(), n) == 0;
+                bench::do_not_optimize(hits);
+            }
+        });
+
+        r.add("ct::matches/" + std::to_string(N), records * N, records, [buf, blk](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                usize hits = 0;
+                for (usize k = 0; k < records; ++k)
+                    hits += ct::matches(buf->data() + k * 64, blk);
+                bench::do_not_optimize(hits);
+            }
+        });
+    }
+
+    void signatures(bench::runner& r)
+    {
+        signature(r, ct::vstr<"MZ">);
+        signature(r, ct::hex<"4D 5A 90 00 03 00 00 00">);
+        signature(r, ct::vstr<"!This program ca">);
+        signature(r, ct::vstr<"!This program cannot be run in DOS mode.">);
+    }
+
+    // --- indirect dispatch ------------------------------------------------------
+
+    // small distinct bodies, so the dispatch dominates
+    template<int K> [[gnu::noinline]] u32 op(u32 x) { return x * (2 * K + 1) + K; }
+
+    void dispatch(bench::runner& r)
+    {
+        // random ids over eight targets: an unpredictable indirect branch per call
+        constexpr usize calls = 4096;
+        auto ids = std::make_shared<std::vector<u32>>(calls);
+        std::mt19937 rng{ 7 };
+        for (auto& id : *ids) id = rng() % 8;
+
+        auto tab = std::make_shared<caller_table<u32(u32)>>(caller_table<u32(u32)>{
+            &op<0>, &op<1>, &op<2>, &op<3>, &op<4>, &op<5>, &op<6>, &op<7> });
+        using fixed = caller_switch<u32(u32), &op<0>, &op<1>, &op<2>, &op<3>, &op<4>, &op<5>, &op<6>, &op<7>>;
+
+        r.add("caller_table::call", 0, calls, [ids, tab](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                u32 acc = 0;
+                for (usize k = 0; k < calls; ++k) acc += tab->call((*ids)[k], scast<u32>(k));
+                bench::do_not_optimize(acc);
+            }
+        });
+
+        r.add("caller_table::call_batch", 0, calls, [ids, tab](bench::state& st) {
+            std::vector<u32> out(calls);
+            auto const args = std::views::iota(u32{ 0 }, scast<u32>(calls));
+            for (usize i = 0; i < st.iterations(); ++i) {
+                tab->call_batch(*ids, args, out.begin());
+                bench::do_not_optimize(out.data());
+                bench::clobber();
+            }
+        });
+
+        r.add("caller_table::call_known", 0, calls, [ids, tab](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                u32 acc = 0;
+                for (usize k = 0; k < calls; ++k)
+                    acc += tab->call_known<&op<0>, &op<1>, &op<2>, &op<3>>((*ids)[k], scast<u32>(k));
+                bench::do_not_optimize(acc);
+            }
+        });
+
+        r.add("caller_switch::call", 0, calls, [ids](bench::state& st) {
+            for (usize i = 0; i < st.iterations(); ++i) {
+                u32 acc = 0;
+                for (usize k = 0; k < calls; ++k) acc += fixed::call((*ids)[k], scast<u32>(k));
+                bench::do_not_optimize(acc);
+            }
+        });
+    }
+
+    // --- rings ------------------------------------------------------------------
+
+    void rings(bench::runner& r)
+    {
+        // one thread, both ends: the per-element cost a pipeline stage pays
+        // for its hand-off, without scheduler noise
+        constexpr usize items = 4096;
+        constexpr usize batch = 64;
+
+        r.add("baseline/mutex_deque", 0, items, [](bench::state& st) {
+            std::mutex       mtx;
+            std::deque<u64>  q;
+            for (usize i = 0; i < st.iterations(); ++i) {
+                u64 sum = 0;
+                for (usize k = 0; k < items; ++k) {
+                    { std::lock_guard lock{ mtx }; q.push_back(k); }
+                    std::lock_guard lock{ mtx };
+                    sum += q.front();
+                    q.pop_front();
+                }
+                bench::do_not_optimize(sum);
+            }
+        });
+
+        r.add("ring::spsc/single", 0, items, [](bench::state& st) {
+            ring::spsc<u64> q(1024);
+            for (usize i = 0; i < st.iterations(); ++i) {
+                u64 sum = 0, v = 0;
+                for (usize k = 0; k < items; ++k) {
+                    (void)q.try_push(k);
+                    (void)q.try_pop(v);
+                    sum += v;
+                }
+                bench::do_not_optimize(sum);
+            }
+        });
+
+        r.add("ring::spsc/batch", 0, items, [](bench::state& st) {
+            ring::spsc<u64> q(1024);
+            std::array<u64, batch> in{}, out{};
+            for (usize i = 0; i < st.iterations(); ++i) {
+                for (usize k = 0; k < items; k += batch) {
+                    q.push(in);
+                    q.pop(out);
+                }
+                bench::do_not_optimize(out.data());
+            }
+        });
+
+        r.add("ring::mpsc/batch", 0, items, [](bench::state& st) {
+            ring::mpsc<u64> q(1024);
+            std::array<u64, batch> in{}, out{};
+            for (usize i = 0; i < st.iterations(); ++i) {
+                for (usize k = 0; k < items; k += batch) {
+                    q.push(in);
+                    q.pop(out);
+                }
+                bench::do_not_optimize(out.data());
+            }
+        });
+    }
+
+    // --- scan / endian ---------------------------------------------------------
+
+    void kernels(bench::runner& r)
+    {
+        for (auto n : sizes) {
+            // no 0x48 anywhere: both searches walk the whole buffer
+            auto buf = std::make_shared<std::vector<u8>>(random_bytes(n));
+            std::ranges::replace(*buf, u8{ 0x48 }, u8{ 0x49 });
+
+            r.add("baseline/memchr/" + label(n), n, 0, [buf](bench::state& st) {
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    bench::clobber();
+                    bench::do_not_optimize(std::memchr(buf->data(), 0x48, buf->size()));
+                }
+            });
+
+            r.add("scan::find/" + label(n), n, 0, [buf](bench::state& st) {
+                auto const bytes = std::as_bytes(std::span{ *buf });
+                for (usize i = 0; i < st.iterations(); ++i)
+                    bench::do_not_optimize(scan::find<"48 8B 05 ?? ?? ?? ?? 48 85 C0">(bytes));
+            });
+
+            r.add("baseline/bswap_loop/" + label(n), n, n / 4, [buf](bench::state& st) {
+                std::vector<u32> v(buf->size() / 4);
+                std::memcpy(v.data(), buf->data(), v.size() * 4);
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    for (auto& x : v)
+                        x = std::byteswap(x);
+                    bench::do_not_optimize(v.data());
+                    bench::clobber();
+                }
+            });
+
+            r.add("endian::convert_endian<u32>/" + label(n), n, n / 4, [buf](bench::state& st) {
+                std::vector<u32> v(buf->size() / 4);
+                std::memcpy(v.data(), buf->data(), v.size() * 4);
+                for (usize i = 0; i < st.iterations(); ++i) {
+                    endian::convert_endian(std::span{ v });
+                    bench::do_not_optimize(v.data());
+                    bench::clobber();
+                }
+            });
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r;
+    reads(r);
+    walks(r);
+    pops(r);
+    file_reads(r);
+    file_writes(r);
+    strings(r);
+    clocks(r);
+    timestamps(r);
+    allocs(r);
+    string_tables(r);
+    bitfields(r);
+    lookups(r);
+    translations(r);
+    hashes(r);
+    signatures(r);
+    dispatch(r);
+    rings(r);
+    digests(r);
+    kernels(r);
+
+    int const rc = r.main(argc, argv);
+    for (auto n : sizes) {
+        std::error_code ec;
+        std::filesystem::remove(temp_file(n), ec);
+    }
+    return rc;
+}
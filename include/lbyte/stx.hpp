@@ -2,12 +2,32 @@
 
 #include "./stx/core.hpp"    // IWYU pragma: export
 #include "./stx/mem.hpp"     // IWYU pragma: export
+#include "./stx/arena.hpp"   // IWYU pragma: export
 #include "./stx/fn.hpp"      // IWYU pragma: export
 #include "./stx/io.hpp"      // IWYU pragma: export
+#include "./stx/file.hpp"    // IWYU pragma: export
+#include "./stx/stream.hpp"  // IWYU pragma: export
+#include "./stx/cache.hpp"   // IWYU pragma: export
 #include "./stx/bit.hpp"     // IWYU pragma: export
 #include "./stx/endian.hpp"  // IWYU pragma: export
+#include "./stx/layout.hpp"  // IWYU pragma: export
+#include "./stx/table.hpp"   // IWYU pragma: export
 #include "./stx/literals.hpp" // IWYU pragma: export
 #include "./stx/ct.hpp"      // IWYU pragma: export
+#include "./stx/ct_fmt.hpp"  // IWYU pragma: export
+#include "./stx/phf.hpp"     // IWYU pragma: export
+#include "./stx/hash.hpp"    // IWYU pragma: export
 #include "./stx/time.hpp"    // IWYU pragma: export
+#include "./stx/probe.hpp"   // IWYU pragma: export
+#include "./stx/stats.hpp"   // IWYU pragma: export
 #include "./stx/range.hpp"   // IWYU pragma: export
+#include "./stx/simd.hpp"    // IWYU pragma: export
+#include "./stx/par.hpp"     // IWYU pragma: export
+#include "./stx/scan.hpp"    // IWYU pragma: export
+#include "./stx/strtab.hpp"  // IWYU pragma: export
+#include "./stx/digest.hpp"  // IWYU pragma: export
+#include "./stx/addr.hpp"    // IWYU pragma: export
+#include "./stx/patch.hpp"   // IWYU pragma: export
+#include "./stx/codec.hpp"   // IWYU pragma: export
+#include "./stx/ring.hpp"    // IWYU pragma: export
 
@@ -0,0 +1,401 @@
+#pragma once
+#include "core.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx::addr
+{
+    inline constexpr usize npos = ~usize{ 0 };
+
+    // --- region ------------------------------------------------------------------
+    // [rva, rva + virtual_size) in memory, the first raw_size bytes of it backed
+    // by the file at `raw`; the rest reads as zero. A zero virtual_size means
+    // raw_size, as the loader treats it.
+
+    struct region
+    {
+        rva_s rva;
+        u32   virtual_size = 0;
+        off_s raw;
+        u32   raw_size     = 0;
+
+        friend constexpr bool operator==( const region&, const region& ) = default;
+    };
+
+    namespace details
+    {
+        template<std::unsigned_integral T>
+        STX_FORCE_INLINE T load_le( const std::byte* p ) noexcept
+        {
+            T v;
+            std::memcpy( &v, p, sizeof( T ));
+            if constexpr ( std::endian::native == std::endian::big )
+                v = std::byteswap( v );
+            return v;
+        }
+
+        // implicit search tree in BFS (Eytzinger) order: node k has children 2k
+        // and 2k + 1, so a descent touches one cache line per level near the root
+        // and the loop body has no data-dependent branch
+        class eytzinger
+        {
+            std::vector<u64> keys_ = { 0 };   // keys_[0] unused
+            std::vector<u32> slot_ = { 0 };   // sorted position of keys_[k]
+
+        public:
+            eytzinger() = default;
+
+            explicit eytzinger( std::span<const u64> sorted )
+                : keys_( sorted.size() + 1 )
+                , slot_( sorted.size() + 1 )
+            {
+                usize i = 0;
+                auto fill = [&]( auto& self, usize k ) -> void {
+                    if ( k >= keys_.size() ) return;
+                    self( self, 2 * k );
+                    keys_[k] = sorted[i];
+                    slot_[k] = scast<u32>( i++ );
+                    self( self, 2 * k + 1 );
+                };
+                fill( fill, 1 );
+            }
+
+            // sorted position of the last key <= x, npos if every key is greater
+            [[nodiscard]] STX_FORCE_INLINE usize floor( u64 x ) const noexcept
+            {
+                auto const n = keys_.size();
+                usize k = 1;
+                while ( k < n )
+                    k = 2 * k + ( keys_[k] <= x );
+                // drop the trailing left turns and the right turn above them
+                k >>= std::countr_zero( k ) + 1;
+                return k ? slot_[k] : npos;
+            }
+        };
+    }
+
+    // --- map ---------------------------------------------------------------------
+    // rva_s / va_s <-> off_s translation over a set of non-overlapping regions
+    // (the section table of an image). Lookups check the region of the previous
+    // hit first, then descend an Eytzinger index; both are O(1) in memory and
+    // safe to share between threads (the hit is a relaxed atomic).
+
+    class map
+    {
+        struct span_t
+        {
+            u64 start;    // rva (by_rva) / file offset (by_raw)
+            u64 extent;   // bytes in memory (by_rva) / backed bytes (by_raw)
+            u64 backed;   // file-backed bytes from start
+            u64 other;    // file offset (by_rva) / rva (by_raw)
+        };
+
+        struct table
+        {
+            std::vector<region>  regions;   // sorted by rva
+            std::vector<span_t>  by_rva;    // parallel to regions
+            std::vector<span_t>  by_raw;    // disjoint file-backed pieces sorted by offset
+            details::eytzinger   rva_index;
+            details::eytzinger   raw_index;
+            va_s                 base;
+        };
+
+        table                    t_;
+        mutable std::atomic<u32> rva_hit_{ 0 };
+        mutable std::atomic<u32> raw_hit_{ 0 };
+
+        explicit map( table t ) noexcept : t_( std::move( t )) {}
+
+        // sorted position of the span in `s` containing x
+        STX_FORCE_INLINE static usize lookup(
+            const std::vector<span_t>& s, const details::eytzinger& idx, std::atomic<u32>& hit, u64 x ) noexcept
+        {
+            usize i = hit.load( std::memory_order_relaxed );
+            if ( i < s.size() && x - s[i].start < s[i].extent ) [[likely]]
+                return i;
+
+            i = idx.floor( x );
+            if ( i == npos || x - s[i].start >= s[i].extent )
+                return npos;
+            hit.store( scast<u32>( i ), std::memory_order_relaxed );
+            return i;
+        }
+
+        [[nodiscard]] static auto rva_of( va_s va, va_s base ) noexcept -> std::expected<u64, std::errc>
+        {
+            if ( va < base || va.get() - base.get() > std::numeric_limits<u32>::max() )
+                return std::unexpected( std::errc::argument_out_of_domain );
+            return u64{ va.get() - base.get() };
+        }
+
+    public:
+        map() = default;
+
+        map( const map& o ) : t_( o.t_ ) {}
+        map( map&& o ) noexcept : t_( std::move( o.t_ )) {}
+
+        auto operator=( const map& o ) -> map&
+        {
+            if ( this != &o ) t_ = o.t_;
+            rva_hit_.store( 0, std::memory_order_relaxed );
+            raw_hit_.store( 0, std::memory_order_relaxed );
+            return *this;
+        }
+
+        auto operator=( map&& o ) noexcept -> map&
+        {
+            t_ = std::move( o.t_ );
+            rva_hit_.store( 0, std::memory_order_relaxed );
+            raw_hit_.store( 0, std::memory_order_relaxed );
+            return *this;
+        }
+
+        // regions in any order; empty ones are dropped. invalid_argument when two
+        // regions overlap in memory, end past 4 GiB or start at a negative offset.
+        [[nodiscard]] static auto build( std::span<const region> regions, va_s image_base = va_s{ 0 } )
+            -> std::expected<map, std::errc>
+        {
+            table t;
+            t.base = image_base;
+
+            for ( auto const& r : regions ) {
+                auto const extent = u64{ r.virtual_size ? r.virtual_size : r.raw_size };
+                if ( extent == 0 ) continue;
+                if ( r.raw.get() < 0 || u64{ r.rva.get() } + extent > u64{ 1 } << 32 )
+                    return std::unexpected( std::errc::invalid_argument );
+                t.regions.push_back( r );
+            }
+            std::ranges::sort( t.regions, {}, &region::rva );
+
+            std::vector<u64> keys;
+            keys.reserve( t.regions.size() );
+            for ( auto const& r : t.regions ) {
+                auto const extent = u64{ r.virtual_size ? r.virtual_size : r.raw_size };
+                auto const start  = u64{ r.rva.get() };
+                if ( !t.by_rva.empty() && t.by_rva.back().start + t.by_rva.back().extent > start )
+                    return std::unexpected( std::errc::invalid_argument );
+                t.by_rva.push_back({ start, extent, std::min<u64>( r.raw_size, extent ), scast<u64>( r.raw.get() ) });
+                keys.push_back( start );
+            }
+            t.rva_index = details::eytzinger{ keys };
+
+            // reverse index. Raw ranges may overlap (sections sharing file
+            // bytes), so they are cut into disjoint pieces: each byte maps
+            // through the covering region with the latest raw start (the lower
+            // rva on a tie), and an offset past that region's end still maps
+            // through an earlier, larger one. Quadratic in the region count,
+            // which is a section table.
+            std::vector<span_t> raw;
+            for ( auto const& s : t.by_rva )
+                if ( s.backed )
+                    raw.push_back({ s.other, s.backed, s.backed, s.start });
+            std::ranges::stable_sort( raw, {}, &span_t::start );
+
+            std::vector<u64> cuts;
+            cuts.reserve( raw.size() * 2 );
+            for ( auto const& r : raw ) {
+                cuts.push_back( r.start );
+                cuts.push_back( r.start + r.extent );
+            }
+            std::ranges::sort( cuts );
+            cuts.erase( std::unique( cuts.begin(), cuts.end() ), cuts.end() );
+
+            for ( usize c = 0; c + 1 < cuts.size(); ++c ) {
+                auto const lo = cuts[c];
+                auto const hi = cuts[c + 1];
+
+                const span_t* win = nullptr;
+                for ( auto const& r : raw ) {
+                    if ( r.start > lo ) break;
+                    if ( lo - r.start < r.extent && ( !win || r.start > win->start ))
+                        win = &r;
+                }
+                if ( !win ) continue;
+
+                // extend the previous piece when this one continues it
+                auto const other = win->other + ( lo - win->start );
+                if ( auto& out = t.by_raw; !out.empty()
+                     && out.back().start + out.back().extent == lo
+                     && out.back().other + out.back().extent == other ) {
+                    out.back().extent += hi - lo;
+                    out.back().backed  = out.back().extent;
+                } else {
+                    out.push_back({ lo, hi - lo, hi - lo, other });
+                }
+            }
+
+            keys.clear();
+            for ( auto const& s : t.by_raw ) keys.push_back( s.start );
+            t.raw_index = details::eytzinger{ keys };
+
+            return map{ std::move( t ) };
+        }
+
+        // headers plus section table of a PE32 / PE32+ image; `head` needs only
+        // the headers. ImageBase becomes image_base(), the headers map 1:1 up to
+        // the first section. Raw pointers are taken as written (no FileAlignment
+        // rounding).
+        [[nodiscard]] static auto from_pe( std::span<const std::byte> head ) -> std::expected<map, std::errc>
+        {
+            auto const* p = head.data();
+            auto const  n = head.size();
+
+            if ( n < 0x40 || p[0] != std::byte{ 'M' } || p[1] != std::byte{ 'Z' } )
+                return std::unexpected( std::errc::invalid_argument );
+
+            auto const nt = u64{ details::load_le<u32>( p + 0x3C ) };
+            if ( nt + 24 > n || std::memcmp( p + nt, "PE\0\0", 4 ) != 0 )
+                return std::unexpected( std::errc::invalid_argument );
+
+            auto const sections = details::load_le<u16>( p + nt + 6 );
+            auto const opt      = nt + 24;
+            auto const sec      = opt + details::load_le<u16>( p + nt + 20 );
+            if ( opt + 64 > n || sec + u64{ sections } * 40 > n )
+                return std::unexpected( std::errc::invalid_argument );
+
+            va_s base;
+            switch ( details::load_le<u16>( p + opt )) {
+                case 0x10B: base = va_s{ details::load_le<u32>( p + opt + 28 ) }; break;
+                case 0x20B: base = va_s{ details::load_le<u64>( p + opt + 24 ) }; break;
+                default:    return std::unexpected( std::errc::invalid_argument );
+            }
+
+            std::vector<region> regions;
+            regions.reserve( sections + 1u );
+
+            auto headers = details::load_le<u32>( p + opt + 60 );
+            for ( u32 i = 0; i < sections; ++i ) {
+                auto const* s = p + sec + i * 40;
+                region r{
+                    .rva          = rva_s{ details::load_le<u32>( s + 12 ) },
+                    .virtual_size = details::load_le<u32>( s + 8 ),
+                    .raw          = off_s{ details::load_le<u32>( s + 20 ) },
+                    .raw_size     = details::load_le<u32>( s + 16 ),
+                };
+                if ( r.virtual_size || r.raw_size ) {
+                    headers = std::min( headers, r.rva.get() );
+                    regions.push_back( r );
+                }
+            }
+            regions.push_back({ .rva = rva_s{ 0 }, .virtual_size = headers, .raw = off_s{ 0 }, .raw_size = headers });
+
+            return build( regions, base );
+        }
+
+        // --- lookup ------------------------------------------------------------
+
+        // region containing `rva` in memory, nullptr when none does
+        [[nodiscard]] const region* find( rva_s rva ) const noexcept
+        {
+            auto const i = lookup( t_.by_rva, t_.rva_index, rva_hit_, rva.get() );
+            return i == npos ? nullptr : &t_.regions[i];
+        }
+
+        [[nodiscard]] bool contains( rva_s rva ) const noexcept { return find( rva ) != nullptr; }
+
+        // argument_out_of_domain outside every region or in its zero-filled tail
+        [[nodiscard]] auto to_off( rva_s rva ) const noexcept -> std::expected<off_s, std::errc>
+        {
+            auto const x = u64{ rva.get() };
+            auto const i = lookup( t_.by_rva, t_.rva_index, rva_hit_, x );
+            if ( i == npos || x - t_.by_rva[i].start >= t_.by_rva[i].backed ) [[unlikely]]
+                return std::unexpected( std::errc::argument_out_of_domain );
+            return off_s{ t_.by_rva[i].other + ( x - t_.by_rva[i].start ) };
+        }
+
+        [[nodiscard]] auto to_off( va_s va ) const noexcept -> std::expected<off_s, std::errc>
+        {
+            auto const rva = rva_of( va, t_.base );
+            if ( !rva ) return std::unexpected( rva.error() );
+            return to_off( rva_s{ *rva } );
+        }
+
+        // argument_out_of_domain when no region is backed by that file byte
+        [[nodiscard]] auto to_rva( off_s off ) const noexcept -> std::expected<rva_s, std::errc>
+        {
+            if ( off.get() < 0 ) [[unlikely]]
+                return std::unexpected( std::errc::argument_out_of_domain );
+            auto const x = scast<u64>( off.get() );
+            auto const i = lookup( t_.by_raw, t_.raw_index, raw_hit_, x );
+            if ( i == npos ) [[unlikely]]
+                return std::unexpected( std::errc::argument_out_of_domain );
+            return rva_s{ t_.by_raw[i].other + ( x - t_.by_raw[i].start ) };
+        }
+
+        [[nodiscard]] auto to_rva( va_s va ) const noexcept -> std::expected<rva_s, std::errc>
+        {
+            auto const rva = rva_of( va, t_.base );
+            if ( !rva ) return std::unexpected( rva.error() );
+            return rva_s{ *rva };
+        }
+
+        [[nodiscard]] va_s to_va( rva_s rva ) const noexcept { return va_s{ t_.base.get() + rva.get() }; }
+
+        [[nodiscard]] auto to_va( off_s off ) const noexcept -> std::expected<va_s, std::errc>
+        {
+            auto const rva = to_rva( off );
+            if ( !rva ) return std::unexpected( rva.error() );
+            return to_va( *rva );
+        }
+
+        // file-backed bytes from `rva` to the end of its region (0 when unmapped),
+        // the most a read at to_off(rva) can take without leaving the region
+        [[nodiscard]] usize remaining( rva_s rva ) const noexcept
+        {
+            auto const x = u64{ rva.get() };
+            auto const i = lookup( t_.by_rva, t_.rva_index, rva_hit_, x );
+            if ( i == npos ) return 0;
+            auto const d = x - t_.by_rva[i].start;
+            return d < t_.by_rva[i].backed ? scast<usize>( t_.by_rva[i].backed - d ) : 0;
+        }
+
+        // --- state -------------------------------------------------------------
+
+        [[nodiscard]] std::span<const region> regions() const noexcept { return t_.regions; }
+        [[nodiscard]] usize size()  const noexcept { return t_.regions.size(); }
+        [[nodiscard]] bool  empty() const noexcept { return t_.regions.empty(); }
+        [[nodiscard]] va_s  image_base() const noexcept { return t_.base; }
+    };
+
+    // --- cursors -----------------------------------------------------------------
+    // A byte_cursor (memcur, map_file, map_view) over a file image: seek to the
+    // bytes behind an rva_s / va_s. Fails without moving when the address has no
+    // file bytes or they lie past the cursor's size().
+
+    template<byte_cursor C, typename A>
+        requires std::same_as<A, rva_s> || std::same_as<A, va_s>
+    auto seek( C& cur, A at, const map& m ) noexcept -> std::expected<void, std::errc>
+    {
+        auto const off = m.to_off( at );
+        if ( !off ) [[unlikely]]
+            return std::unexpected( off.error() );
+        if ( off->get() > scast<off_s::value_type>( cur.size() )) [[unlikely]]
+            return std::unexpected( std::errc::argument_out_of_domain );
+        cur.seek( *off );
+        return {};
+    }
+
+    // rva_s of the cursor position
+    template<byte_cursor C>
+    [[nodiscard]] auto tell( const C& cur, const map& m ) noexcept -> std::expected<rva_s, std::errc>
+    {
+        return m.to_rva( cur.tell() );
+    }
+}
+
+#undef STX_FORCE_INLINE
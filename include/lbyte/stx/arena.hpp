@@ -0,0 +1,245 @@
+#pragma once
+#include "core.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx::mem
+{
+    // --- arena (monotonic bump allocator) ----------------------------------------
+    // Hands out memory from large blocks and never frees individual allocations
+    // (the most recent one is rolled back when deallocated). reset() drops every
+    // allocation at once and keeps the largest block for the next pass; cost is
+    // per block, not per allocation. Not thread-safe; use one arena per parse.
+    // Also a std::pmr::memory_resource, so pmr containers can draw from it.
+
+    class arena : public std::pmr::memory_resource
+    {
+        struct block
+        {
+            block* prev;
+            usize  size;    // total bytes, header included
+        };
+
+        static constexpr usize header    = ( sizeof( block ) + alignof( std::max_align_t ) - 1 ) & ~( alignof( std::max_align_t ) - 1 );
+        static constexpr usize max_block = usize{ 1 } << 24;
+
+        std::byte*                 cur_  = nullptr;
+        std::byte*                 end_  = nullptr;
+        block*                     head_ = nullptr;      // owned blocks, newest first
+        std::span<std::byte>       initial_;             // caller buffer, never freed
+        std::pmr::memory_resource* upstream_;
+        usize                      first_;
+        usize                      next_;
+        usize                      used_ = 0;
+
+        static std::byte* data_of( block* b ) noexcept { return rcast<std::byte*>( b ) + header; }
+
+        void free_block( block* b ) noexcept
+        {
+            upstream_->deallocate( b, b->size, alignof( std::max_align_t ));
+        }
+
+        // slow path: open a block large enough for `bytes` at `align`
+        std::byte* grow( usize bytes, usize align )
+        {
+            auto const need = bytes + align + header;
+            if ( need < bytes ) [[unlikely]]
+                throw std::bad_alloc{};
+
+            // oversized requests get a dedicated block; the current one stays open
+            bool const dedicated = cur_ != nullptr && need > next_;
+            auto const size      = std::max( need, next_ );
+
+            auto* b = static_cast<block*>( upstream_->allocate( size, alignof( std::max_align_t )));
+            b->size = size;
+
+            if ( dedicated && head_ ) {
+                b->prev     = head_->prev;
+                head_->prev = b;
+            } else {
+                b->prev = head_;
+                head_   = b;
+            }
+
+            auto* p = data_of( b );
+            p += ( align - rcast<uptr>( p ) % align ) % align;
+
+            if ( !dedicated ) {
+                cur_  = p + bytes;
+                end_  = rcast<std::byte*>( b ) + size;
+                next_ = std::min( next_ * 2, max_block );
+            }
+            used_ += bytes;
+            return p;
+        }
+
+        void* do_allocate( usize bytes, usize align ) override { return bump( bytes, align ); }
+        void  do_deallocate( void* p, usize bytes, usize ) noexcept override { unbump( p, bytes ); }
+        bool  do_is_equal( const std::pmr::memory_resource& o ) const noexcept override { return this == &o; }
+
+    public:
+        static constexpr usize default_block = usize{ 64 } << 10;
+
+        // block: size of the first block; later ones double up to 16 MiB
+        explicit arena( usize block = default_block,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource() ) noexcept
+            : upstream_( upstream )
+            , first_( std::max( block, header * 2 ))
+            , next_( first_ )
+        {}
+
+        // serve from `buffer` (e.g. on the stack) first, then from upstream
+        explicit arena( std::span<std::byte> buffer, usize block = default_block,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource() ) noexcept
+            : arena( block, upstream )
+        {
+            initial_ = buffer;
+            cur_     = buffer.data();
+            end_     = buffer.data() + buffer.size();
+        }
+
+        // allocators hold a pointer to the arena: it does not move
+        arena( const arena& ) = delete;
+        auto operator=( const arena& ) -> arena& = delete;
+
+        ~arena() override { release(); }
+
+        [[nodiscard]] STX_FORCE_INLINE
+        void* bump( usize bytes, usize align = alignof( std::max_align_t ))
+        {
+            auto const at  = rcast<uptr>( cur_ );
+            auto const pad = ( align - at % align ) % align;
+            if ( cur_ && pad + bytes <= scast<usize>( end_ - cur_ )) [[likely]] {
+                auto* p = cur_ + pad;
+                cur_    = p + bytes;
+                used_  += bytes;
+                return p;
+            }
+            return grow( bytes, align );
+        }
+
+        // gives the space back only when `p` is the latest allocation
+        STX_FORCE_INLINE
+        void unbump( void* p, usize bytes ) noexcept
+        {
+            if ( static_cast<std::byte*>( p ) + bytes == cur_ ) {
+                cur_   = static_cast<std::byte*>( p );
+                used_ -= bytes;
+            }
+        }
+
+        // drop every allocation; keep the largest block (or the caller buffer)
+        void reset() noexcept
+        {
+            block* keep = nullptr;
+            for ( auto* b = head_; b; ) {
+                auto* prev = b->prev;
+                if ( !keep || b->size > keep->size ) {
+                    if ( keep ) free_block( keep );
+                    keep = b;
+                } else {
+                    free_block( b );
+                }
+                b = prev;
+            }
+
+            head_ = keep;
+            used_ = 0;
+            if ( keep ) {
+                keep->prev = nullptr;
+                cur_ = data_of( keep );
+                end_ = rcast<std::byte*>( keep ) + keep->size;
+            } else {
+                cur_ = initial_.data();
+                end_ = initial_.data() + initial_.size();
+            }
+        }
+
+        // drop every allocation and return all blocks to upstream
+        void release() noexcept
+        {
+            for ( auto* b = head_; b; ) {
+                auto* prev = b->prev;
+                free_block( b );
+                b = prev;
+            }
+            head_ = nullptr;
+            used_ = 0;
+            next_ = first_;
+            cur_  = initial_.data();
+            end_  = initial_.data() + initial_.size();
+        }
+
+        // bytes handed out since the last reset (padding excluded)
+        [[nodiscard]] usize used() const noexcept { return used_; }
+
+        // bytes obtained from upstream and still held
+        [[nodiscard]] usize reserved() const noexcept
+        {
+            usize n = 0;
+            for ( auto* b = head_; b; b = b->prev )
+                n += b->size;
+            return n;
+        }
+
+        [[nodiscard]] std::pmr::memory_resource* upstream() const noexcept { return upstream_; }
+    };
+
+    // --- arena_allocator (std allocator over an arena) ---------------------------
+    // Non-virtual fast path; containers using it are freed by arena.reset().
+    // Element destructors still run, so prefer trivially destructible payloads.
+
+    template<typename T>
+    class arena_allocator
+    {
+        template<typename> friend class arena_allocator;
+
+        arena* arena_;
+
+    public:
+        using value_type                             = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+        using is_always_equal                        = std::false_type;
+
+        arena_allocator( arena& a ) noexcept : arena_( &a ) {}
+
+        template<typename U>
+        arena_allocator( const arena_allocator<U>& o ) noexcept : arena_( o.arena_ ) {}
+
+        [[nodiscard]] STX_FORCE_INLINE
+        T* allocate( usize n )
+        {
+            if ( n > std::numeric_limits<usize>::max() / sizeof( T )) [[unlikely]]
+                throw std::bad_array_new_length{};
+            return static_cast<T*>( arena_->bump( n * sizeof( T ), alignof( T )));
+        }
+
+        STX_FORCE_INLINE
+        void deallocate( T* p, usize n ) noexcept { arena_->unbump( p, n * sizeof( T )); }
+
+        [[nodiscard]] arena& resource() const noexcept { return *arena_; }
+
+        template<typename U>
+        friend bool operator==( const arena_allocator& a, const arena_allocator<U>& b ) noexcept
+        {
+            return a.arena_ == b.arena_;
+        }
+    };
+}
+
+#undef STX_FORCE_INLINE
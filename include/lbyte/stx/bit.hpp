@@ -1,8 +1,38 @@
 #pragma once
 #include "core.hpp"
+#include "simd.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
 #include <limits>
+#include <span>
 #include <type_traits>
+#include <utility>
+
+// --- target selection ------------------------------------------------------------
+// BMI2 pdep / pext back the bulk pack / unpack kernels. Zen 1 / Zen 2 run them
+// in microcode; predefine LBYTE_STX_BIT_BMI2=0 there to keep the AVX2 / scalar
+// kernels.
+
+#if !defined(LBYTE_STX_BIT_BMI2)
+    #if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+        #define LBYTE_STX_BIT_BMI2 1
+    #else
+        #define LBYTE_STX_BIT_BMI2 0
+    #endif
+#endif
+
+#if LBYTE_STX_BIT_BMI2 || LBYTE_STX_SIMD_AVX2
+    #include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
 
 namespace lbyte::stx
 {
@@ -141,4 +171,449 @@ namespace lbyte::stx
                   | (static_cast<T>(a) << (B * 8));
         }
     }
+
+    // --- BULK FIELDS -------------------------------------------------------------
+    // Fixed-width fields packed back to back, LSB-first: field i is bits
+    // [i * Width, (i + 1) * Width) of the stream, bit 0 being the low bit of
+    // byte 0 (the DEFLATE / bitmap order). Eight fields always span exactly
+    // Width bytes, so the kernels work on groups of eight.
+
+    namespace details
+    {
+        template<usize Width>
+        inline constexpr u64 field_mask = Width >= 64 ? ~u64{0} : (u64{1} << Width) - 1;
+
+        constexpr u64 load_le64(const u8* p) noexcept
+        {
+            if consteval {
+                u64 v = 0;
+                for (usize i = 0; i < 8; ++i)
+                    v |= static_cast<u64>(p[i]) << (8 * i);
+                return v;
+            } else {
+                u64 v;
+                std::memcpy(&v, p, sizeof(v));
+                if constexpr (std::endian::native == std::endian::big)
+                    v = std::byteswap(v);
+                return v;
+            }
+        }
+
+        inline void store_le(u8* p, const u64* w, usize bytes) noexcept
+        {
+            if constexpr (std::endian::native == std::endian::big) {
+                for (usize i = 0; i < bytes; ++i)
+                    p[i] = static_cast<u8>(w[i / 8] >> (8 * (i % 8)));
+            } else {
+                std::memcpy(p, w, bytes);
+            }
+        }
+
+        // field `i` of a stream, touching only bytes inside [p, p + size)
+        template<usize Width>
+        constexpr u64 field_at(const u8* p, usize size, usize i) noexcept
+        {
+            auto const bit   = i * Width;
+            auto const byte  = bit / 8;
+            auto const shift = bit % 8;
+
+            u64 v = static_cast<u64>(p[byte]) >> shift;
+            for (usize k = 1, at = 8 - shift; at < Width && byte + k < size; ++k, at += 8)
+                v |= static_cast<u64>(p[byte + k]) << at;
+            return v & field_mask<Width>;
+        }
+
+        // ORs field `i` into a zeroed stream
+        template<usize Width>
+        constexpr void field_put(u8* p, usize i, u64 v) noexcept
+        {
+            auto const bit   = i * Width;
+            auto const byte  = bit / 8;
+            auto const shift = bit % 8;
+
+            v &= field_mask<Width>;
+            p[byte] |= static_cast<u8>(v << shift);
+            for (usize k = 1, at = 8 - shift; at < Width; ++k, at += 8)
+                p[byte + k] |= static_cast<u8>(v >> at);
+        }
+
+        // --- scalar group: offsets and shifts are compile-time constants ---------
+
+        template<usize Width, usize J>
+        STX_FORCE_INLINE u64 group_field(const u8* p) noexcept
+        {
+            constexpr usize bit = J * Width, byte = bit / 8, shift = bit % 8;
+            u64 v = load_le64(p + byte) >> shift;
+            if constexpr (shift + Width > 64)
+                v |= static_cast<u64>(p[byte + 8]) << (64 - shift);
+            return v & field_mask<Width>;
+        }
+
+        template<usize Width, typename T, usize... J>
+        STX_FORCE_INLINE void unpack_group_scalar(const u8* p, T* out, std::index_sequence<J...>) noexcept
+        {
+            ((out[J] = static_cast<T>(group_field<Width, J>(p))), ...);
+        }
+
+        template<usize Bits, usize At>
+        STX_FORCE_INLINE void put_word_bits(u64* w, u64 v) noexcept
+        {
+            w[At / 64] |= v << (At % 64);
+            if constexpr (At % 64 + Bits > 64)
+                w[At / 64 + 1] |= v >> (64 - At % 64);
+        }
+
+        template<usize Width, typename T, usize... J>
+        STX_FORCE_INLINE void pack_group_scalar(const T* in, u8* out, std::index_sequence<J...>) noexcept
+        {
+            u64 w[(Width + 7) / 8]{};
+            (put_word_bits<Width, J * Width>(w, static_cast<u64>(in[J]) & field_mask<Width>), ...);
+            store_le(out, w, Width);
+        }
+
+        // --- BMI2: one pdep / pext per 64 bits of T lanes -----------------------
+
+        // every pdep window (k fields, starting at an in-byte shift) fits 64 bits
+        template<usize Width, typename T>
+        inline constexpr bool lanes_fit = [] {
+            constexpr usize lane = 8 * sizeof(T), k = 64 / lane;
+            if (lane >= 64 || Width > lane)
+                return false;
+            for (usize j = 0; j < 8 / k; ++j)
+                if ((j * k * Width) % 8 + k * Width > 64)
+                    return false;
+            return true;
+        }();
+
+        template<usize Width, typename T>
+        inline constexpr u64 lane_mask = [] {
+            u64 m = 0;
+            for (usize l = 0; l < 8 / sizeof(T); ++l)
+                m |= field_mask<Width> << (l * 8 * sizeof(T));
+            return m;
+        }();
+
+    #if LBYTE_STX_BIT_BMI2
+        template<usize Width, typename T, usize J>
+        STX_FORCE_INLINE void pdep_step(const u8* p, T* out) noexcept
+        {
+            constexpr usize k = 8 / sizeof(T), bit = J * k * Width;
+            u64 const v = _pdep_u64(load_le64(p + bit / 8) >> (bit % 8), lane_mask<Width, T>);
+            std::memcpy(out + J * k, &v, sizeof(v));
+        }
+
+        template<usize Width, typename T, usize... J>
+        STX_FORCE_INLINE void unpack_group_pdep(const u8* p, T* out, std::index_sequence<J...>) noexcept
+        {
+            (pdep_step<Width, T, J>(p, out), ...);
+        }
+
+        // k lanes as one word; the fold compiles to a single load
+        template<typename T, usize... L>
+        STX_FORCE_INLINE u64 lanes_word(const T* p, std::index_sequence<L...>) noexcept
+        {
+            return ((static_cast<u64>(p[L]) << (L * 8 * sizeof(T))) | ...);
+        }
+
+        template<usize Width, typename T, usize J>
+        STX_FORCE_INLINE void pext_step(const T* in, u64* w) noexcept
+        {
+            constexpr usize k = 8 / sizeof(T);
+            u64 const v = lanes_word(in + J * k, std::make_index_sequence<k>{});
+            put_word_bits<k * Width, J * k * Width>(w, _pext_u64(v, lane_mask<Width, T>));
+        }
+
+        template<usize Width, typename T, usize... J>
+        STX_FORCE_INLINE void pack_group_pext(const T* in, u8* out, std::index_sequence<J...>) noexcept
+        {
+            u64 w[(Width + 7) / 8]{};
+            (pext_step<Width, T, J>(in, w), ...);
+            store_le(out, w, Width);
+        }
+    #endif
+
+        // --- AVX2: 8 fields per shuffle + variable shift (Width <= 25) ----------
+
+    #if LBYTE_STX_SIMD_AVX2
+        template<usize Width>
+        struct unpack_shuffle
+        {
+            alignas(32) std::array<u8, 32>  bytes{};
+            alignas(32) std::array<u32, 8>  shift{};
+        };
+
+        // fields 0-3 from the low lane, 4-7 from the high lane loaded at byte 4W/8
+        template<usize Width>
+        inline constexpr auto unpack_shuffle_v = [] {
+            unpack_shuffle<Width> t;
+            for (usize f = 0; f < 8; ++f) {
+                auto const rel = f * Width - (f < 4 ? 0 : 4 * Width / 8 * 8);
+                for (usize k = 0; k < 4; ++k)
+                    t.bytes[f * 4 + k] = static_cast<u8>(rel / 8 + k);
+                t.shift[f] = static_cast<u32>(rel % 8);
+            }
+            return t;
+        }();
+
+        template<usize Width, typename T>
+        STX_FORCE_INLINE void unpack_group_avx2(const u8* p, T* out) noexcept
+        {
+            auto const& t = unpack_shuffle_v<Width>;
+
+            __m256i v = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(rcast<const __m128i*>(p))),
+                _mm_loadu_si128(rcast<const __m128i*>(p + 4 * Width / 8)), 1);
+            v = _mm256_shuffle_epi8(v, _mm256_load_si256(rcast<const __m256i*>(t.bytes.data())));
+            v = _mm256_srlv_epi32(v, _mm256_load_si256(rcast<const __m256i*>(t.shift.data())));
+            v = _mm256_and_si256(v, _mm256_set1_epi32(static_cast<int>(field_mask<Width>)));
+
+            __m128i const lo = _mm256_castsi256_si128(v);
+            __m128i const hi = _mm256_extracti128_si256(v, 1);
+            if constexpr (sizeof(T) == 1) {
+                __m128i const w = _mm_packus_epi32(lo, hi);
+                _mm_storel_epi64(rcast<__m128i*>(out), _mm_packus_epi16(w, w));
+            } else if constexpr (sizeof(T) == 2) {
+                _mm_storeu_si128(rcast<__m128i*>(out), _mm_packus_epi32(lo, hi));
+            } else if constexpr (sizeof(T) == 4) {
+                _mm256_storeu_si256(rcast<__m256i*>(out), v);
+            } else {
+                _mm256_storeu_si256(rcast<__m256i*>(out), _mm256_cvtepu32_epi64(lo));
+                _mm256_storeu_si256(rcast<__m256i*>(out + 4), _mm256_cvtepu32_epi64(hi));
+            }
+        }
+    #endif
+
+        // reads at most Width + 16 bytes from p
+        template<usize Width, typename T>
+        STX_FORCE_INLINE void unpack_group(const u8* p, T* out) noexcept
+        {
+        #if LBYTE_STX_BIT_BMI2
+            if constexpr (sizeof(T) <= 2 && lanes_fit<Width, T>) {
+                unpack_group_pdep<Width>(p, out, std::make_index_sequence<sizeof(T)>{});
+                return;
+            }
+        #endif
+        #if LBYTE_STX_SIMD_AVX2
+            if constexpr (Width <= 25) {
+                unpack_group_avx2<Width>(p, out);
+                return;
+            }
+        #endif
+        #if LBYTE_STX_BIT_BMI2
+            if constexpr (lanes_fit<Width, T>) {
+                unpack_group_pdep<Width>(p, out, std::make_index_sequence<sizeof(T)>{});
+                return;
+            }
+        #endif
+            unpack_group_scalar<Width>(p, out, std::make_index_sequence<8>{});
+        }
+
+        template<usize Width, typename T>
+        STX_FORCE_INLINE void pack_group(const T* in, u8* out) noexcept
+        {
+        #if LBYTE_STX_BIT_BMI2
+            if constexpr (lanes_fit<Width, T>) {
+                pack_group_pext<Width>(in, out, std::make_index_sequence<sizeof(T)>{});
+                return;
+            }
+        #endif
+            pack_group_scalar<Width>(in, out, std::make_index_sequence<8>{});
+        }
+    }
+
+    // decodes min(out.size(), 8 * in.size() / Width) fields; returns the count
+    template<usize Width, std::unsigned_integral T>
+    constexpr usize unpack_bits(std::span<const u8> in, std::span<T> out) noexcept
+    {
+        static_assert(Width >= 1 && Width <= std::numeric_limits<T>::digits, "field width out of range");
+
+        auto const n = std::min(out.size(), in.size() * 8 / Width);
+        usize i = 0;
+
+        if !consteval {
+            // groups of eight while the kernels' over-read stays inside `in`
+            for (; i + 8 <= n && i / 8 * Width + Width + 16 <= in.size(); i += 8)
+                details::unpack_group<Width>(in.data() + i / 8 * Width, out.data() + i);
+        }
+        for (; i < n; ++i)
+            out[i] = static_cast<T>(details::field_at<Width>(in.data(), in.size(), i));
+        return n;
+    }
+
+    // encodes min(in.size(), 8 * out.size() / Width) fields (values masked to
+    // Width bits); returns the bytes written. Spare bits of the last byte are 0.
+    template<usize Width, std::unsigned_integral T>
+    constexpr usize pack_bits(std::span<const T> in, std::span<u8> out) noexcept
+    {
+        static_assert(Width >= 1 && Width <= std::numeric_limits<T>::digits, "field width out of range");
+
+        auto const n     = std::min(in.size(), out.size() * 8 / Width);
+        auto const bytes = (n * Width + 7) / 8;
+        usize i = 0;
+
+        if !consteval {
+            for (; i + 8 <= n; i += 8)
+                details::pack_group<Width>(in.data() + i, out.data() + i / 8 * Width);
+        }
+        for (usize b = i / 8 * Width; b < bytes; ++b)
+            out[b] = 0;
+        for (; i < n; ++i)
+            details::field_put<Width>(out.data(), i, static_cast<u64>(in[i]));
+        return bytes;
+    }
+
+    template<usize Width, std::unsigned_integral T>
+    usize unpack_bits(std::span<const std::byte> in, std::span<T> out) noexcept
+    {
+        return unpack_bits<Width>(std::span<const u8>{ rcast<const u8*>(in.data()), in.size() }, out);
+    }
+
+    template<usize Width, std::unsigned_integral T>
+    usize pack_bits(std::span<const T> in, std::span<std::byte> out) noexcept
+    {
+        return pack_bits<Width>(in, std::span<u8>{ rcast<u8*>(out.data()), out.size() });
+    }
+
+    // --- CURSOR FIELDS -----------------------------------------------------------
+    // The same at a byte_cursor (memcur, map_file, map_view): fields start at the
+    // cursor, which advances past them rounded up to a whole byte. For variable
+    // widths use bit_reader{ cur.bytes() } and advance by its consumed().
+
+    // returns the fields decoded
+    template<usize Width, std::unsigned_integral T, byte_cursor C>
+    usize pop_bits(C& cur, std::span<T> out) noexcept
+    {
+        auto const got = unpack_bits<Width>(std::as_bytes(cur.bytes()), out);
+        cur.advance(off_s{static_cast<off_s::value_type>((got * Width + 7) / 8)});
+        return got;
+    }
+
+    // returns the fields encoded
+    template<usize Width, std::unsigned_integral T, byte_cursor C>
+        requires requires (C& c) { std::as_writable_bytes(c.bytes()); }
+    usize push_bits(C& cur, std::span<const T> in) noexcept
+    {
+        auto const room = std::as_writable_bytes(cur.bytes());
+        auto const put  = pack_bits<Width>(in, room);
+        cur.advance(off_s{static_cast<off_s::value_type>(put)});
+        return std::min(in.size(), room.size() * 8 / Width);
+    }
+
+    // --- BIT READER --------------------------------------------------------------
+    // LSB-first cursor for variable-width fields. The window is refilled with one
+    // unaligned 64-bit load (branch-free) while 8 bytes remain; near the end it
+    // falls back to byte loads. Reading past the end yields zero bits and sets
+    // overrun().
+
+    class bit_reader
+    {
+        const u8* begin_   = nullptr;
+        const u8* cur_     = nullptr;   // next byte to load
+        const u8* end_     = nullptr;
+        u64       buf_     = 0;         // unread bits, next one at bit 0
+        u32       count_   = 0;         // valid bits in buf_
+        bool      overrun_ = false;
+
+    public:
+        static constexpr u32 max_peek = 56;
+
+        bit_reader() noexcept = default;
+
+        explicit bit_reader(std::span<const u8> bytes) noexcept
+            : begin_(bytes.data()), cur_(bytes.data()), end_(bytes.data() + bytes.size())
+        {}
+
+        explicit bit_reader(std::span<const std::byte> bytes) noexcept
+            : bit_reader(std::span<const u8>{ rcast<const u8*>(bytes.data()), bytes.size() })
+        {}
+
+        // tops the window up to >= 56 bits while input lasts
+        STX_FORCE_INLINE void refill() noexcept
+        {
+            if (end_ - cur_ >= 8) [[likely]] {
+                buf_   |= details::load_le64(cur_) << count_;
+                cur_   += (63 - count_) >> 3;
+                count_ |= 56;
+            } else {
+                for (; count_ <= 56 && cur_ < end_; count_ += 8)
+                    buf_ |= static_cast<u64>(*cur_++) << count_;
+            }
+        }
+
+        // next `n` (<= 56) bits without consuming them
+        [[nodiscard]] STX_FORCE_INLINE u64 peek(u32 n) noexcept
+        {
+            if (count_ < n)
+                refill();
+            return buf_ & ((u64{1} << n) - 1);
+        }
+
+        STX_FORCE_INLINE void consume(u32 n) noexcept
+        {
+            if (n > count_) [[unlikely]] {
+                overrun_ = true;
+                buf_ = 0;
+                count_ = 0;
+                return;
+            }
+            buf_ >>= n;
+            count_ -= n;
+        }
+
+        // next `n` (<= 64) bits
+        [[nodiscard]] STX_FORCE_INLINE u64 read(u32 n) noexcept
+        {
+            if (n > max_peek) {
+                auto const lo = peek(32);
+                consume(32);
+                auto const hi = peek(n - 32);
+                consume(n - 32);
+                return lo | (hi << 32);
+            }
+            auto const v = peek(n);
+            consume(n);
+            return v;
+        }
+
+        template<usize N, std::unsigned_integral T = u64>
+        [[nodiscard]] STX_FORCE_INLINE T read() noexcept
+        {
+            static_assert(N >= 1 && N <= std::numeric_limits<T>::digits, "field width out of range");
+            return static_cast<T>(read(static_cast<u32>(N)));
+        }
+
+        [[nodiscard]] STX_FORCE_INLINE bool read_bit() noexcept { return read(1) != 0; }
+
+        void skip(usize n) noexcept
+        {
+            if (n <= count_) {
+                consume(static_cast<u32>(n));
+                return;
+            }
+            auto const target = position() + n;
+            auto const size   = static_cast<usize>(end_ - begin_);
+            buf_   = 0;
+            count_ = 0;
+            if (target > size * 8) {
+                overrun_ = true;
+                cur_ = end_;
+                return;
+            }
+            cur_ = begin_ + target / 8;
+            if (auto const r = static_cast<u32>(target % 8)) {
+                refill();
+                consume(r);
+            }
+        }
+
+        // drops the bits up to the next byte boundary
+        void align() noexcept { consume(count_ & 7); }
+
+        [[nodiscard]] usize position()  const noexcept { return static_cast<usize>(cur_ - begin_) * 8 - count_; }
+        [[nodiscard]] usize consumed()  const noexcept { return (position() + 7) / 8; }
+        [[nodiscard]] usize remaining() const noexcept { return static_cast<usize>(end_ - cur_) * 8 + count_; }
+        [[nodiscard]] bool  overrun()   const noexcept { return overrun_; }
+    };
 }
+
+#undef STX_FORCE_INLINE
@@ -0,0 +1,246 @@
+#pragma once
+#include "./core.hpp"
+#include "./io.hpp"
+
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+// file_key::of lives in cache_platform.hpp: included below in header-only
+// builds, compiled once into the stx library when LBYTE_STX_COMPILED is set.
+
+namespace lbyte::stx
+{
+    // --- file_key (identity of one version of a file) ---------------------------
+
+    struct file_key
+    {
+        u64 dev   = 0;
+        u64 ino   = 0;
+        i64 mtime = 0;      // ns since epoch (POSIX) / FILETIME ticks (Windows)
+        u64 size  = 0;
+
+        [[nodiscard]] bool same_file(const file_key& o) const noexcept { return dev == o.dev && ino == o.ino; }
+
+        friend bool operator==(const file_key&, const file_key&) = default;
+
+        // one stat; no descriptor is kept
+        static auto of(const std::filesystem::path& path) noexcept -> std::expected<file_key, std::errc>;
+
+        // identity of an already open file (fstat / GetFileInformationByHandle)
+        static auto of(map_file::native_type handle) noexcept -> std::expected<file_key, std::errc>;
+    };
+
+    namespace details
+    {
+        struct file_id_hash
+        {
+            usize operator()(const file_key& k) const noexcept
+            {
+                return std::hash<u64>{}(k.ino * 0x9E3779B97F4A7C15ull ^ k.dev);
+            }
+        };
+
+        struct file_id_eq
+        {
+            bool operator()(const file_key& a, const file_key& b) const noexcept { return a.same_file(b); }
+        };
+    }
+
+    // --- map_view (shared read-only view with its own cursor) -------------------
+    // Copies share the mapping and get an independent cursor. The mapping lives
+    // as long as any view of it, even after the cache has evicted it.
+
+    class map_view : private memcur<const std::byte>
+    {
+        std::shared_ptr<const map_file> map_;
+
+    public:
+        map_view() noexcept = default;
+
+        explicit map_view(std::shared_ptr<const map_file> m) noexcept
+            : memcur(rcast<const std::byte*>(m->base()), m->size())
+            , map_(std::move(m))
+        {}
+
+        map_view(const map_view& o) noexcept
+            : memcur(rcast<const std::byte*>(o.base()), o.size())
+            , map_(o.map_)
+        {}
+
+        auto operator=(const map_view& o) noexcept -> map_view&
+        {
+            if (this != &o) {
+                memcur::operator=(memcur{ rcast<const std::byte*>(o.base()), o.size() });
+                map_ = o.map_;
+            }
+            return *this;
+        }
+
+        map_view(map_view&&) noexcept = default;
+        auto operator=(map_view&&) noexcept -> map_view& = default;
+
+        // --- re-exports from memcur (read side) ----------------------------
+
+        using memcur::operator bool;
+        using memcur::size;
+        using memcur::base;
+        using memcur::seek;
+        using memcur::advance;
+        using memcur::tell;
+        using memcur::remaining;
+        using memcur::pop;
+        using memcur::as_view;
+        using memcur::read_into;
+        using memcur::pop_into;
+        using memcur::read_strvw;
+        using memcur::bytes;
+        using memcur::as_p;
+        using memcur::matches;
+        using memcur::expect;
+
+        // views sharing this mapping (including this one)
+        [[nodiscard]] long use_count() const noexcept { return map_.use_count(); }
+    };
+
+    // --- map_cache (one mapping per file version, LRU over a byte budget) --------
+    // open() costs one stat on a hit; a miss keys the new entry on an fstat of
+    // the mapped descriptor. A changed mtime or size replaces the entry; views of
+    // the old version stay valid. The budget counts mapped bytes held by the
+    // cache; evicted mappings are released once their last view goes away.
+
+    class map_cache
+    {
+        struct entry
+        {
+            file_key                        key;
+            std::shared_ptr<const map_file> map;
+        };
+
+        using lru_t = std::list<entry>;
+
+        mutable std::mutex mtx_;
+        lru_t              lru_;     // front = most recently used
+        std::unordered_map<file_key, lru_t::iterator, details::file_id_hash, details::file_id_eq> index_;
+        usize              budget_;
+        usize              bytes_ = 0;
+        map_flag           flags_;
+
+        void drop(lru_t::iterator it) noexcept
+        {
+            bytes_ -= it->map->size();
+            index_.erase(it->key);
+            lru_.erase(it);
+        }
+
+        void trim() noexcept
+        {
+            // keep the newest entry even if it alone exceeds the budget
+            while (bytes_ > budget_ && lru_.size() > 1)
+                drop(std::prev(lru_.end()));
+        }
+
+    public:
+        static constexpr usize default_budget = usize{ 1 } << 30;
+
+        // flags: extra read-side map flags (e.g. populate, random); write is ignored
+        explicit map_cache(usize budget = default_budget, map_flag flags = {}) noexcept
+            : budget_(budget)
+            , flags_(flags & ~(map_flag::write | map_flag::exec | map_flag::shared))
+        {}
+
+        map_cache(const map_cache&) = delete;
+        auto operator=(const map_cache&) -> map_cache& = delete;
+
+        // process-wide cache, created on first use
+        [[nodiscard]] static map_cache& shared()
+        {
+            static map_cache c{};
+            return c;
+        }
+
+        [[nodiscard]] auto open(const std::filesystem::path& path) -> std::expected<map_view, std::errc>
+        {
+            auto key = file_key::of(path);
+            if (!key) return std::unexpected(key.error());
+
+            {
+                std::scoped_lock lk{ mtx_ };
+                if (auto it = index_.find(*key); it != index_.end()) {
+                    if (it->second->key == *key) {
+                        lru_.splice(lru_.begin(), lru_, it->second);
+                        return map_view{ it->second->map };
+                    }
+                    drop(it->second);   // file changed since it was mapped
+                }
+            }
+
+            // map outside the lock; a racing open of the same file keeps one.
+            // The entry is keyed on the handle that was mapped, not on the stat
+            // above, so a file replaced in between is not cached as the old one.
+            std::expected<file_key, std::errc> mapped = std::unexpected(std::errc::io_error);
+            auto m = map_file::traced_map(path, 0, 0, flags_,
+                [](map_file::native_type h, void* ctx) noexcept {
+                    *static_cast<std::expected<file_key, std::errc>*>(ctx) = file_key::of(h);
+                }, &mapped);
+            if (!m) return std::unexpected(m.error());
+            if (!mapped) return std::unexpected(mapped.error());
+            auto fresh = std::make_shared<const map_file>(std::move(*m));
+
+            std::scoped_lock lk{ mtx_ };
+            if (auto it = index_.find(*mapped); it != index_.end()) {
+                if (it->second->key == *mapped) {
+                    lru_.splice(lru_.begin(), lru_, it->second);
+                    return map_view{ it->second->map };
+                }
+                drop(it->second);
+            }
+
+            lru_.push_front(entry{ *mapped, fresh });
+            index_.emplace(*mapped, lru_.begin());
+            bytes_ += fresh->size();
+            trim();
+            return map_view{ std::move(fresh) };
+        }
+
+        // forget `path` (no-op when not cached)
+        void invalidate(const std::filesystem::path& path) noexcept
+        {
+            auto key = file_key::of(path);
+            if (!key) return;
+            std::scoped_lock lk{ mtx_ };
+            if (auto it = index_.find(*key); it != index_.end())
+                drop(it->second);
+        }
+
+        void clear() noexcept
+        {
+            std::scoped_lock lk{ mtx_ };
+            index_.clear();
+            lru_.clear();
+            bytes_ = 0;
+        }
+
+        void set_budget(usize budget) noexcept
+        {
+            std::scoped_lock lk{ mtx_ };
+            budget_ = budget;
+            trim();
+        }
+
+        [[nodiscard]] usize budget()   const noexcept { std::scoped_lock lk{ mtx_ }; return budget_; }
+        [[nodiscard]] usize resident() const noexcept { std::scoped_lock lk{ mtx_ }; return bytes_; }
+        [[nodiscard]] usize entries()  const noexcept { std::scoped_lock lk{ mtx_ }; return lru_.size(); }
+    };
+}
+
+#if !LBYTE_STX_COMPILED
+    #include "./cache_platform.hpp"
+#endif
@@ -0,0 +1,96 @@
+#pragma once
+#include "./cache.hpp"
+
+#include <cerrno>
+#include <expected>
+#include <filesystem>
+
+#if !defined(_WIN32)
+    #include <sys/stat.h>
+#else
+    #if !defined(NOMINMAX)
+        #define NOMINMAX
+    #endif
+    #if !defined(WIN32_LEAN_AND_MEAN)
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#endif
+
+// Defined empty by src/stx/platform.cpp, the one TU that owns these bodies
+// when the library is compiled.
+#if !defined(LBYTE_STX_PLATFORM_INLINE)
+    #define LBYTE_STX_PLATFORM_INLINE inline
+#endif
+
+namespace lbyte::stx
+{
+    // --- platform ---------------------------------------------------------------
+
+    #if defined(_WIN32)
+
+        LBYTE_STX_PLATFORM_INLINE auto file_key::of(map_file::native_type h) noexcept -> std::expected<file_key, std::errc>
+        {
+            BY_HANDLE_FILE_INFORMATION fi;
+            if (!GetFileInformationByHandle(h, &fi))
+                return std::unexpected(std::errc::io_error);
+
+            return file_key{
+                .dev   = fi.dwVolumeSerialNumber,
+                .ino   = (static_cast<u64>(fi.nFileIndexHigh) << 32) | fi.nFileIndexLow,
+                .mtime = static_cast<i64>((static_cast<u64>(fi.ftLastWriteTime.dwHighDateTime) << 32) | fi.ftLastWriteTime.dwLowDateTime),
+                .size  = (static_cast<u64>(fi.nFileSizeHigh) << 32) | fi.nFileSizeLow,
+            };
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file_key::of(const std::filesystem::path& path) noexcept -> std::expected<file_key, std::errc>
+        {
+            HANDLE h = CreateFileW(path.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                   nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (h == INVALID_HANDLE_VALUE)
+                return std::unexpected(std::errc::no_such_file_or_directory);
+
+            auto key = of(h);
+            CloseHandle(h);
+            return key;
+        }
+
+    #else // Linux / POSIX
+
+        namespace details
+        {
+            LBYTE_STX_PLATFORM_INLINE auto key_of(const struct stat& st) noexcept -> file_key
+            {
+                #if defined(__APPLE__)
+                    auto const& mt = st.st_mtimespec;
+                #else
+                    auto const& mt = st.st_mtim;
+                #endif
+
+                return file_key{
+                    .dev   = static_cast<u64>(st.st_dev),
+                    .ino   = static_cast<u64>(st.st_ino),
+                    .mtime = static_cast<i64>(mt.tv_sec) * 1'000'000'000 + static_cast<i64>(mt.tv_nsec),
+                    .size  = static_cast<u64>(st.st_size),
+                };
+            }
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file_key::of(const std::filesystem::path& path) noexcept -> std::expected<file_key, std::errc>
+        {
+            struct stat st;
+            if (::stat(path.c_str(), &st) < 0)
+                return std::unexpected(static_cast<std::errc>(errno));
+            return details::key_of(st);
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file_key::of(map_file::native_type fd) noexcept -> std::expected<file_key, std::errc>
+        {
+            struct stat st;
+            if (::fstat(fd, &st) < 0)
+                return std::unexpected(static_cast<std::errc>(errno));
+            return details::key_of(st);
+        }
+
+    #endif
+}
@@ -0,0 +1,1072 @@
+#pragma once
+#include "./core.hpp"
+#include "./digest.hpp"
+#include "./hash.hpp"
+#include "./stream.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+// Streaming decompression stages. A decoder pulls compressed bytes from a
+// codec::input and produces plain bytes in bounded windows; io::decode_source
+// turns it back into a byte_source, so stream_cur (and readahead_source for a
+// background decode) parses compressed images with flat memory.
+//
+// Errors:
+//   argument_out_of_domain  input ended inside the stream
+//   invalid_argument        malformed stream
+//   bad_message             checksum mismatch
+//   not_supported           preset dictionaries, unknown LZ4 frame versions
+
+namespace lbyte::stx::codec
+{
+    // --- input -----------------------------------------------------------------------
+    // Buffered compressed bytes. data() is what is buffered, consume() drops a
+    // prefix, refill() keeps the unread bytes and appends more (false at end of
+    // input). The source is type-erased so decoders are plain classes.
+
+    class input
+    {
+    public:
+        using read_fn = auto (*)( void*, std::span<std::byte> ) noexcept -> std::expected<usize, std::errc>;
+
+        static constexpr usize default_size = usize{ 64 } << 10;
+
+    private:
+        void*                        src_  = nullptr;
+        read_fn                      read_ = nullptr;
+        std::unique_ptr<std::byte[]> buf_;
+        usize                        cap_  = 0;
+        usize                        beg_  = 0;
+        usize                        end_  = 0;
+        u64                          used_ = 0;
+        bool                         eof_  = false;
+
+    public:
+        input() noexcept = default;
+
+        input( void* src, read_fn fn, usize size = default_size )
+            : src_( src ), read_( fn )
+            , buf_( std::make_unique_for_overwrite<std::byte[]>( std::max<usize>( size, 64 )))
+            , cap_( std::max<usize>( size, 64 ))
+        {}
+
+        template<io::byte_source S>
+        explicit input( S& src, usize size = default_size )
+            : input( &src, []( void* s, std::span<std::byte> out ) noexcept {
+                  return static_cast<S*>( s )->read( out );
+              }, size )
+        {}
+
+        [[nodiscard]] STX_FORCE_INLINE std::span<const std::byte> data() const noexcept
+        {
+            return { buf_.get() + beg_, end_ - beg_ };
+        }
+
+        STX_FORCE_INLINE void consume( usize n ) noexcept { beg_ += n; used_ += n; }
+
+        // compressed bytes handed to the decoder so far, including any it has
+        // read ahead into a bit buffer (see decode_source::consumed)
+        [[nodiscard]] u64 consumed() const noexcept { return used_; }
+
+        auto refill() noexcept -> std::expected<bool, std::errc>
+        {
+            if ( eof_ ) return false;
+            if ( beg_ != 0 ) {
+                std::memmove( buf_.get(), buf_.get() + beg_, end_ - beg_ );
+                end_ -= beg_;
+                beg_  = 0;
+            }
+            if ( end_ == cap_ ) return true;
+
+            auto n = read_( src_, std::span<std::byte>{ buf_.get() + end_, cap_ - end_ });
+            if ( !n ) [[unlikely]] return std::unexpected( n.error() );
+            if ( *n == 0 ) { eof_ = true; return false; }
+            end_ += *n;
+            return true;
+        }
+
+        // false only at end of input
+        auto more() noexcept -> std::expected<bool, std::errc>
+        {
+            if ( beg_ != end_ ) return true;
+            return refill();
+        }
+
+        // exactly out.size() bytes; large reads bypass the buffer
+        auto read( std::span<std::byte> out ) noexcept -> std::expected<void, std::errc>
+        {
+            auto const head = std::min( out.size(), end_ - beg_ );
+            if ( head != 0 ) std::memcpy( out.data(), buf_.get() + beg_, head );
+            consume( head );
+            out = out.subspan( head );
+
+            while ( out.size() >= cap_ && !eof_ ) {
+                auto n = read_( src_, out );
+                if ( !n ) [[unlikely]] return std::unexpected( n.error() );
+                if ( *n == 0 ) { eof_ = true; break; }
+                used_ += *n;
+                out = out.subspan( *n );
+            }
+
+            while ( !out.empty() ) {
+                auto r = refill();
+                if ( !r ) [[unlikely]] return std::unexpected( r.error() );
+                if ( !*r ) return std::unexpected( std::errc::argument_out_of_domain );
+                auto const k = std::min( out.size(), end_ - beg_ );
+                std::memcpy( out.data(), buf_.get() + beg_, k );
+                consume( k );
+                out = out.subspan( k );
+            }
+            return {};
+        }
+
+        auto skip( u64 n ) noexcept -> std::expected<void, std::errc>
+        {
+            while ( n != 0 ) {
+                if ( beg_ == end_ ) {
+                    auto r = refill();
+                    if ( !r ) [[unlikely]] return std::unexpected( r.error() );
+                    if ( !*r ) return std::unexpected( std::errc::argument_out_of_domain );
+                }
+                auto const k = scast<usize>( std::min<u64>( n, end_ - beg_ ));
+                consume( k );
+                n -= k;
+            }
+            return {};
+        }
+    };
+
+    // --- decoder -----------------------------------------------------------------------
+    // decode() fills a prefix of `out` and returns its length; 0 means the
+    // stream ended and its trailer checked out. Errors are sticky.
+
+    template<typename D>
+    concept decoder = requires( D& d, input& in, std::span<std::byte> out ) {
+        { d.decode( in, out ) } -> std::same_as<std::expected<usize, std::errc>>;
+    };
+
+    namespace details
+    {
+        // decoded bytes: [0, out) history, [out, pos) not yet delivered
+        struct window
+        {
+            static constexpr usize slack = 32;   // wild-copy overrun
+
+            std::unique_ptr<std::byte[]> buf;
+            usize                        cap = 0;
+            usize                        pos = 0;
+            usize                        out = 0;
+
+            void reserve( usize n )
+            {
+                if ( n <= cap ) return;
+                auto next = std::make_unique_for_overwrite<std::byte[]>( n + slack );
+                if ( pos != 0 ) std::memcpy( next.get(), buf.get(), pos );
+                buf = std::move( next );
+                cap = n;
+            }
+
+            [[nodiscard]] u8* at( usize i ) const noexcept { return rcast<u8*>( buf.get() ) + i; }
+
+            [[nodiscard]] usize pending() const noexcept { return pos - out; }
+
+            usize drain( std::span<std::byte> dst ) noexcept
+            {
+                auto const k = std::min( dst.size(), pending() );
+                std::memcpy( dst.data(), buf.get() + out, k );
+                out += k;
+                return k;
+            }
+
+            // keep the last `keep` delivered bytes as match history
+            void slide( usize keep ) noexcept
+            {
+                keep = std::min( keep, pos );
+                if ( keep != 0 && pos != keep ) std::memmove( buf.get(), buf.get() + pos - keep, keep );
+                pos = out = keep;
+            }
+        };
+
+        STX_FORCE_INLINE u32 load_le32( const u8* p ) noexcept
+        {
+            u32 v;
+            std::memcpy( &v, p, 4 );
+            if constexpr ( std::endian::native == std::endian::big ) v = std::byteswap( v );
+            return v;
+        }
+
+        // streaming form of hash::xxh32
+        class xxh32_state
+        {
+            u32                v_[4]{};
+            std::array<u8, 16> mem_{};
+            usize              fill_  = 0;
+            u64                total_ = 0;
+            u32                seed_  = 0;
+
+        public:
+            explicit xxh32_state( u32 seed = 0 ) noexcept { reset( seed ); }
+
+            void reset( u32 seed = 0 ) noexcept
+            {
+                using namespace hash::details;
+                seed_ = seed;
+                v_[0] = seed + xxh32_p1 + xxh32_p2;
+                v_[1] = seed + xxh32_p2;
+                v_[2] = seed;
+                v_[3] = seed - xxh32_p1;
+                fill_ = 0;
+                total_ = 0;
+            }
+
+            void update( const u8* p, usize n ) noexcept
+            {
+                using hash::details::xxh32_round;
+                total_ += n;
+                if ( fill_ + n < 16 ) {
+                    std::memcpy( mem_.data() + fill_, p, n );
+                    fill_ += n;
+                    return;
+                }
+                if ( fill_ != 0 ) {
+                    auto const k = 16 - fill_;
+                    std::memcpy( mem_.data() + fill_, p, k );
+                    for ( usize j = 0; j < 4; ++j )
+                        v_[j] = xxh32_round( v_[j], load_le32( mem_.data() + j * 4 ));
+                    p += k;
+                    n -= k;
+                    fill_ = 0;
+                }
+                for ( ; n >= 16; p += 16, n -= 16 )
+                    for ( usize j = 0; j < 4; ++j )
+                        v_[j] = xxh32_round( v_[j], load_le32( p + j * 4 ));
+                std::memcpy( mem_.data(), p, n );
+                fill_ = n;
+            }
+
+            [[nodiscard]] u32 digest() const noexcept
+            {
+                using namespace hash::details;
+                u32 h = total_ >= 16
+                    ? std::rotl( v_[0], 1 ) + std::rotl( v_[1], 7 ) + std::rotl( v_[2], 12 ) + std::rotl( v_[3], 18 )
+                    : seed_ + xxh32_p5;
+                h += scast<u32>( total_ );
+
+                usize i = 0;
+                for ( ; i + 4 <= fill_; i += 4 )
+                    h = std::rotl( h + load_le32( mem_.data() + i ) * xxh32_p3, 17 ) * xxh32_p4;
+                for ( ; i < fill_; ++i )
+                    h = std::rotl( h + mem_[i] * xxh32_p5, 11 ) * xxh32_p1;
+
+                h ^= h >> 15; h *= xxh32_p2;
+                h ^= h >> 13; h *= xxh32_p3;
+                h ^= h >> 16;
+                return h;
+            }
+        };
+
+        // One LZ4 block from `src` into `w` at w.pos. `src` and the window both
+        // have window::slack readable bytes past their ends for wild copies.
+        inline auto lz4_block( const u8* ip, usize n, window& w, usize limit ) noexcept
+            -> std::expected<void, std::errc>
+        {
+            auto const* const iend = ip + n;
+            auto* const       base = w.at( 0 );
+            auto*             op   = w.at( w.pos );
+            auto* const       oend = w.at( limit );
+            auto const        bad  = std::unexpected( std::errc::invalid_argument );
+
+            auto length = [&]( usize acc ) -> std::optional<usize> {
+                u8 b;
+                do {
+                    if ( ip == iend ) [[unlikely]] return std::nullopt;
+                    b = *ip++;
+                    acc += b;
+                } while ( b == 255 );
+                return acc;
+            };
+
+            for (;;) {
+                if ( ip == iend ) [[unlikely]] return bad;
+                auto const token = *ip++;
+
+                // short literal run + short match, far from both ends: fixed-size copies
+                if ( token < 0xF0 && ( token & 15 ) != 15
+                  && iend - ip >= 18 && oend - op >= 40 ) [[likely]] {
+                    usize const lit = token >> 4;
+                    std::memcpy( op, ip, 16 );
+                    usize const off = usize{ ip[lit] } | usize{ ip[lit + 1] } << 8;
+                    if ( off >= 8 && off <= scast<usize>( op + lit - base )) [[likely]] {
+                        ip += lit + 2;
+                        op += lit;
+                        auto const* from = op - off;
+                        std::memcpy( op,      from,      8 );
+                        std::memcpy( op + 8,  from + 8,  8 );
+                        std::memcpy( op + 16, from + 16, 8 );
+                        op += ( token & 15 ) + 4;
+                        continue;
+                    }
+                }
+
+                usize lit = token >> 4;
+                if ( lit == 15 ) {
+                    auto l = length( lit );
+                    if ( !l ) [[unlikely]] return bad;
+                    lit = *l;
+                }
+                if ( lit > scast<usize>( iend - ip ) || lit > scast<usize>( oend - op )) [[unlikely]]
+                    return bad;
+                if ( lit <= 16 ) std::memcpy( op, ip, 16 );
+                else             std::memcpy( op, ip, lit );
+                ip += lit;
+                op += lit;
+
+                if ( ip == iend ) break;   // last sequence: literals only
+
+                if ( iend - ip < 2 ) [[unlikely]] return bad;
+                usize const off = usize{ ip[0] } | usize{ ip[1] } << 8;
+                ip += 2;
+                if ( off == 0 || off > scast<usize>( op - base )) [[unlikely]] return bad;
+
+                usize ml = token & 15;
+                if ( ml == 15 ) {
+                    auto l = length( ml );
+                    if ( !l ) [[unlikely]] return bad;
+                    ml = *l;
+                }
+                ml += 4;
+                if ( ml > scast<usize>( oend - op )) [[unlikely]] return bad;
+
+                auto const* from = op - off;
+                if ( off >= 16 ) {
+                    for ( usize k = 0; k < ml; k += 16 ) std::memcpy( op + k, from + k, 16 );
+                } else if ( off >= 8 ) {
+                    for ( usize k = 0; k < ml; k += 8 ) std::memcpy( op + k, from + k, 8 );
+                } else {
+                    for ( usize k = 0; k < ml; ++k ) op[k] = from[k];
+                }
+                op += ml;
+            }
+
+            w.pos = scast<usize>( op - base );
+            return {};
+        }
+    }
+
+    // --- lz4_frame -----------------------------------------------------------------------
+    // LZ4 frame format (lz4 CLI, liblz4 LZ4F_*), concatenated and skippable frames
+    // included. Memory: one block of input and one of output (64 KiB - 4 MiB,
+    // from the frame header) plus 64 KiB of history for linked blocks. Block,
+    // header and content checksums are verified when present.
+
+    class lz4_frame
+    {
+        static constexpr u32   magic     = 0x184D2204u;
+        static constexpr usize history   = usize{ 64 } << 10;
+
+        details::window              win_;
+        std::unique_ptr<std::byte[]> blk_;
+        usize                        blk_cap_ = 0;
+        details::xxh32_state         xxh_;
+        u64                          content_ = 0;     // declared size, 0 = absent
+        u64                          produced_ = 0;
+        usize                        bmax_    = 0;
+        u32                          frames_  = 0;
+        bool                         linked_  = false;
+        bool                         block_ck_ = false;
+        bool                         content_ck_ = false;
+        bool                         sized_   = false;
+        bool                         in_frame_ = false;
+        bool                         done_    = false;
+        std::errc                    err_{};
+
+        static auto read_u32( input& in ) noexcept -> std::expected<u32, std::errc>
+        {
+            u8 b[4];
+            auto r = in.read( std::as_writable_bytes( std::span{ b }));
+            if ( !r ) return std::unexpected( r.error() );
+            return details::load_le32( b );
+        }
+
+        auto frame_header( input& in ) -> std::expected<void, std::errc>
+        {
+            for (;;) {
+                auto more = in.more();
+                if ( !more ) return std::unexpected( more.error() );
+                if ( !*more ) {
+                    if ( frames_ == 0 ) return std::unexpected( std::errc::argument_out_of_domain );
+                    done_ = true;
+                    return {};
+                }
+
+                auto m = read_u32( in );
+                if ( !m ) return std::unexpected( m.error() );
+                if (( *m & 0xFFFF'FFF0u ) == 0x184D2A50u ) {   // skippable frame
+                    auto len = read_u32( in );
+                    if ( !len ) return std::unexpected( len.error() );
+                    if ( auto r = in.skip( *len ); !r ) return r;
+                    continue;
+                }
+                if ( *m != magic ) return std::unexpected( std::errc::invalid_argument );
+                break;
+            }
+
+            u8 desc[14];
+            if ( auto r = in.read( std::as_writable_bytes( std::span{ desc, 2 })); !r ) return r;
+            auto const flg = desc[0];
+            auto const bd  = desc[1];
+            if (( flg >> 6 ) != 1 ) return std::unexpected( std::errc::not_supported );
+            if (( flg & 0x02 ) || ( bd & 0x8F )) return std::unexpected( std::errc::invalid_argument );
+            if ( flg & 0x01 ) return std::unexpected( std::errc::not_supported );   // dictionary id
+
+            usize len = 2;
+            sized_ = ( flg & 0x08 ) != 0;
+            if ( sized_ ) {
+                if ( auto r = in.read( std::as_writable_bytes( std::span{ desc + 2, 8 })); !r ) return r;
+                content_ = u64{ details::load_le32( desc + 2 ) } | u64{ details::load_le32( desc + 6 ) } << 32;
+                len = 10;
+            }
+            u8 hc;
+            if ( auto r = in.read( std::as_writable_bytes( std::span{ &hc, 1 })); !r ) return r;
+            if ((( hash::xxh32( std::span<const u8>{ desc, len }) >> 8 ) & 0xFF ) != hc )
+                return std::unexpected( std::errc::bad_message );
+
+            auto const code = ( bd >> 4 ) & 7;
+            if ( code < 4 ) return std::unexpected( std::errc::invalid_argument );
+            bmax_       = usize{ 1 } << ( 8 + 2 * code );   // 64 KiB, 256 KiB, 1 MiB, 4 MiB
+            linked_     = ( flg & 0x20 ) == 0;
+            block_ck_   = ( flg & 0x10 ) != 0;
+            content_ck_ = ( flg & 0x04 ) != 0;
+
+            win_.reserve( history + bmax_ );
+            if ( blk_cap_ < bmax_ ) {
+                blk_     = std::make_unique_for_overwrite<std::byte[]>( bmax_ + details::window::slack );
+                blk_cap_ = bmax_;
+            }
+            win_.pos = win_.out = 0;
+            xxh_.reset();
+            produced_ = 0;
+            in_frame_ = true;
+            return {};
+        }
+
+        // one block (or the end mark) into the window
+        auto block( input& in ) -> std::expected<void, std::errc>
+        {
+            auto word = read_u32( in );
+            if ( !word ) return std::unexpected( word.error() );
+
+            if ( *word == 0 ) {   // end mark
+                if ( content_ck_ ) {
+                    auto ck = read_u32( in );
+                    if ( !ck ) return std::unexpected( ck.error() );
+                    if ( *ck != xxh_.digest() ) return std::unexpected( std::errc::bad_message );
+                }
+                if ( sized_ && produced_ != content_ ) return std::unexpected( std::errc::invalid_argument );
+                in_frame_ = false;
+                ++frames_;
+                return {};
+            }
+
+            auto const raw  = ( *word & 0x8000'0000u ) != 0;
+            auto const size = scast<usize>( *word & 0x7FFF'FFFFu );
+            if ( size > bmax_ ) return std::unexpected( std::errc::invalid_argument );
+
+            auto const src = std::span<std::byte>{ blk_.get(), size };
+            if ( auto r = in.read( src ); !r ) return r;
+            if ( block_ck_ ) {
+                auto ck = read_u32( in );
+                if ( !ck ) return std::unexpected( ck.error() );
+                if ( *ck != hash::xxh32( std::span<const std::byte>{ src })) return std::unexpected( std::errc::bad_message );
+            }
+
+            if ( linked_ ) win_.slide( history );
+            else           win_.pos = win_.out = 0;
+
+            auto const start = win_.pos;
+            if ( raw ) {
+                std::memcpy( win_.at( win_.pos ), src.data(), size );
+                win_.pos += size;
+            } else if ( auto r = details::lz4_block( rcast<const u8*>( src.data() ), size, win_, start + bmax_ ); !r ) {
+                return r;
+            }
+
+            if ( content_ck_ ) xxh_.update( win_.at( start ), win_.pos - start );
+            produced_ += win_.pos - start;
+            return {};
+        }
+
+    public:
+        lz4_frame() noexcept = default;
+
+        auto decode( input& in, std::span<std::byte> out ) -> std::expected<usize, std::errc>
+        {
+            if ( err_ != std::errc{} ) return std::unexpected( err_ );
+            for (;;) {
+                if ( win_.pending() != 0 ) return win_.drain( out );
+                if ( done_ || out.empty() ) return usize{ 0 };
+
+                auto r = in_frame_ ? block( in ) : frame_header( in );
+                if ( !r ) [[unlikely]] {
+                    err_ = r.error();
+                    return std::unexpected( err_ );
+                }
+            }
+        }
+    };
+
+    // --- inflate ---------------------------------------------------------------------
+    // DEFLATE (RFC 1951) in a zlib (RFC 1950) or gzip (RFC 1952) wrapper, or raw.
+    // `detect` picks zlib or gzip from the first two bytes. Concatenated gzip
+    // members are decoded as one stream. Memory: 32 KiB of history plus the
+    // output window. Adler-32 / CRC-32 and ISIZE trailers are verified.
+
+    enum class wrapper : u8
+    {
+        detect,
+        zlib  ,
+        gzip  ,
+        raw   ,
+    };
+
+    namespace details
+    {
+        // canonical Huffman code: a 10-bit first-level table, longer codes walk
+        // the counts (rare by construction: long codes are rare symbols)
+        [[nodiscard]] constexpr u32 reverse_bits( u32 code, u32 len ) noexcept
+        {
+            u32 r = 0;
+            for ( u32 i = 0; i < len; ++i, code >>= 1 ) r = r << 1 | ( code & 1 );
+            return r;
+        }
+
+        struct huffman
+        {
+            static constexpr u32 fast_bits = 10;
+
+            std::array<u16, 1u << fast_bits> fast{};   // sym | len << 9, len 0 = slow path
+            std::array<u16, 16>              count{};
+            std::array<u16, 288>             sorted{};
+
+            // false when the lengths over-subscribe the code space
+            bool build( const u8* lens, usize n ) noexcept
+            {
+                count.fill( 0 );
+                fast.fill( 0 );
+                for ( usize s = 0; s < n; ++s ) ++count[lens[s]];
+                count[0] = 0;
+
+                int left = 1;
+                for ( usize len = 1; len < 16; ++len ) {
+                    left <<= 1;
+                    left -= count[len];
+                    if ( left < 0 ) return false;
+                }
+
+                std::array<u16, 16> offs{};
+                for ( usize len = 1; len < 15; ++len ) offs[len + 1] = scast<u16>( offs[len] + count[len] );
+                for ( usize s = 0; s < n; ++s )
+                    if ( lens[s] != 0 ) sorted[offs[lens[s]]++] = scast<u16>( s );
+
+                u32   code = 0;
+                usize idx  = 0;
+                for ( u32 len = 1; len <= fast_bits; ++len, code <<= 1 ) {
+                    for ( u32 k = 0; k < count[len]; ++k, ++code ) {
+                        auto const rev   = reverse_bits( code, len );
+                        auto const entry = scast<u16>( sorted[idx++] | len << 9 );
+                        for ( u32 i = rev; i < ( 1u << fast_bits ); i += 1u << len ) fast[i] = entry;
+                    }
+                }
+                return true;
+            }
+        };
+    }
+
+    class inflate
+    {
+        enum class state : u8 { header, block, stored, codes, trailer, done };
+
+        static constexpr usize history   = usize{ 32 } << 10;
+        static constexpr usize max_match = 258;
+
+        details::window  win_;
+        details::huffman lit_;
+        details::huffman dist_;
+        u64              bb_ = 0;       // bit buffer, LSB first
+        u32              bc_ = 0;       // bits in bb_
+        usize            chunk_;
+        usize            stored_ = 0;   // bytes left in a stored block
+        usize            summed_ = 0;   // window bytes folded into the checksum
+        u32              isize_  = 0;
+        wrapper          wrap_;
+        wrapper          kind_;
+        state            st_ = state::header;
+        bool             last_ = false;
+        std::errc        err_{};
+        digest::adler32  adler_;
+        digest::crc32    crc_;
+
+        // --- bits --------------------------------------------------------------------
+
+        bool fail( std::errc e ) noexcept
+        {
+            if ( err_ == std::errc{} ) err_ = e;
+            return false;
+        }
+
+        // top up to at least 56 bits, or what is left of the input
+        bool fill( input& in ) noexcept
+        {
+            while ( bc_ <= 56 ) {
+                auto const d = in.data();
+                if ( d.size() >= 8 ) {
+                    u64 w;
+                    std::memcpy( &w, d.data(), 8 );
+                    if constexpr ( std::endian::native == std::endian::big ) w = std::byteswap( w );
+                    auto const k = ( 64 - bc_ ) >> 3;   // whole bytes that fit
+                    if ( k < 8 ) w &= ( u64{ 1 } << ( k * 8 )) - 1;
+                    bb_ |= w << bc_;
+                    bc_ += k * 8;
+                    in.consume( k );
+                    return true;
+                }
+                if ( d.empty() ) {
+                    auto r = in.refill();
+                    if ( !r ) [[unlikely]] return fail( r.error() );
+                    if ( !*r ) return true;
+                    continue;
+                }
+                bb_ |= u64{ scast<u8>( d[0] ) } << bc_;
+                bc_ += 8;
+                in.consume( 1 );
+            }
+            return true;
+        }
+
+        STX_FORCE_INLINE bool need( input& in, u32 n ) noexcept
+        {
+            if ( bc_ >= n ) [[likely]] return true;
+            if ( !fill( in )) return false;
+            if ( bc_ < n ) return fail( std::errc::argument_out_of_domain );
+            return true;
+        }
+
+        STX_FORCE_INLINE u32 bits( u32 n ) noexcept
+        {
+            auto const v = scast<u32>( bb_ & (( u64{ 1 } << n ) - 1 ));
+            bb_ >>= n;
+            bc_  -= n;
+            return v;
+        }
+
+        bool byte( input& in, u32& v ) noexcept
+        {
+            if ( !need( in, 8 )) return false;
+            v = bits( 8 );
+            return true;
+        }
+
+        void align() noexcept { bits( bc_ & 7 ); }
+
+        // symbol, or -1 (err_ set)
+        STX_FORCE_INLINE int symbol( const details::huffman& h ) noexcept
+        {
+            auto const e   = h.fast[bb_ & (( 1u << details::huffman::fast_bits ) - 1 )];
+            auto const len = u32{ e } >> 9;
+            if ( len != 0 && len <= bc_ ) [[likely]] {
+                bb_ >>= len;
+                bc_  -= len;
+                return e & 0x1FF;
+            }
+
+            // canonical walk, one bit per length
+            int code = 0, first = 0, index = 0;
+            for ( u32 l = 1; l < 16; ++l ) {
+                if ( l > bc_ ) { fail( std::errc::argument_out_of_domain ); return -1; }
+                code |= scast<int>(( bb_ >> ( l - 1 )) & 1 );
+                int const n = h.count[l];
+                if ( code - n < first ) {
+                    bb_ >>= l;
+                    bc_  -= l;
+                    return h.sorted[scast<usize>( index + ( code - first ))];
+                }
+                index += n;
+                first  = ( first + n ) << 1;
+                code <<= 1;
+            }
+            fail( std::errc::invalid_argument );
+            return -1;
+        }
+
+        // --- wrapper -----------------------------------------------------------------
+
+        bool header( input& in ) noexcept
+        {
+            kind_ = wrap_;
+            if ( kind_ == wrapper::detect ) {
+                if ( !need( in, 16 )) return false;
+                kind_ = ( bb_ & 0xFFFF ) == 0x8B1F ? wrapper::gzip : wrapper::zlib;
+            }
+
+            if ( kind_ == wrapper::zlib ) {
+                u32 cmf, flg;
+                if ( !byte( in, cmf ) || !byte( in, flg )) return false;
+                if (( cmf & 0x0F ) != 8 || ( cmf >> 4 ) > 7 || ( cmf << 8 | flg ) % 31 != 0 )
+                    return fail( std::errc::invalid_argument );
+                if ( flg & 0x20 ) return fail( std::errc::not_supported );   // preset dictionary
+                adler_.reset();
+            } else if ( kind_ == wrapper::gzip ) {
+                u32 h[10];
+                for ( auto& b : h ) if ( !byte( in, b )) return false;
+                if ( h[0] != 0x1F || h[1] != 0x8B || h[2] != 8 || ( h[3] & 0xE0 ))
+                    return fail( std::errc::invalid_argument );
+                auto const flg = h[3];
+                if ( flg & 0x04 ) {   // FEXTRA
+                    u32 lo, hi;
+                    if ( !byte( in, lo ) || !byte( in, hi )) return false;
+                    for ( u32 n = lo | hi << 8, b; n != 0; --n ) if ( !byte( in, b )) return false;
+                }
+                for ( u32 bit : { 0x08u, 0x10u } ) {   // FNAME, FCOMMENT
+                    if ( !( flg & bit )) continue;
+                    for ( u32 b = 1; b != 0; ) if ( !byte( in, b )) return false;
+                }
+                if ( flg & 0x02 ) {   // FHCRC
+                    u32 b;
+                    if ( !byte( in, b ) || !byte( in, b )) return false;
+                }
+                crc_.reset();
+                isize_ = 0;
+            }
+            last_ = false;
+            st_   = state::block;
+            return true;
+        }
+
+        void sum() noexcept
+        {
+            auto const part = std::span<const std::byte>{ win_.buf.get() + summed_, win_.pos - summed_ };
+            if ( kind_ == wrapper::zlib )      adler_.update( part );
+            else if ( kind_ == wrapper::gzip ) { crc_.update( part ); isize_ += scast<u32>( part.size() ); }
+            summed_ = win_.pos;
+        }
+
+        bool trailer( input& in ) noexcept
+        {
+            sum();
+            align();
+            if ( kind_ == wrapper::zlib ) {
+                u32 v = 0;
+                for ( int i = 0; i < 4; ++i ) {
+                    u32 b;
+                    if ( !byte( in, b )) return false;
+                    v = v << 8 | b;
+                }
+                if ( v != adler_.finish() ) return fail( std::errc::bad_message );
+            } else if ( kind_ == wrapper::gzip ) {
+                u32 v[2] = {};
+                for ( auto& w : v )
+                    for ( int i = 0; i < 4; ++i ) {
+                        u32 b;
+                        if ( !byte( in, b )) return false;
+                        w |= b << ( 8 * i );
+                    }
+                if ( v[0] != crc_.finish() || v[1] != isize_ ) return fail( std::errc::bad_message );
+
+                // another member follows?
+                if ( !fill( in )) return false;
+                if ( bc_ >= 16 && ( bb_ & 0xFFFF ) == 0x8B1F ) {
+                    st_ = state::header;
+                    return true;
+                }
+            }
+            st_ = state::done;
+            return true;
+        }
+
+        // --- blocks ------------------------------------------------------------------
+
+        bool block_header( input& in ) noexcept
+        {
+            if ( last_ ) { st_ = state::trailer; return true; }
+            if ( !need( in, 3 )) return false;
+            last_ = bits( 1 ) != 0;
+
+            switch ( bits( 2 )) {
+                case 0: {
+                    align();
+                    if ( !need( in, 32 )) return false;
+                    auto const len  = bits( 16 );
+                    auto const nlen = bits( 16 );
+                    if (( len ^ 0xFFFF ) != nlen ) return fail( std::errc::invalid_argument );
+                    stored_ = len;
+                    st_     = state::stored;
+                    return true;
+                }
+                case 1: {
+                    u8 lens[288 + 30];
+                    std::fill_n( lens,       144, u8{ 8 });
+                    std::fill_n( lens + 144, 112, u8{ 9 });
+                    std::fill_n( lens + 256,  24, u8{ 7 });
+                    std::fill_n( lens + 280,   8, u8{ 8 });
+                    std::fill_n( lens + 288,  30, u8{ 5 });
+                    lit_.build( lens, 288 );
+                    dist_.build( lens + 288, 30 );
+                    st_ = state::codes;
+                    return true;
+                }
+                case 2:
+                    return dynamic( in );
+                default:
+                    return fail( std::errc::invalid_argument );
+            }
+        }
+
+        bool dynamic( input& in ) noexcept
+        {
+            static constexpr u8 order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+            if ( !need( in, 14 )) return false;
+            auto const nlen  = bits( 5 ) + 257;
+            auto const ndist = bits( 5 ) + 1;
+            auto const ncode = bits( 4 ) + 4;
+            if ( nlen > 286 || ndist > 30 ) return fail( std::errc::invalid_argument );
+
+            u8 lens[286 + 30]{};
+            for ( u32 i = 0; i < ncode; ++i ) {
+                if ( !need( in, 3 )) return false;
+                lens[order[i]] = scast<u8>( bits( 3 ));
+            }
+            details::huffman cl;
+            if ( !cl.build( lens, 19 )) return fail( std::errc::invalid_argument );
+            std::fill_n( lens, 19, u8{ 0 });
+
+            for ( u32 i = 0; i < nlen + ndist; ) {
+                if ( bc_ < 16 && !fill( in )) return false;
+                auto const s = symbol( cl );
+                if ( s < 0 ) return false;
+                if ( s < 16 ) { lens[i++] = scast<u8>( s ); continue; }
+
+                u8  fill_with = 0;
+                u32 rep;
+                if ( s == 16 ) {
+                    if ( i == 0 ) return fail( std::errc::invalid_argument );
+                    if ( !need( in, 2 )) return false;
+                    fill_with = lens[i - 1];
+                    rep = 3 + bits( 2 );
+                } else if ( s == 17 ) {
+                    if ( !need( in, 3 )) return false;
+                    rep = 3 + bits( 3 );
+                } else {
+                    if ( !need( in, 7 )) return false;
+                    rep = 11 + bits( 7 );
+                }
+                if ( i + rep > nlen + ndist ) return fail( std::errc::invalid_argument );
+                std::fill_n( lens + i, rep, fill_with );
+                i += rep;
+            }
+
+            if ( lens[256] == 0 ) return fail( std::errc::invalid_argument );   // no end-of-block code
+            if ( !lit_.build( lens, nlen ) || !dist_.build( lens + nlen, ndist ))
+                return fail( std::errc::invalid_argument );
+            st_ = state::codes;
+            return true;
+        }
+
+        bool stored( input& in ) noexcept
+        {
+            auto room = win_.cap - win_.pos;
+            while ( stored_ != 0 && room != 0 ) {
+                usize k;
+                if ( bc_ >= 8 ) {   // bytes already pulled into the bit buffer come first
+                    *win_.at( win_.pos ) = scast<u8>( bits( 8 ));
+                    k = 1;
+                } else {
+                    auto const d = in.data();
+                    if ( d.empty() ) {
+                        auto r = in.refill();
+                        if ( !r ) return fail( r.error() );
+                        if ( !*r ) return fail( std::errc::argument_out_of_domain );
+                        continue;
+                    }
+                    k = std::min({ stored_, room, d.size() });
+                    std::memcpy( win_.at( win_.pos ), d.data(), k );
+                    in.consume( k );
+                }
+                win_.pos += k;
+                stored_  -= k;
+                room     -= k;
+            }
+            if ( stored_ == 0 ) st_ = state::block;
+            return true;
+        }
+
+        bool codes( input& in ) noexcept
+        {
+            static constexpr u16 len_base[29] = {
+                3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+            static constexpr u8 len_extra[29] = {
+                0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+            static constexpr u16 dist_base[30] = {
+                1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+            static constexpr u8 dist_extra[30] = {
+                0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+            auto const limit = win_.cap - max_match;
+            auto*      base  = win_.at( 0 );
+            usize      pos   = win_.pos;
+
+            while ( pos <= limit ) {
+                if ( bc_ < 48 && !fill( in )) break;
+
+                auto const s = symbol( lit_ );
+                if ( s < 0 ) break;
+                if ( s < 256 ) { base[pos++] = scast<u8>( s ); continue; }
+                if ( s == 256 ) { st_ = state::block; break; }
+                if ( s > 285 ) { fail( std::errc::invalid_argument ); break; }
+
+                auto const li = scast<usize>( s - 257 );
+                if ( !need( in, len_extra[li] )) break;
+                usize const len = len_base[li] + bits( len_extra[li] );
+
+                auto const d = symbol( dist_ );
+                if ( d < 0 ) break;
+                if ( d > 29 ) { fail( std::errc::invalid_argument ); break; }
+                auto const di = scast<usize>( d );
+                if ( !need( in, dist_extra[di] )) break;
+                usize const dist = dist_base[di] + bits( dist_extra[di] );
+                if ( dist > pos ) { fail( std::errc::invalid_argument ); break; }
+
+                auto*       o    = base + pos;
+                auto const* from = o - dist;
+                if ( dist >= 8 ) {
+                    for ( usize k = 0; k < len; k += 8 ) std::memcpy( o + k, from + k, 8 );
+                } else if ( dist == 1 ) {
+                    std::memset( o, *from, len );
+                } else {
+                    for ( usize k = 0; k < len; ++k ) o[k] = from[k];
+                }
+                pos += len;
+            }
+
+            win_.pos = pos;
+            return err_ == std::errc{};
+        }
+
+        // decode until the window is full or the stream ends
+        bool step( input& in ) noexcept
+        {
+            if ( win_.cap - win_.pos < chunk_ / 2 ) {
+                sum();
+                win_.slide( history );
+                summed_ = win_.pos;
+            }
+
+            while ( win_.pos + max_match <= win_.cap ) {
+                bool ok = true;
+                switch ( st_ ) {
+                    case state::header:  ok = header( in ); break;
+                    case state::block:   ok = block_header( in ); break;
+                    case state::stored:  ok = stored( in ); break;
+                    case state::codes:   ok = codes( in ); break;
+                    case state::trailer: ok = trailer( in ); break;
+                    case state::done:    return true;
+                }
+                if ( !ok ) return false;
+                if ( st_ == state::done ) return true;
+            }
+            return true;
+        }
+
+    public:
+        static constexpr usize default_window = usize{ 256 } << 10;
+
+        // `window`: decoded bytes produced per step, on top of the 32 KiB history
+        explicit inflate( wrapper w = wrapper::detect, usize window = default_window )
+            : chunk_( std::max<usize>( window, 4096 )), wrap_( w ), kind_( w )
+        {
+            win_.reserve( history + chunk_ );
+        }
+
+        auto decode( input& in, std::span<std::byte> out ) -> std::expected<usize, std::errc>
+        {
+            for (;;) {
+                if ( win_.pending() != 0 ) return win_.drain( out );
+                if ( err_ != std::errc{} ) return std::unexpected( err_ );
+                if ( st_ == state::done || out.empty() ) return usize{ 0 };
+                step( in );
+            }
+        }
+
+        // whole input bytes pulled into the bit buffer but not decoded yet
+        [[nodiscard]] u64 buffered() const noexcept { return bc_ / 8; }
+    };
+}
+
+namespace lbyte::stx::io
+{
+    // --- decode_source<Decoder, Source> ------------------------------------------------
+    // byte_source over the decoded stream of `Source`. Not seekable; the
+    // compressed side is read through a codec::input buffer of `in_size` bytes.
+
+    template<codec::decoder Decoder, byte_source Source>
+    class decode_source
+    {
+        struct state
+        {
+            Source       src;
+            Decoder      dec;
+            codec::input in;
+
+            state( Decoder d, Source s, usize in_size )
+                : src( std::move( s )), dec( std::move( d )), in( src, in_size )
+            {}
+        };
+
+        std::unique_ptr<state> st_;   // codec::input points at src
+
+    public:
+        explicit decode_source( Decoder dec, Source src, usize in_size = codec::input::default_size )
+            : st_( std::make_unique<state>( std::move( dec ), std::move( src ), in_size ))
+        {}
+
+        auto read( std::span<std::byte> out ) -> std::expected<usize, std::errc>
+        {
+            return st_->dec.decode( st_->in, out );
+        }
+
+        // compressed bytes decoded so far; read-ahead still sitting in the
+        // decoder's bit buffer is not counted, so input resumes here cleanly
+        [[nodiscard]] u64 consumed() const noexcept
+        {
+            auto n = st_->in.consumed();
+            if constexpr ( requires( const Decoder& d ) { d.buffered(); } ) n -= st_->dec.buffered();
+            return n;
+        }
+    };
+
+    template<codec::decoder D, byte_source S>
+    decode_source( D, S ) -> decode_source<D, S>;
+
+    template<codec::decoder D, byte_source S>
+    decode_source( D, S, usize ) -> decode_source<D, S>;
+}
+
+#undef STX_FORCE_INLINE
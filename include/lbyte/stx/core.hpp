@@ -240,6 +240,20 @@ namespace lbyte::stx
         && not std::same_as<std::remove_cv_t<T>, bool>
         && not std::same_as<std::remove_cv_t<T>, void>;
 
+    // memcur's cursor surface (memcur, map_file, map_view). The scan, strtab,
+    // addr and bit cursor helpers are free functions over this, so memcur.hpp
+    // doesn't have to include those headers.
+    template<typename C>
+    concept byte_cursor
+        =  requires (C& c, off_s o) {
+            { c.bytes().data() } -> std::convertible_to<const void*>;
+            { c.bytes().size() } -> std::convertible_to<usize>;
+            { c.tell() } -> std::same_as<off_s>;
+            { c.size() } -> std::convertible_to<usize>;
+            c.seek(o);
+            c.advance(o);
+           };
+
     namespace details {
         template<typename T> struct bounded_array_impl { using type = T; };
         template<typename T, usize N> struct bounded_array_impl<T[N]> {
@@ -249,6 +263,17 @@ namespace lbyte::stx
         using bounded_array_t = typename bounded_array_impl<T>::type;
     }
 
+    namespace io {
+        enum class origin : u8
+        {
+            begin  = 0,
+            current,
+            end    ,
+        };
+    }
+
+    using io::origin;
+
     template<typename T>
     concept byte_offset
         =  std::same_as<std::remove_cvref_t<T>, off_s>
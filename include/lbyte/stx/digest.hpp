@@ -0,0 +1,720 @@
+#pragma once
+#include "core.hpp"
+#include "hash.hpp"
+#include "par.hpp"
+#include "simd.hpp"
+#include "stream.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// --- kernel selection ------------------------------------------------------------
+// Compile-time, like hash.hpp; every kernel matches the scalar code bit for bit.
+//   LBYTE_STX_DIGEST_SHA_X86     sha256 via SHA-NI (-msha -msse4.1)
+//   LBYTE_STX_DIGEST_SHA_ARM     sha256 via ARMv8 crypto (-march=armv8-a+crypto)
+//   LBYTE_STX_DIGEST_ADLER_X86   adler32 via SSSE3 pmaddubsw / psadbw
+// crc32 / crc32c use the hash.hpp kernels (PCLMULQDQ, SSE4.2, ARMv8 CRC).
+
+#if !defined(LBYTE_STX_DIGEST_SHA_X86)
+    #if defined(__SHA__) && ( defined(__SSE4_1__) || LBYTE_STX_SIMD_AVX2 )
+        #define LBYTE_STX_DIGEST_SHA_X86 1
+    #else
+        #define LBYTE_STX_DIGEST_SHA_X86 0
+    #endif
+#endif
+
+#if !defined(LBYTE_STX_DIGEST_SHA_ARM)
+    #if ( defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO) ) && defined(__aarch64__)
+        #define LBYTE_STX_DIGEST_SHA_ARM 1
+    #else
+        #define LBYTE_STX_DIGEST_SHA_ARM 0
+    #endif
+#endif
+
+#if !defined(LBYTE_STX_DIGEST_ADLER_X86)
+    #if defined(__SSSE3__) || LBYTE_STX_SIMD_AVX2
+        #define LBYTE_STX_DIGEST_ADLER_X86 1
+    #else
+        #define LBYTE_STX_DIGEST_ADLER_X86 0
+    #endif
+#endif
+
+#if LBYTE_STX_DIGEST_SHA_X86
+    #include <immintrin.h>
+#endif
+#if LBYTE_STX_DIGEST_ADLER_X86
+    #include <tmmintrin.h>
+#endif
+#if LBYTE_STX_DIGEST_SHA_ARM
+    #include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx::digest
+{
+    inline constexpr bool hw_sha256  = LBYTE_STX_DIGEST_SHA_X86 || LBYTE_STX_DIGEST_SHA_ARM;
+    inline constexpr bool hw_adler32 = LBYTE_STX_DIGEST_ADLER_X86;
+
+    // --- engine protocol ---------------------------------------------------------
+    // update() takes the next bytes, finish() returns the digest of everything so
+    // far without consuming the state, reset() starts over.
+
+    template<typename E>
+    concept engine = std::default_initializable<E> && requires( E& e, const E& ce, std::span<const std::byte> s ) {
+        typename E::result_type;
+        { e.update( s ) } -> std::same_as<E&>;
+        { ce.finish()   } -> std::same_as<typename E::result_type>;
+        e.reset();
+    };
+
+    // Splittable digests: fork(at) is an empty engine for bytes starting at
+    // absolute offset `at`; append(part) adds a fork that continues exactly where
+    // this engine stopped. The merged value equals the sequential one.
+    template<typename E>
+    concept mergeable = engine<E> && requires( E& e, const E& ce, u64 at ) {
+        { ce.fork( at )  } -> std::same_as<E>;
+        { e.append( ce ) } -> std::same_as<E&>;
+    };
+
+    // --- crc32 / crc32c ----------------------------------------------------------
+
+    namespace details
+    {
+        template<u32 ( *Fn )( std::span<const std::byte>, u32 ), u32 ( *Combine )( u32, u32, u64 )>
+        class crc_engine
+        {
+            u32 crc_ = 0;
+            u64 len_ = 0;
+
+        public:
+            using result_type = u32;
+
+            crc_engine& update( std::span<const std::byte> s ) noexcept
+            {
+                crc_  = Fn( s, crc_ );
+                len_ += s.size();
+                return *this;
+            }
+
+            [[nodiscard]] u32   finish() const noexcept { return crc_; }
+            [[nodiscard]] u64   size()   const noexcept { return len_; }
+            void                reset()        noexcept { crc_ = 0; len_ = 0; }
+
+            [[nodiscard]] crc_engine fork( u64 ) const noexcept { return {}; }
+
+            crc_engine& append( const crc_engine& part ) noexcept
+            {
+                crc_  = Combine( crc_, part.crc_, part.len_ );
+                len_ += part.len_;
+                return *this;
+            }
+        };
+
+        inline u32 crc32_span ( std::span<const std::byte> s, u32 c ) noexcept { return hash::crc32 ( s, c ); }
+        inline u32 crc32c_span( std::span<const std::byte> s, u32 c ) noexcept { return hash::crc32c( s, c ); }
+    }
+
+    using crc32  = details::crc_engine<&details::crc32_span,  &hash::crc32_combine>;
+    using crc32c = details::crc_engine<&details::crc32c_span, &hash::crc32c_combine>;
+
+    // --- adler32 (zlib) ----------------------------------------------------------
+
+    namespace details
+    {
+        inline constexpr u32   adler_base = 65521;
+        inline constexpr usize adler_nmax = 5552;   // largest n with no u32 overflow of b
+
+        inline void adler_scalar( u32& a, u32& b, const u8* p, usize n ) noexcept
+        {
+            while ( n ) {
+                auto k = std::min( n, adler_nmax );
+                n -= k;
+                for ( ; k >= 8; k -= 8, p += 8 ) {
+                    a += p[0]; b += a; a += p[1]; b += a; a += p[2]; b += a; a += p[3]; b += a;
+                    a += p[4]; b += a; a += p[5]; b += a; a += p[6]; b += a; a += p[7]; b += a;
+                }
+                for ( ; k; --k ) { a += *p++; b += a; }
+                a %= adler_base;
+                b %= adler_base;
+            }
+        }
+
+    #if LBYTE_STX_DIGEST_ADLER_X86
+        // 32-byte blocks: a += sum(d), b += 32 * a + sum((32 - i) * d_i)
+        inline void adler_ssse3( u32& a, u32& b, const u8* p, usize n ) noexcept
+        {
+            constexpr usize block = 32;
+            auto blocks = n / block;
+            n -= blocks * block;
+
+            __m128i const tap1 = _mm_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+            __m128i const tap2 = _mm_setr_epi8( 16, 15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1 );
+            __m128i const zero = _mm_setzero_si128();
+            __m128i const ones = _mm_set1_epi16( 1 );
+
+            auto hsum = []( __m128i v ) {
+                v = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0x4E ));
+                v = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0xB1 ));
+                return scast<u32>( _mm_cvtsi128_si32( v ));
+            };
+
+            while ( blocks ) {
+                auto k = std::min( blocks, adler_nmax / block );
+                blocks -= k;
+
+                __m128i ps = _mm_cvtsi32_si128( scast<int>( a * scast<u32>( k )));
+                __m128i s2 = _mm_cvtsi32_si128( scast<int>( b ));
+                __m128i s1 = zero;
+
+                for ( ; k; --k, p += block ) {
+                    __m128i const d1 = _mm_loadu_si128( rcast<const __m128i*>( p ));
+                    __m128i const d2 = _mm_loadu_si128( rcast<const __m128i*>( p + 16 ));
+                    ps = _mm_add_epi32( ps, s1 );
+                    s1 = _mm_add_epi32( s1, _mm_add_epi32( _mm_sad_epu8( d1, zero ), _mm_sad_epu8( d2, zero )));
+                    s2 = _mm_add_epi32( s2, _mm_madd_epi16( _mm_maddubs_epi16( d1, tap1 ), ones ));
+                    s2 = _mm_add_epi32( s2, _mm_madd_epi16( _mm_maddubs_epi16( d2, tap2 ), ones ));
+                }
+                s2 = _mm_add_epi32( s2, _mm_slli_epi32( ps, 5 ));
+
+                a = ( a + hsum( s1 )) % adler_base;
+                b = hsum( s2 ) % adler_base;
+            }
+            adler_scalar( a, b, p, n );
+        }
+    #endif
+    }
+
+    class adler32
+    {
+        u32 a_   = 1;
+        u32 b_   = 0;
+        u64 len_ = 0;
+
+    public:
+        using result_type = u32;
+
+        adler32& update( std::span<const std::byte> s ) noexcept
+        {
+            auto const* p = rcast<const u8*>( s.data() );
+        #if LBYTE_STX_DIGEST_ADLER_X86
+            details::adler_ssse3( a_, b_, p, s.size() );
+        #else
+            details::adler_scalar( a_, b_, p, s.size() );
+        #endif
+            len_ += s.size();
+            return *this;
+        }
+
+        [[nodiscard]] u32 finish() const noexcept { return ( b_ << 16 ) | a_; }
+        [[nodiscard]] u64 size()   const noexcept { return len_; }
+        void              reset()        noexcept { a_ = 1; b_ = 0; len_ = 0; }
+
+        [[nodiscard]] adler32 fork( u64 ) const noexcept { return {}; }
+
+        // zlib adler32_combine
+        adler32& append( const adler32& part ) noexcept
+        {
+            constexpr u32 base = details::adler_base;
+            auto const rem = scast<u32>( part.len_ % base );
+
+            u32 a = a_ + part.a_ + base - 1;
+            u32 b = scast<u32>(( u64{ rem } * a_ ) % base ) + b_ + part.b_ + base - rem;
+            if ( a >= base ) a -= base;
+            if ( a >= base ) a -= base;
+            if ( b >= 2 * base ) b -= 2 * base;
+            if ( b >= base ) b -= base;
+
+            a_ = a; b_ = b;
+            len_ += part.len_;
+            return *this;
+        }
+    };
+
+    // --- pe_checksum (IMAGE_OPTIONAL_HEADER::CheckSum) ----------------------------
+    // 16-bit end-around-carry sum of the image with the CheckSum field read as
+    // zero, plus the file size. Since 2^16 == 1 (mod 0xFFFF), whole u32 words can
+    // be summed and folded once per block; the result matches CheckSumMappedFile.
+
+    class pe_checksum
+    {
+        u64 field_ = ~u64{ 0 };   // absolute offset of the 4-byte CheckSum field
+        u64 pos_   = 0;           // absolute offset of the next byte
+        u64 sum_   = 0;
+
+        static constexpr u64 fold32( u64 x ) noexcept { return ( x & 0xFFFF'FFFFull ) + ( x >> 32 ); }
+
+        // sum of bytes at an even position into the u32-word domain
+        static u64 sum_even( const u8* p, usize n ) noexcept
+        {
+            constexpr usize block = usize{ 1 } << 30;   // sum of u32 words fits u64
+            u64 total = 0;
+            while ( n >= 4 ) {
+                auto const k = std::min( n, block ) & ~usize{ 3 };
+                u64 s = 0;
+                for ( usize i = 0; i < k; i += 4 ) {
+                    u32 w;
+                    std::memcpy( &w, p + i, 4 );
+                    if constexpr ( std::endian::native == std::endian::big )
+                        w = std::byteswap( w );
+                    s += w;
+                }
+                total = fold32( fold32( total + fold32( s )));
+                p += k;
+                n -= k;
+            }
+            for ( usize i = 0; i < n; ++i )
+                total += u64{ p[i] } << ( 8 * ( i & 1 ));
+            return total;
+        }
+
+        void add( const u8* p, usize n ) noexcept
+        {
+            if ( n == 0 ) return;
+            if ( pos_ & 1 ) {
+                sum_ += u64{ *p } << 8;
+                ++p; --n; ++pos_;
+            }
+            sum_  = fold32( fold32( sum_ + sum_even( p, n )));
+            pos_ += n;
+        }
+
+    public:
+        using result_type = u32;
+
+        pe_checksum() noexcept = default;
+
+        // `field`: file offset of the CheckSum field (e_lfanew + 0x58)
+        explicit pe_checksum( u64 field ) noexcept : field_( field ) {}
+
+        // reads e_lfanew from the DOS header of a complete or partial image
+        [[nodiscard]] static auto for_image( std::span<const std::byte> head ) noexcept
+            -> std::expected<pe_checksum, std::errc>
+        {
+            if ( head.size() < 0x40 || head[0] != std::byte{ 'M' } || head[1] != std::byte{ 'Z' } )
+                return std::unexpected( std::errc::invalid_argument );
+
+            u32 lfanew;
+            std::memcpy( &lfanew, head.data() + 0x3C, 4 );
+            if constexpr ( std::endian::native == std::endian::big )
+                lfanew = std::byteswap( lfanew );
+
+            auto const field = u64{ lfanew } + 0x58;
+            if ( head.size() >= field - 0x54 && std::memcmp( head.data() + lfanew, "PE\0\0", 4 ) != 0 )
+                return std::unexpected( std::errc::invalid_argument );
+            return pe_checksum{ field };
+        }
+
+        pe_checksum& update( std::span<const std::byte> s ) noexcept
+        {
+            auto const* p   = rcast<const u8*>( s.data() );
+            auto const  end = pos_ + s.size();
+
+            // the CheckSum field reads as zero
+            if ( field_ < end && field_ + 4 > pos_ ) {
+                auto const lo = field_ > pos_ ? scast<usize>( field_ - pos_ ) : 0;
+                auto const hi = scast<usize>( std::min( field_ + 4, end ) - pos_ );
+                add( p, lo );
+                pos_ += hi - lo;
+                add( p + hi, s.size() - hi );
+            } else {
+                add( p, s.size() );
+            }
+            return *this;
+        }
+
+        [[nodiscard]] u32 finish() const noexcept
+        {
+            auto x = sum_;
+            while ( x >> 16 )
+                x = ( x & 0xFFFF ) + ( x >> 16 );
+            return scast<u32>( x + pos_ );
+        }
+
+        [[nodiscard]] u64 size() const noexcept { return pos_; }
+        void reset() noexcept { pos_ = 0; sum_ = 0; }
+
+        [[nodiscard]] pe_checksum fork( u64 at ) const noexcept
+        {
+            pe_checksum p{ field_ };
+            p.pos_ = at;
+            return p;
+        }
+
+        pe_checksum& append( const pe_checksum& part ) noexcept
+        {
+            sum_ = fold32( fold32( sum_ + part.sum_ ));
+            pos_ = part.pos_;
+            return *this;
+        }
+    };
+
+    // --- sha256 ---------------------------------------------------------------------
+
+    namespace details
+    {
+        alignas( 64 ) inline constexpr std::array<u32, 64> sha256_k{
+            0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+            0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+            0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+            0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+            0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+            0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+            0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+            0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+        };
+
+        inline void sha256_scalar( u32* st, const u8* p, usize blocks ) noexcept
+        {
+            auto be32 = []( const u8* q ) {
+                u32 v;
+                std::memcpy( &v, q, 4 );
+                return std::endian::native == std::endian::little ? std::byteswap( v ) : v;
+            };
+
+            for ( ; blocks; --blocks, p += 64 ) {
+                u32 w[64];
+                for ( usize i = 0; i < 16; ++i )
+                    w[i] = be32( p + 4 * i );
+                for ( usize i = 16; i < 64; ++i ) {
+                    auto const s0 = std::rotr( w[i - 15], 7 ) ^ std::rotr( w[i - 15], 18 ) ^ ( w[i - 15] >> 3 );
+                    auto const s1 = std::rotr( w[i - 2], 17 ) ^ std::rotr( w[i - 2], 19 ) ^ ( w[i - 2] >> 10 );
+                    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+                }
+
+                u32 a = st[0], b = st[1], c = st[2], d = st[3], e = st[4], f = st[5], g = st[6], h = st[7];
+                for ( usize i = 0; i < 64; ++i ) {
+                    auto const t1 = h + ( std::rotr( e, 6 ) ^ std::rotr( e, 11 ) ^ std::rotr( e, 25 ))
+                                  + (( e & f ) ^ ( ~e & g )) + sha256_k[i] + w[i];
+                    auto const t2 = ( std::rotr( a, 2 ) ^ std::rotr( a, 13 ) ^ std::rotr( a, 22 ))
+                                  + (( a & b ) ^ ( a & c ) ^ ( b & c ));
+                    h = g; g = f; f = e; e = d + t1;
+                    d = c; c = b; b = a; a = t1 + t2;
+                }
+                st[0] += a; st[1] += b; st[2] += c; st[3] += d;
+                st[4] += e; st[5] += f; st[6] += g; st[7] += h;
+            }
+        }
+
+    #if LBYTE_STX_DIGEST_SHA_X86
+        // four rounds; the message schedule runs three steps ahead
+        template<usize G>
+        STX_FORCE_INLINE void sha256_ni_step( __m128i& s0, __m128i& s1, __m128i ( &w )[4], const u8* p, __m128i bswap ) noexcept
+        {
+            if constexpr ( G < 4 )
+                w[G] = _mm_shuffle_epi8( _mm_loadu_si128( rcast<const __m128i*>( p + 16 * G )), bswap );
+
+            __m128i m = _mm_add_epi32( w[G % 4], _mm_load_si128( rcast<const __m128i*>( sha256_k.data() + 4 * G )));
+            s1 = _mm_sha256rnds2_epu32( s1, s0, m );
+            if constexpr ( G >= 3 && G <= 14 ) {
+                auto& next = w[( G + 1 ) % 4];
+                next = _mm_add_epi32( next, _mm_alignr_epi8( w[G % 4], w[( G + 3 ) % 4], 4 ));
+                next = _mm_sha256msg2_epu32( next, w[G % 4] );
+            }
+            m  = _mm_shuffle_epi32( m, 0x0E );
+            s0 = _mm_sha256rnds2_epu32( s0, s1, m );
+            if constexpr ( G >= 1 && G <= 12 )
+                w[( G + 3 ) % 4] = _mm_sha256msg1_epu32( w[( G + 3 ) % 4], w[G % 4] );
+        }
+
+        template<usize... G>
+        STX_FORCE_INLINE void sha256_ni_block( __m128i& s0, __m128i& s1, const u8* p, __m128i bswap, std::index_sequence<G...> ) noexcept
+        {
+            __m128i w[4];
+            ( sha256_ni_step<G>( s0, s1, w, p, bswap ), ... );
+        }
+
+        // Intel SHA extensions; state kept as ABEF / CDGH. sha256rnds2 has no VEX
+        // form, so AVX builds clear the ymm uppers first.
+        inline void sha256_ni( u32* st, const u8* p, usize blocks ) noexcept
+        {
+        #if defined(__AVX__)
+            _mm256_zeroupper();
+        #endif
+            __m128i const bswap = _mm_set_epi64x( 0x0C0D0E0F08090A0Bll, 0x0405060700010203ll );
+
+            __m128i t  = _mm_shuffle_epi32( _mm_loadu_si128( rcast<const __m128i*>( st )), 0xB1 );   // CDAB
+            __m128i s1 = _mm_shuffle_epi32( _mm_loadu_si128( rcast<const __m128i*>( st + 4 )), 0x1B ); // EFGH
+            __m128i s0 = _mm_alignr_epi8( t, s1, 8 );          // ABEF
+            s1 = _mm_blend_epi16( s1, t, 0xF0 );               // CDGH
+
+            for ( ; blocks; --blocks, p += 64 ) {
+                __m128i const abef = s0, cdgh = s1;
+                sha256_ni_block( s0, s1, p, bswap, std::make_index_sequence<16>{} );
+                s0 = _mm_add_epi32( s0, abef );
+                s1 = _mm_add_epi32( s1, cdgh );
+            }
+
+            t  = _mm_shuffle_epi32( s0, 0x1B );                // FEBA
+            s1 = _mm_shuffle_epi32( s1, 0xB1 );                // DCHG
+            s0 = _mm_blend_epi16( t, s1, 0xF0 );               // DCBA
+            s1 = _mm_alignr_epi8( s1, t, 8 );                  // HGFE
+            _mm_storeu_si128( rcast<__m128i*>( st ), s0 );
+            _mm_storeu_si128( rcast<__m128i*>( st + 4 ), s1 );
+        }
+    #endif
+
+    #if LBYTE_STX_DIGEST_SHA_ARM
+        template<usize G>
+        STX_FORCE_INLINE void sha256_ce_step( uint32x4_t& s0, uint32x4_t& s1, uint32x4_t ( &w )[4] ) noexcept
+        {
+            uint32x4_t const m = vaddq_u32( w[G % 4], vld1q_u32( sha256_k.data() + 4 * G ));
+            if constexpr ( G < 12 )
+                w[G % 4] = vsha256su1q_u32( vsha256su0q_u32( w[G % 4], w[( G + 1 ) % 4] ), w[( G + 2 ) % 4], w[( G + 3 ) % 4] );
+            uint32x4_t const prev = s0;
+            s0 = vsha256hq_u32( s0, s1, m );
+            s1 = vsha256h2q_u32( s1, prev, m );
+        }
+
+        template<usize... G>
+        STX_FORCE_INLINE void sha256_ce_block( uint32x4_t& s0, uint32x4_t& s1, const u8* p, std::index_sequence<G...> ) noexcept
+        {
+            uint32x4_t w[4];
+            for ( usize i = 0; i < 4; ++i )
+                w[i] = vreinterpretq_u32_u8( vrev32q_u8( vld1q_u8( p + 16 * i )));
+            ( sha256_ce_step<G>( s0, s1, w ), ... );
+        }
+
+        inline void sha256_ce( u32* st, const u8* p, usize blocks ) noexcept
+        {
+            uint32x4_t s0 = vld1q_u32( st ), s1 = vld1q_u32( st + 4 );
+
+            for ( ; blocks; --blocks, p += 64 ) {
+                uint32x4_t const abcd = s0, efgh = s1;
+                sha256_ce_block( s0, s1, p, std::make_index_sequence<16>{} );
+                s0 = vaddq_u32( s0, abcd );
+                s1 = vaddq_u32( s1, efgh );
+            }
+            vst1q_u32( st, s0 );
+            vst1q_u32( st + 4, s1 );
+        }
+    #endif
+
+        STX_FORCE_INLINE void sha256_blocks( u32* st, const u8* p, usize blocks ) noexcept
+        {
+        #if LBYTE_STX_DIGEST_SHA_X86
+            sha256_ni( st, p, blocks );
+        #elif LBYTE_STX_DIGEST_SHA_ARM
+            sha256_ce( st, p, blocks );
+        #else
+            sha256_scalar( st, p, blocks );
+        #endif
+        }
+    }
+
+    class sha256
+    {
+        static constexpr std::array<u32, 8> iv{
+            0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+        };
+
+        std::array<u32, 8> st_ = iv;
+        std::array<u8, 64> buf_{};
+        u64                len_ = 0;
+
+    public:
+        using result_type = std::array<u8, 32>;
+
+        sha256& update( std::span<const std::byte> s ) noexcept
+        {
+            if ( s.empty() ) return *this;
+
+            auto const* p = rcast<const u8*>( s.data() );
+            auto        n = s.size();
+            auto const  used = scast<usize>( len_ % 64 );
+            len_ += n;
+
+            if ( used ) {
+                auto const k = std::min( n, 64 - used );
+                std::memcpy( buf_.data() + used, p, k );
+                p += k; n -= k;
+                if ( used + k < 64 )
+                    return *this;
+                details::sha256_blocks( st_.data(), buf_.data(), 1 );
+            }
+            if ( n >= 64 ) {
+                details::sha256_blocks( st_.data(), p, n / 64 );
+                p += n & ~usize{ 63 };
+                n &= 63;
+            }
+            if ( n ) std::memcpy( buf_.data(), p, n );
+            return *this;
+        }
+
+        [[nodiscard]] result_type finish() const noexcept
+        {
+            auto st = st_;
+            std::array<u8, 128> tail{};
+            auto const used = scast<usize>( len_ % 64 );
+            std::memcpy( tail.data(), buf_.data(), used );
+            tail[used] = 0x80;
+
+            auto const total = used < 56 ? usize{ 64 } : usize{ 128 };
+            auto const bits  = len_ * 8;
+            for ( usize i = 0; i < 8; ++i )
+                tail[total - 1 - i] = scast<u8>( bits >> ( 8 * i ));
+            details::sha256_blocks( st.data(), tail.data(), total / 64 );
+
+            result_type out;
+            for ( usize i = 0; i < 8; ++i )
+                for ( usize k = 0; k < 4; ++k )
+                    out[4 * i + k] = scast<u8>( st[i] >> ( 24 - 8 * k ));
+            return out;
+        }
+
+        [[nodiscard]] u64 size() const noexcept { return len_; }
+        void reset() noexcept { st_ = iv; len_ = 0; }
+    };
+
+    // --- one-shot / parallel / tree ----------------------------------------------
+
+    template<engine E>
+    [[nodiscard]] auto compute( std::span<const std::byte> data, E e = {} ) -> typename E::result_type
+    {
+        return e.update( data ).finish();
+    }
+
+    // Chunked multi-core mode; chunk sizes are rounded up to whole pages so every
+    // split is at an even offset.
+    struct parallel
+    {
+        usize      chunk_size = usize{ 16 } << 20;
+        usize      threads    = 0;          // max participants, 0 = whole pool
+        par::pool* pool       = nullptr;    // nullptr = par::pool::shared()
+    };
+
+    namespace details
+    {
+        inline constexpr usize page_size = 4096;
+
+        [[nodiscard]] inline usize chunk_of( const parallel& opt ) noexcept
+        {
+            return ( std::max( opt.chunk_size, page_size ) + page_size - 1 ) / page_size * page_size;
+        }
+
+        // digest bytes fed to a tree root: integers little-endian, arrays as is
+        template<typename R>
+        void put_result( std::vector<std::byte>& out, const R& r )
+        {
+            if constexpr ( std::unsigned_integral<R> ) {
+                for ( usize i = 0; i < sizeof( R ); ++i )
+                    out.push_back( scast<std::byte>( r >> ( 8 * i )));
+            } else {
+                auto const b = std::as_bytes( std::span{ r });
+                out.insert( out.end(), b.begin(), b.end() );
+            }
+        }
+    }
+
+    // same value as compute(data, proto), one chunk per pool task
+    template<mergeable E>
+    [[nodiscard]] auto compute( std::span<const std::byte> data, const parallel& opt, E proto = {} )
+        -> typename E::result_type
+    {
+        auto const chunk = details::chunk_of( opt );
+        auto const count = ( data.size() + chunk - 1 ) / chunk;
+        if ( count <= 1 )
+            return proto.update( data ).finish();
+
+        std::vector<E> parts;
+        parts.reserve( count );
+        for ( usize k = 0; k < count; ++k )
+            parts.push_back( proto.fork( k * chunk ));
+
+        auto& workers = opt.pool ? *opt.pool : par::pool::shared();
+        workers.run( count, [&]( usize k ) {
+            auto const begin = k * chunk;
+            parts[k].update( data.subspan( begin, std::min( chunk, data.size() - begin )));
+        }, opt.threads );
+
+        for ( auto const& p : parts )
+            proto.append( p );
+        return proto.finish();
+    }
+
+    // Tree mode for digests that cannot be split (sha256): E over the
+    // concatenated digests of chunk_size leaves. A different value from
+    // compute(data); both sides of a comparison must use the same chunk_size.
+    template<engine E>
+    [[nodiscard]] auto tree( std::span<const std::byte> data, const parallel& opt ) -> typename E::result_type
+    {
+        auto const chunk = details::chunk_of( opt );
+        auto const count = std::max<usize>( 1, ( data.size() + chunk - 1 ) / chunk );
+
+        std::vector<typename E::result_type> leaves( count );
+        auto& workers = opt.pool ? *opt.pool : par::pool::shared();
+        workers.run( count, [&]( usize k ) {
+            auto const begin = std::min( k * chunk, data.size() );
+            leaves[k] = compute<E>( data.subspan( begin, std::min( chunk, data.size() - begin )));
+        }, opt.threads );
+
+        std::vector<std::byte> cat;
+        for ( auto const& l : leaves )
+            details::put_result( cat, l );
+        return compute<E>( cat );
+    }
+
+    // --- streams -----------------------------------------------------------------
+
+    // feeds `src` to `e` until end of stream; returns the bytes consumed
+    template<engine E, io::byte_source S>
+    auto feed( E& e, S& src, usize block = usize{ 1 } << 20 ) -> std::expected<u64, std::errc>
+    {
+        auto buf = std::make_unique_for_overwrite<std::byte[]>( block );
+        u64 total = 0;
+        for (;;) {
+            auto n = src.read( std::span<std::byte>{ buf.get(), block });
+            if ( !n ) [[unlikely]] return std::unexpected( n.error() );
+            if ( *n == 0 ) return total;
+            e.update( std::span<const std::byte>{ buf.get(), *n });
+            total += *n;
+        }
+    }
+
+    // --- PE image helpers ----------------------------------------------------------
+
+    [[nodiscard]] inline auto pe_checksum_of( std::span<const std::byte> image ) -> std::expected<u32, std::errc>
+    {
+        auto e = pe_checksum::for_image( image );
+        if ( !e ) return std::unexpected( e.error() );
+        return e->update( image ).finish();
+    }
+
+    [[nodiscard]] inline auto pe_checksum_of( std::span<const std::byte> image, const parallel& opt )
+        -> std::expected<u32, std::errc>
+    {
+        auto e = pe_checksum::for_image( image );
+        if ( !e ) return std::unexpected( e.error() );
+        return compute( image, opt, *e );
+    }
+
+    // lowercase hex of a byte digest
+    template<usize N>
+    [[nodiscard]] std::string to_hex( const std::array<u8, N>& d )
+    {
+        constexpr char digits[] = "0123456789abcdef";
+        std::string s( 2 * N, '\0' );
+        for ( usize i = 0; i < N; ++i ) {
+            s[2 * i]     = digits[d[i] >> 4];
+            s[2 * i + 1] = digits[d[i] & 15];
+        }
+        return s;
+    }
+}
+
+#undef STX_FORCE_INLINE
@@ -1,10 +1,13 @@
 #pragma once
 #include "core.hpp"
+#include "simd.hpp"
 
 #include <bit>
 #include <compare>
+#include <cstring>
 #include <functional>
 #include <iosfwd>
+#include <span>
 #include <type_traits>
 
 namespace lbyte::stx::endian
@@ -232,6 +235,99 @@ namespace lbyte::stx::endian
     template<typename T>
     constexpr bool is_endian_value_v = details::is_endian_value_impl<std::remove_cvref_t<T>>::value;
 
+    // --- bulk conversion --------------------------------------------------------
+    // Byte-shuffle kernels (pshufb / vrev, see simd::bswap) over whole spans;
+    // 2/4/8-byte elements are vectorized, others fall back to std::byteswap.
+
+    namespace details
+    {
+        template<usize W>
+        inline void swap_n( const u8* src, u8* dst, usize count ) noexcept
+        {
+            usize i = 0;
+            auto const bytes = count * W;
+
+            if constexpr ( W == 2 || W == 4 || W == 8 ) {
+                if constexpr ( simd::native != simd::isa::scalar ) {
+                    for ( ; i + simd::lanes <= bytes; i += simd::lanes )
+                        simd::bswap<W>( src + i, dst + i );
+                }
+
+                using U = std::conditional_t<W == 2, u16, std::conditional_t<W == 4, u32, u64>>;
+                for ( ; i < bytes; i += W ) {
+                    U v;
+                    std::memcpy( &v, src + i, W );
+                    v = std::byteswap( v );
+                    std::memcpy( dst + i, &v, W );
+                }
+            } else {
+                for ( ; i < bytes; i += W ) {
+                    u8 tmp[W];
+                    for ( usize k = 0; k < W; ++k )
+                        tmp[k] = src[i + W - 1 - k];
+                    std::memcpy( dst + i, tmp, W );
+                }
+            }
+        }
+
+        template<compatible T>
+        inline void swap_span( const T* src, T* dst, usize count ) noexcept
+        {
+            if ( count == 0 )
+                return;
+            if constexpr ( sizeof(T) > 1 )
+                swap_n<sizeof(T)>( rcast<const u8*>( src ), rcast<u8*>( dst ), count );
+            else if ( src != dst )
+                std::memmove( dst, src, count );
+        }
+    }
+
+    // Reverse the bytes of every element, in place.
+    template<compatible T>
+    inline void convert_endian( std::span<T> data ) noexcept
+    {
+        details::swap_span( data.data(), data.data(), data.size() );
+    }
+
+    // out[i] = byteswap(in[i]); `out` must hold in.size() elements and either
+    // not overlap `in` or be exactly `in`.
+    template<compatible T>
+    inline void convert_endian( std::span<const T> in, std::span<T> out ) noexcept
+    {
+        details::swap_span( in.data(), out.data(), in.size() );
+    }
+
+    // Reinterpret `data` as stored in `Order` and convert it to native, in place.
+    template<order Order, compatible T>
+    inline void to_native( std::span<T> data ) noexcept
+    {
+        if constexpr ( endian_value<T, Order>::needs_swap )
+            convert_endian( data );
+    }
+
+    // Decode a whole endian_value array into native values.
+    template<compatible T, order Order>
+    inline void decode( std::span<const endian_value<T, Order>> in, std::span<T> out ) noexcept
+    {
+        static_assert( sizeof(endian_value<T, Order>) == sizeof(T) );
+        auto const* src = rcast<const T*>( in.data() );
+        if constexpr ( endian_value<T, Order>::needs_swap )
+            details::swap_span( src, out.data(), in.size() );
+        else if ( !in.empty() )
+            std::memmove( out.data(), src, in.size_bytes() );
+    }
+
+    // Encode native values into an endian_value array.
+    template<compatible T, order Order>
+    inline void encode( std::span<const T> in, std::span<endian_value<T, Order>> out ) noexcept
+    {
+        auto* dst = rcast<T*>( out.data() );
+        if constexpr ( endian_value<T, Order>::needs_swap )
+            details::swap_span( in.data(), dst, in.size() );
+        else if ( !in.empty() )
+            std::memmove( dst, in.data(), in.size_bytes() );
+    }
+
 } // namespace lbyte::stx::endian
 
 // --- std::hash --------------------------------------------------------------------
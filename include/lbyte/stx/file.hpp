@@ -0,0 +1,191 @@
+#pragma once
+#include "./core.hpp"
+#include "./io_base.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace lbyte::stx::io
+{
+    // --- file (positional descriptor) -------------------------------------------
+    // Thin RAII owner of an OS file handle. Every read/write names its own offset,
+    // so one `file` can be shared across threads without a seek position.
+
+    enum class file_mode : u8
+    {
+        read       = 0,
+        read_write ,
+        create     ,  // read_write, created if missing
+    };
+
+    namespace details
+    {
+        // one kernel transfer is capped so lengths fit the 32-bit fields
+        inline constexpr usize max_xfer = usize{ 1 } << 30;
+    }
+
+    class file
+    {
+    public:
+        #if defined(_WIN32)
+            using native_type = void*;  // HANDLE
+            static inline native_type const invalid = reinterpret_cast<void*>(intptr_t(-1));
+        #else
+            using native_type = int;
+            static constexpr native_type invalid = -1;
+        #endif
+
+    private:
+        native_type h_ = invalid;
+
+        explicit file(native_type h) noexcept : h_(h) {}
+
+        auto close() noexcept -> void;
+
+    public:
+        file() noexcept = default;
+
+        file(file&& other) noexcept : h_(std::exchange(other.h_, invalid)) {}
+
+        auto operator=(file&& other) noexcept -> file&
+        {
+            if (this != &other) {
+                close();
+                h_ = std::exchange(other.h_, invalid);
+            }
+            return *this;
+        }
+
+        file(const file&) = delete;
+        auto operator=(const file&) -> file& = delete;
+
+        ~file() noexcept { close(); }
+
+        // --- factory -------------------------------------------------------
+
+        static auto open(const std::filesystem::path& path, file_mode mode = file_mode::read) noexcept
+            -> std::expected<file, std::errc>;
+
+        // --- state ---------------------------------------------------------
+
+        explicit operator bool() const noexcept { return h_ != invalid; }
+        native_type native_handle() const noexcept { return h_; }
+
+        auto size() const noexcept -> std::expected<usize, std::errc>;
+
+        // --- positional I/O ------------------------------------------------
+        // Loops over short transfers; a read returns fewer bytes than asked
+        // only at end of file.
+
+        auto read_at(off_s offset, std::span<std::byte> out) const noexcept
+            -> std::expected<usize, std::errc>;
+
+        auto write_at(off_s offset, std::span<const std::byte> in) const noexcept
+            -> std::expected<usize, std::errc>;
+
+        // --- vectored I/O --------------------------------------------------
+        // Scatter / gather over buffers laid out back to back from `offset`:
+        // preadv / pwritev, up to 64 buffers per call, same short-transfer
+        // rules as above. Windows loops over ReadFile / WriteFile (its gather
+        // calls need page-aligned unbuffered handles).
+
+        auto read_at(off_s offset, std::span<const std::span<std::byte>> out) const noexcept
+            -> std::expected<usize, std::errc>;
+
+        auto write_at(off_s offset, std::span<const std::span<const std::byte>> in) const noexcept
+            -> std::expected<usize, std::errc>;
+    };
+
+    // --- batched reads ----------------------------------------------------------
+    // All requests of a batch are submitted together (io_uring on Linux,
+    // overlapped I/O on Windows) and complete in any order; results are reported
+    // per request, in request order. Falls back to positional reads when the
+    // kernel has no io_uring or it is disabled.
+
+    struct read_req
+    {
+        off_s                offset;
+        std::span<std::byte> out;
+    };
+
+    using read_result = std::expected<usize, std::errc>;
+
+    // requests kept in flight at once
+    inline constexpr u32 batch_depth = 64;
+
+    [[nodiscard]]
+    auto read(const file& f, std::span<const read_req> reqs) -> std::vector<read_result>;
+
+    // --- batched writes ---------------------------------------------------------
+    // Requests are written in order; each run whose offsets follow on from the
+    // previous request goes out as one vectored write, so a serializer can emit
+    // headers, tables and padding as separate spans without a staging buffer.
+    // Returns the bytes written; stops at the first error.
+
+    struct write_req
+    {
+        off_s                      offset;
+        std::span<const std::byte> in;
+    };
+
+    [[nodiscard]]
+    auto write(const file& f, std::span<const write_req> reqs) -> std::expected<usize, std::errc>;
+
+    // --- typed positional reads (mirror the istream overloads) -----------------
+
+    template<binary_readable Type> [[nodiscard]]
+    std::expected<Type, std::errc> read(const file& f, const off_s offset) noexcept
+    {
+        Type value;
+        auto n = f.read_at(offset, std::as_writable_bytes(std::span{ &value, 1 }));
+        if (!n) [[unlikely]]
+            return std::unexpected(n.error());
+        if (*n != sizeof(Type)) [[unlikely]]
+            return std::unexpected(std::errc::io_error);
+        return value;
+    }
+
+    template<binary_readable Type>
+    std::expected<void, std::errc> read(const file& f, std::span<Type> out_buffer, const off_s offset) noexcept
+    {
+        auto n = f.read_at(offset, std::as_writable_bytes(out_buffer));
+        if (!n) [[unlikely]]
+            return std::unexpected(n.error());
+        if (*n != out_buffer.size_bytes()) [[unlikely]]
+            return std::unexpected(std::errc::io_error);
+        return {};
+    }
+
+    template<binary_readable Type = u8> [[nodiscard]]
+    std::expected<dirty_vector<Type>, std::errc> read(const file& f, const off_s offset, const usize count)
+    {
+        dirty_vector<Type> vec(count);
+        auto result = read<Type>(f, std::span<Type>{ vec }, offset);
+        if (!result) [[unlikely]]
+            return std::unexpected(result.error());
+        return vec;
+    }
+
+    template<binary_readable Type = u8, ::lbyte::stx::details::allocator_like Alloc> [[nodiscard]]
+    std::expected<dirty_vector<Type, Alloc>, std::errc> read(const file& f, const off_s offset, const usize count, const Alloc& alloc)
+    {
+        dirty_vector<Type, Alloc> vec(count, alloc);
+        auto result = read<Type>(f, std::span<Type>{ vec }, offset);
+        if (!result) [[unlikely]]
+            return std::unexpected(result.error());
+        return vec;
+    }
+}
+
+#if !LBYTE_STX_COMPILED
+    #include "./file_platform.hpp"
+#endif
@@ -0,0 +1,678 @@
+#pragma once
+#include "./file.hpp"
+#include "./stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#if !defined(_WIN32)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+    #if defined(__linux__) && __has_include(<linux/io_uring.h>)
+        #include <linux/io_uring.h>
+        #include <sys/syscall.h>
+        #define LBYTE_STX_HAS_IO_URING 1
+    #endif
+#else
+    #if !defined(NOMINMAX)
+        #define NOMINMAX
+    #endif
+    #if !defined(WIN32_LEAN_AND_MEAN)
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#endif
+
+#if !defined(LBYTE_STX_HAS_IO_URING)
+    #define LBYTE_STX_HAS_IO_URING 0
+#endif
+
+// Defined empty by src/stx/platform.cpp, the one TU that owns these bodies
+// when the library is compiled.
+#if !defined(LBYTE_STX_PLATFORM_INLINE)
+    #define LBYTE_STX_PLATFORM_INLINE inline
+#endif
+
+namespace lbyte::stx::io
+{
+    // --- platform ---------------------------------------------------------------
+
+    namespace details
+    {
+        LBYTE_STX_PLATFORM_INLINE auto sync_read(const file& f, const read_req& r) noexcept -> read_result
+        {
+            return f.read_at(r.offset, r.out);
+        }
+    }
+
+    LBYTE_STX_PLATFORM_INLINE auto write(const file& f, std::span<const write_req> reqs) -> std::expected<usize, std::errc>
+    {
+        std::vector<std::span<const std::byte>> run;
+        usize done = 0;
+
+        for (usize i = 0; i < reqs.size();) {
+            auto const at = reqs[i].offset;
+            auto       end = at.get();
+            run.clear();
+            for (; i < reqs.size() && reqs[i].offset.get() == end; ++i) {
+                run.push_back(reqs[i].in);
+                end += static_cast<off_s::value_type>(reqs[i].in.size());
+            }
+
+            auto n = f.write_at(at, std::span<const std::span<const std::byte>>{ run });
+            if (!n) [[unlikely]]
+                return std::unexpected(n.error());
+            done += *n;
+        }
+        return done;
+    }
+
+    #if defined(_WIN32)
+
+        LBYTE_STX_PLATFORM_INLINE auto file::open(const std::filesystem::path& path, file_mode mode) noexcept
+            -> std::expected<file, std::errc>
+        {
+            DWORD access      = GENERIC_READ;
+            DWORD disposition = OPEN_EXISTING;
+            if (mode != file_mode::read)   access     |= GENERIC_WRITE;
+            if (mode == file_mode::create) disposition = OPEN_ALWAYS;
+
+            HANDLE h = CreateFileW(
+                path.c_str(),
+                access,
+                FILE_SHARE_READ | FILE_SHARE_WRITE,
+                nullptr,
+                disposition,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED,
+                nullptr
+            );
+            if (h == INVALID_HANDLE_VALUE)
+                return std::unexpected(std::errc::no_such_file_or_directory);
+            return file(h);
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::close() noexcept -> void
+        {
+            if (h_ != invalid) CloseHandle(std::exchange(h_, invalid));
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::size() const noexcept -> std::expected<usize, std::errc>
+        {
+            LARGE_INTEGER sz;
+            if (!GetFileSizeEx(h_, &sz))
+                return std::unexpected(std::errc::io_error);
+            return static_cast<usize>(sz.QuadPart);
+        }
+
+        namespace details
+        {
+            LBYTE_STX_PLATFORM_INLINE void set_offset(OVERLAPPED& ov, u64 off) noexcept
+            {
+                ov.Offset     = static_cast<DWORD>(off & 0xFFFFFFFF);
+                ov.OffsetHigh = static_cast<DWORD>(off >> 32);
+            }
+
+            // issue one transfer and wait for it (handle is opened overlapped)
+            template<bool Write>
+            auto xfer(HANDLE h, u64 off, void* buf, usize len) noexcept -> std::expected<usize, std::errc>
+            {
+                OVERLAPPED ov{};
+                set_offset(ov, off);
+                ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+                if (!ov.hEvent)
+                    return std::unexpected(std::errc::io_error);
+
+                DWORD const want = static_cast<DWORD>(std::min(len, max_xfer));
+                BOOL  ok;
+                if constexpr (Write) ok = WriteFile(h, buf, want, nullptr, &ov);
+                else                 ok = ReadFile (h, buf, want, nullptr, &ov);
+
+                DWORD got = 0;
+                if (!ok && GetLastError() != ERROR_IO_PENDING) {
+                    auto const err = GetLastError();
+                    CloseHandle(ov.hEvent);
+                    if (!Write && err == ERROR_HANDLE_EOF) return usize{ 0 };
+                    return std::unexpected(std::errc::io_error);
+                }
+                if (!GetOverlappedResult(h, &ov, &got, TRUE)) {
+                    auto const err = GetLastError();
+                    CloseHandle(ov.hEvent);
+                    if (!Write && err == ERROR_HANDLE_EOF) return usize{ 0 };
+                    return std::unexpected(std::errc::io_error);
+                }
+                CloseHandle(ov.hEvent);
+                return static_cast<usize>(got);
+            }
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::read_at(off_s offset, std::span<std::byte> out) const noexcept
+            -> std::expected<usize, std::errc>
+        {
+            if (offset.get() < 0)
+                return std::unexpected(std::errc::invalid_argument);
+
+            usize done = 0;
+            auto const base = static_cast<u64>(offset.get());
+            while (done < out.size()) {
+                auto n = details::xfer<false>(h_, base + done, out.data() + done, out.size() - done);
+                if (!n) {
+                    stats::on_read(out.size(), done, true);
+                    return std::unexpected(n.error());
+                }
+                if (*n == 0) break;
+                done += *n;
+            }
+            stats::on_read(out.size(), done, false);
+            return done;
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::write_at(off_s offset, std::span<const std::byte> in) const noexcept
+            -> std::expected<usize, std::errc>
+        {
+            if (offset.get() < 0)
+                return std::unexpected(std::errc::invalid_argument);
+
+            usize done = 0;
+            auto const base = static_cast<u64>(offset.get());
+            while (done < in.size()) {
+                auto n = details::xfer<true>(h_, base + done, const_cast<std::byte*>(in.data()) + done, in.size() - done);
+                if (!n || *n == 0) {
+                    stats::on_write(in.size(), done, true);
+                    return std::unexpected(n ? std::errc::io_error : n.error());
+                }
+                done += *n;
+            }
+            stats::on_write(in.size(), done, false);
+            return done;
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::read_at(off_s offset, std::span<const std::span<std::byte>> out) const noexcept
+            -> std::expected<usize, std::errc>
+        {
+            usize done = 0;
+            for (auto const& b : out) {
+                auto n = read_at(offset + off_s{ static_cast<off_s::value_type>(done) }, b);
+                if (!n) return std::unexpected(n.error());
+                done += *n;
+                if (*n < b.size()) break;
+            }
+            return done;
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::write_at(off_s offset, std::span<const std::span<const std::byte>> in) const noexcept
+            -> std::expected<usize, std::errc>
+        {
+            usize done = 0;
+            for (auto const& b : in) {
+                auto n = write_at(offset + off_s{ static_cast<off_s::value_type>(done) }, b);
+                if (!n) return std::unexpected(n.error());
+                done += *n;
+            }
+            return done;
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto read(const file& f, std::span<const read_req> reqs) -> std::vector<read_result>
+        {
+            std::vector<read_result> out(reqs.size(), read_result{ usize{ 0 } });
+
+            struct slot { OVERLAPPED ov{}; usize idx = 0; bool live = false; };
+            std::vector<slot> slots(std::min<usize>(batch_depth, reqs.size()));
+            for (auto& s : slots)
+                s.ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+            auto finish = [&](slot& s) {
+                DWORD got = 0;
+                auto const& r = reqs[s.idx];
+                if (GetOverlappedResult(f.native_handle(), &s.ov, &got, TRUE)) {
+                    // short but non-empty transfer: complete the remainder synchronously
+                    if (got != 0 && got < r.out.size()) {
+                        auto rest = f.read_at(r.offset + off_s{ static_cast<off_s::value_type>(got) }, r.out.subspan(got));
+                        out[s.idx] = rest ? read_result{ got + *rest } : read_result{ std::unexpected(rest.error()) };
+                    } else {
+                        out[s.idx] = static_cast<usize>(got);
+                    }
+                } else if (GetLastError() != ERROR_HANDLE_EOF) {
+                    out[s.idx] = std::unexpected(std::errc::io_error);
+                }
+                s.live = false;
+            };
+
+            usize next = 0, k = 0;
+            while (next < reqs.size()) {
+                auto& s = slots[k];
+                k = (k + 1) % slots.size();
+                if (s.live) finish(s);
+
+                auto const& r = reqs[next];
+                if (r.offset.get() < 0 || !s.ov.hEvent || r.out.size() > details::max_xfer) {
+                    out[next] = details::sync_read(f, r);
+                    ++next;
+                    continue;
+                }
+
+                ResetEvent(s.ov.hEvent);
+                details::set_offset(s.ov, static_cast<u64>(r.offset.get()));
+                s.idx = next++;
+                if (!ReadFile(f.native_handle(), r.out.data(), static_cast<DWORD>(r.out.size()), nullptr, &s.ov)) {
+                    auto const err = GetLastError();
+                    if (err != ERROR_IO_PENDING) {
+                        if (err != ERROR_HANDLE_EOF) out[s.idx] = std::unexpected(std::errc::io_error);
+                        continue;
+                    }
+                }
+                s.live = true;
+            }
+
+            for (auto& s : slots) {
+                if (s.live) finish(s);
+                if (s.ov.hEvent) CloseHandle(s.ov.hEvent);
+            }
+            return out;
+        }
+
+    #else // Linux / POSIX
+
+        LBYTE_STX_PLATFORM_INLINE auto file::open(const std::filesystem::path& path, file_mode mode) noexcept
+            -> std::expected<file, std::errc>
+        {
+            int oflags = O_RDONLY | O_CLOEXEC;
+            if (mode == file_mode::read_write) oflags = O_RDWR | O_CLOEXEC;
+            if (mode == file_mode::create)     oflags = O_RDWR | O_CREAT | O_CLOEXEC;
+
+            int fd = ::open(path.c_str(), oflags, 0644);
+            if (fd < 0)
+                return std::unexpected(static_cast<std::errc>(errno));
+            return file(fd);
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::close() noexcept -> void
+        {
+            if (h_ != invalid) ::close(std::exchange(h_, invalid));
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::size() const noexcept -> std::expected<usize, std::errc>
+        {
+            struct stat st;
+            if (::fstat(h_, &st) < 0)
+                return std::unexpected(std::errc::io_error);
+            return static_cast<usize>(st.st_size);
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::read_at(off_s offset, std::span<std::byte> out) const noexcept
+            -> std::expected<usize, std::errc>
+        {
+            if (offset.get() < 0)
+                return std::unexpected(std::errc::invalid_argument);
+
+            usize done = 0;
+            while (done < out.size()) {
+                auto const want = std::min(out.size() - done, details::max_xfer);
+                auto const n = ::pread(h_, out.data() + done, want, static_cast<off_t>(offset.get() + static_cast<off_s::value_type>(done)));
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    auto const err = errno;
+                    stats::on_read(out.size(), done, true);
+                    return std::unexpected(static_cast<std::errc>(err));
+                }
+                if (n == 0) break;
+                done += static_cast<usize>(n);
+            }
+            stats::on_read(out.size(), done, false);
+            return done;
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::write_at(off_s offset, std::span<const std::byte> in) const noexcept
+            -> std::expected<usize, std::errc>
+        {
+            if (offset.get() < 0)
+                return std::unexpected(std::errc::invalid_argument);
+
+            usize done = 0;
+            while (done < in.size()) {
+                auto const want = std::min(in.size() - done, details::max_xfer);
+                auto const n = ::pwrite(h_, in.data() + done, want, static_cast<off_t>(offset.get() + static_cast<off_s::value_type>(done)));
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    auto const err = errno;
+                    stats::on_write(in.size(), done, true);
+                    return std::unexpected(static_cast<std::errc>(err));
+                }
+                if (n == 0) {   // no progress; retrying would spin forever
+                    stats::on_write(in.size(), done, true);
+                    return std::unexpected(std::errc::io_error);
+                }
+                done += static_cast<usize>(n);
+            }
+            stats::on_write(in.size(), done, false);
+            return done;
+        }
+
+        namespace details
+        {
+            // preadv / pwritev over `bufs` from `offset`, resuming after short
+            // transfers; `read` stops at end of file
+            template<bool Read, typename Span>
+            auto vectored(int fd, off_s offset, std::span<const Span> bufs) noexcept
+                -> std::expected<usize, std::errc>
+            {
+                if (offset.get() < 0)
+                    return std::unexpected(std::errc::invalid_argument);
+
+                std::array<iovec, 64> iov;
+                usize done = 0, i = 0, skip = 0;   // buffer i, `skip` bytes of it already moved
+
+                for (;;) {
+                    while (i < bufs.size() && bufs[i].size() == skip) { ++i; skip = 0; }
+                    if (i == bufs.size()) break;
+
+                    int cnt = 0;
+                    for (usize j = i; j < bufs.size() && cnt < static_cast<int>(iov.size()); ++j) {
+                        auto const from = j == i ? skip : 0;
+                        if (bufs[j].size() == from) continue;
+                        iov[cnt++] = { const_cast<std::byte*>(bufs[j].data()) + from, bufs[j].size() - from };
+                    }
+
+                    auto const pos = static_cast<off_t>(offset.get() + static_cast<off_s::value_type>(done));
+                    auto const n   = Read ? ::preadv(fd, iov.data(), cnt, pos) : ::pwritev(fd, iov.data(), cnt, pos);
+                    if (n < 0) {
+                        if (errno == EINTR) continue;
+                        return std::unexpected(static_cast<std::errc>(errno));
+                    }
+                    if (n == 0) {
+                        if constexpr (Read) break;
+                        else return std::unexpected(std::errc::io_error);   // write made no progress
+                    }
+
+                    done += static_cast<usize>(n);
+                    for (auto left = static_cast<usize>(n); left != 0;) {
+                        auto const rem = bufs[i].size() - skip;
+                        if (left < rem) { skip += left; break; }
+                        left -= rem; ++i; skip = 0;
+                    }
+                }
+                return done;
+            }
+
+            template<typename Span>
+            auto total_size(std::span<const Span> bufs) noexcept -> usize
+            {
+                usize n = 0;
+                for (auto const& b : bufs) n += b.size();
+                return n;
+            }
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::read_at(off_s offset, std::span<const std::span<std::byte>> out) const noexcept
+            -> std::expected<usize, std::errc>
+        {
+            auto const want = details::total_size(out);
+            auto n = details::vectored<true>(h_, offset, out);
+            stats::on_read(want, n.value_or(0), !n);
+            return n;
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto file::write_at(off_s offset, std::span<const std::span<const std::byte>> in) const noexcept
+            -> std::expected<usize, std::errc>
+        {
+            auto const want = details::total_size(in);
+            auto n = details::vectored<false>(h_, offset, in);
+            stats::on_write(want, n.value_or(0), !n);
+            return n;
+        }
+
+        #if LBYTE_STX_HAS_IO_URING
+
+        namespace details
+        {
+            // --- uring (minimal raw-syscall io_uring, one per thread) ----------
+
+            class uring
+            {
+                int            fd_ = -1;
+                void*          sq_ptr_ = nullptr;
+                usize          sq_sz_  = 0;
+                void*          cq_ptr_ = nullptr;
+                usize          cq_sz_  = 0;
+                io_uring_sqe*  sqes_   = nullptr;
+                usize          sqes_sz_ = 0;
+
+                unsigned*      sq_head_ = nullptr;
+                unsigned*      sq_tail_ = nullptr;
+                unsigned*      sq_array_ = nullptr;
+                unsigned       sq_mask_ = 0;
+                unsigned       sq_entries_ = 0;
+
+                unsigned*      cq_head_ = nullptr;
+                unsigned*      cq_tail_ = nullptr;
+                io_uring_cqe*  cqes_    = nullptr;
+                unsigned       cq_mask_ = 0;
+                unsigned       depth_   = 0;
+
+                static unsigned load(unsigned* p) noexcept
+                {
+                    return std::atomic_ref<unsigned>{ *p }.load(std::memory_order_acquire);
+                }
+
+                static void store(unsigned* p, unsigned v) noexcept
+                {
+                    std::atomic_ref<unsigned>{ *p }.store(v, std::memory_order_release);
+                }
+
+                void teardown() noexcept
+                {
+                    if (sqes_)                       ::munmap(sqes_, sqes_sz_);
+                    if (cq_ptr_ && cq_ptr_ != sq_ptr_) ::munmap(cq_ptr_, cq_sz_);
+                    if (sq_ptr_)                     ::munmap(sq_ptr_, sq_sz_);
+                    if (fd_ >= 0)                    ::close(fd_);
+                    fd_ = -1; sq_ptr_ = cq_ptr_ = nullptr; sqes_ = nullptr;
+                }
+
+                void open(unsigned depth) noexcept
+                {
+                    io_uring_params p{};
+                    fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, depth, &p));
+                    if (fd_ < 0) return;
+
+                    sq_sz_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+                    cq_sz_ = p.cq_off.cqes  + p.cq_entries * sizeof(io_uring_cqe);
+                    bool const single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                    if (single) sq_sz_ = cq_sz_ = std::max(sq_sz_, cq_sz_);
+
+                    sq_ptr_ = ::mmap(nullptr, sq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+                    if (sq_ptr_ == MAP_FAILED) { sq_ptr_ = nullptr; teardown(); return; }
+
+                    cq_ptr_ = single ? sq_ptr_
+                                     : ::mmap(nullptr, cq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+                    if (cq_ptr_ == MAP_FAILED) { cq_ptr_ = nullptr; teardown(); return; }
+
+                    sqes_sz_ = p.sq_entries * sizeof(io_uring_sqe);
+                    void* s  = ::mmap(nullptr, sqes_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+                    if (s == MAP_FAILED) { teardown(); return; }
+                    sqes_ = static_cast<io_uring_sqe*>(s);
+
+                    auto* sq = static_cast<u8*>(sq_ptr_);
+                    auto* cq = static_cast<u8*>(cq_ptr_);
+                    sq_head_    = rcast<unsigned*>(sq + p.sq_off.head);
+                    sq_tail_    = rcast<unsigned*>(sq + p.sq_off.tail);
+                    sq_array_   = rcast<unsigned*>(sq + p.sq_off.array);
+                    sq_mask_    = *rcast<unsigned*>(sq + p.sq_off.ring_mask);
+                    sq_entries_ = *rcast<unsigned*>(sq + p.sq_off.ring_entries);
+                    cq_head_    = rcast<unsigned*>(cq + p.cq_off.head);
+                    cq_tail_    = rcast<unsigned*>(cq + p.cq_off.tail);
+                    cqes_       = rcast<io_uring_cqe*>(cq + p.cq_off.cqes);
+                    cq_mask_    = *rcast<unsigned*>(cq + p.cq_off.ring_mask);
+                }
+
+            public:
+                explicit uring(unsigned depth) noexcept : depth_(depth) { open(depth); }
+
+                uring(const uring&) = delete;
+                auto operator=(const uring&) -> uring& = delete;
+
+                ~uring() noexcept { teardown(); }
+
+                explicit operator bool() const noexcept { return sqes_ != nullptr; }
+                unsigned capacity() const noexcept { return sq_entries_; }
+
+                // queue a read; caller keeps in-flight count <= capacity()
+                void push_read(int fd, u64 off, void* buf, u32 len, u64 tag) noexcept
+                {
+                    auto const tail = *sq_tail_;
+                    auto const idx  = tail & sq_mask_;
+                    auto& sqe = sqes_[idx];
+                    std::memset(&sqe, 0, sizeof(sqe));
+                    sqe.opcode    = IORING_OP_READ;
+                    sqe.fd        = fd;
+                    sqe.off       = off;
+                    sqe.addr      = rcast<u64>(buf);
+                    sqe.len       = len;
+                    sqe.user_data = tag;
+                    sq_array_[idx] = idx;
+                    store(sq_tail_, tail + 1);
+                }
+
+                // submit `n` queued entries and wait for at least `wait` completions
+                int enter(unsigned n, unsigned wait) noexcept
+                {
+                    for (;;) {
+                        auto const r = ::syscall(__NR_io_uring_enter, fd_, n, wait, wait ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+                        if (r >= 0 || errno != EINTR) return static_cast<int>(r);
+                    }
+                }
+
+                template<typename Fn>
+                unsigned reap(Fn&& fn) noexcept
+                {
+                    auto head = *cq_head_;
+                    auto const tail = load(cq_tail_);
+                    unsigned n = 0;
+                    for (; head != tail; ++head, ++n) {
+                        auto const& cqe = cqes_[head & cq_mask_];
+                        fn(cqe.user_data, cqe.res);
+                    }
+                    store(cq_head_, head);
+                    return n;
+                }
+
+                // drop queued entries the kernel has not consumed and return how
+                // many; safe without SQPOLL, where only io_uring_enter reads the SQ
+                unsigned retract() noexcept
+                {
+                    auto const head = load(sq_head_);
+                    auto const tail = *sq_tail_;
+                    store(sq_tail_, head);
+                    return tail - head;
+                }
+
+                // close and reopen; closing the fd cancels whatever is still in flight
+                void reset() noexcept
+                {
+                    teardown();
+                    open(depth_);
+                }
+            };
+
+            LBYTE_STX_PLATFORM_INLINE auto thread_ring() noexcept -> uring&
+            {
+                thread_local uring r{ batch_depth };
+                return r;
+            }
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto read(const file& f, std::span<const read_req> reqs) -> std::vector<read_result>
+        {
+            std::vector<read_result> out(reqs.size(), read_result{ std::unexpected(std::errc::io_error) });
+
+            auto& ring = details::thread_ring();
+            if (!ring || reqs.size() < 2) {
+                for (usize i = 0; i < reqs.size(); ++i)
+                    out[i] = details::sync_read(f, reqs[i]);
+                return out;
+            }
+
+            auto complete = [&](u64 tag, int res) {
+                auto const  i = static_cast<usize>(tag);
+                auto const& r = reqs[i];
+                if (res < 0) {
+                    // old kernels reject IORING_OP_READ; redo positionally
+                    out[i] = (res == -EINVAL || res == -EOPNOTSUPP)
+                        ? details::sync_read(f, r)
+                        : read_result{ std::unexpected(static_cast<std::errc>(-res)) };
+                    return;
+                }
+                auto const got = static_cast<usize>(res);
+                if (got != 0 && got < r.out.size()) {
+                    auto rest = f.read_at(r.offset + off_s{ static_cast<off_s::value_type>(got) }, r.out.subspan(got));
+                    out[i] = rest ? read_result{ got + *rest } : read_result{ std::unexpected(rest.error()) };
+                    return;
+                }
+                out[i] = got;
+            };
+
+            usize    next     = 0;
+            unsigned unsent   = 0;  // queued in the SQ, not yet consumed by the kernel
+            unsigned inflight = 0;  // consumed, completion not reaped yet
+            while (next < reqs.size() || unsent + inflight != 0)
+            {
+                while (next < reqs.size() && unsent + inflight < ring.capacity()) {
+                    auto const& r = reqs[next];
+                    if (r.offset.get() < 0 || r.out.size() > details::max_xfer) {
+                        out[next] = details::sync_read(f, r);
+                        ++next;
+                        continue;
+                    }
+                    ring.push_read(f.native_handle(), static_cast<u64>(r.offset.get()),
+                                   r.out.data(), static_cast<u32>(r.out.size()), next);
+                    ++next;
+                    ++unsent;
+                }
+
+                if (unsent + inflight == 0)
+                    continue;
+
+                auto const took = ring.enter(unsent, 1);   // retries EINTR itself
+                if (took < 0 && errno != EAGAIN && errno != EBUSY) [[unlikely]] {
+                    // the ring outlives this call and the kernel may still be
+                    // filling earlier buffers: take back what was never submitted
+                    // and wait out the rest, so no completion leaks into the next
+                    // batch. Requests that never completed stay io_error.
+                    inflight += unsent - ring.retract();
+                    while (inflight != 0) {
+                        if (ring.enter(0, 1) < 0 && errno != EAGAIN && errno != EBUSY) {
+                            ring.reset();
+                            break;
+                        }
+                        inflight -= ring.reap(complete);
+                    }
+                    return out;
+                }
+                if (took > 0) {
+                    unsent   -= static_cast<unsigned>(took);
+                    inflight += static_cast<unsigned>(took);
+                }
+                inflight -= ring.reap(complete);
+            }
+            return out;
+        }
+
+        #else
+
+        LBYTE_STX_PLATFORM_INLINE auto read(const file& f, std::span<const read_req> reqs) -> std::vector<read_result>
+        {
+            std::vector<read_result> out;
+            out.reserve(reqs.size());
+            for (auto const& r : reqs)
+                out.push_back(details::sync_read(f, r));
+            return out;
+        }
+
+        #endif
+
+    #endif
+}
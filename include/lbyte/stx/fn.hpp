@@ -1,6 +1,17 @@
 #pragma once
 #include "core.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 namespace lbyte::stx
 {
     template<class Sig>
@@ -10,7 +21,8 @@ namespace lbyte::stx
     template<class Ret, class... Args> \
     struct caller_t<Ret CC(Args...)> \
     { \
-        using fn_t = Ret (CC *)(Args...); \
+        using fn_t     = Ret (CC *)(Args...); \
+        using result_t = Ret; \
         fn_t fn = nullptr; \
         \
         template<address_like Addr> \
@@ -22,6 +34,10 @@ namespace lbyte::stx
             : fn(nullptr) \
         {} \
         \
+        inline constexpr caller_t(fn_t f) noexcept \
+            : fn(f) \
+        {} \
+        \
         inline constexpr operator fn_t      ()             const noexcept { return fn; }; \
         inline constexpr Ret      operator()(Args... args) const \
             noexcept(std::is_nothrow_invocable_v<fn_t, Args...>) \
@@ -52,5 +68,288 @@ namespace lbyte::stx
     {
         return caller_t<Sig>( addr );
     }
-}
 
+    namespace details
+    {
+        // args[k] is passed as is, or unpacked when it is a tuple / pair
+        template<class T>
+        concept tuple_args = requires { std::tuple_size<std::remove_cvref_t<T>>::value; };
+
+        template<class Fn, class A>
+        inline constexpr decltype(auto) apply_args(Fn fn, A&& a)
+        {
+            if constexpr (tuple_args<A>) return std::apply(fn, std::forward<A>(a));
+            else                         return fn(std::forward<A>(a));
+        }
+
+        // output iterator that drops what it is given
+        struct discard_out
+        {
+            constexpr discard_out& operator*()  noexcept { return *this; }
+            constexpr discard_out& operator++() noexcept { return *this; }
+
+            template<class T>
+            constexpr discard_out& operator=(T&&) noexcept { return *this; }
+        };
+
+        // `p == K0 ? K0(a...) : p == K1 ? K1(a...) : ... : p(a...)`; each arm
+        // is a direct (inlinable) call, only unknown targets branch indirectly
+        template<auto... Known, class Fn, class... A>
+        inline constexpr decltype(auto) guarded_call(Fn p, A&&... a)
+        {
+            if constexpr (sizeof...(Known) == 0) {
+                return p(std::forward<A>(a)...);
+            } else {
+                return [&]<auto K, auto... Rest>() -> decltype(auto) {
+                    if (p == K) return K(std::forward<A>(a)...);
+                    return guarded_call<Rest...>(p, std::forward<A>(a)...);
+                }.template operator()<Known...>();
+            }
+        }
+    }
+
+    // --- caller_switch -----------------------------------------------------------
+    // A target set fixed at compile time. call(i, args...) is an if-chain on
+    // `i` over direct calls, which the compiler lowers to a jump table (or a
+    // few compares) and may inline; no function pointer is ever loaded.
+
+    template<class Sig, typename caller_t<Sig>::fn_t... Fs>
+    struct caller_switch
+    {
+        using fn_t     = typename caller_t<Sig>::fn_t;
+        using result_t = typename caller_t<Sig>::result_t;
+
+        static constexpr usize                  size = sizeof...(Fs);
+        static constexpr std::array<fn_t, size> targets{ Fs... };
+
+        static_assert(size > 0, "caller_switch: empty target set");
+
+        // index of `p` in the set, `size` when absent
+        [[nodiscard]] static constexpr usize index_of(fn_t p) noexcept
+        {
+            return scast<usize>(std::ranges::find(targets, p) - targets.begin());
+        }
+
+        [[nodiscard]] static constexpr caller_t<Sig> at(usize i) noexcept { return i < size ? targets[i] : nullptr; }
+
+        // precondition: i < size
+        template<class... A>
+            requires std::is_invocable_v<fn_t, A...>
+        static constexpr result_t call(usize i, A&&... a)
+        {
+            return dispatch<0>(i, std::forward<A>(a)...);
+        }
+
+        template<class... A>
+            requires std::is_invocable_v<fn_t, A...>
+        constexpr result_t operator()(usize i, A&&... a) const
+        {
+            return dispatch<0>(i, std::forward<A>(a)...);
+        }
+
+    private:
+        template<usize I, class... A>
+        static constexpr result_t dispatch(usize i, A&&... a)
+        {
+            if constexpr (I + 1 == size) {
+                return targets[I](std::forward<A>(a)...);
+            } else {
+                if (i == I) return targets[I](std::forward<A>(a)...);
+                return dispatch<I + 1>(i, std::forward<A>(a)...);
+            }
+        }
+    };
+
+    // --- caller_table ------------------------------------------------------------
+    // Contiguous, cache-line aligned array of caller_t<Sig> targets. Entries
+    // are plain function pointers (sizeof(fn_t) each), so eight share a line.
+    // Entries may be null; calling one is undefined, like caller_t.
+
+    template<class Sig>
+    class caller_table
+    {
+    public:
+        using caller_type = caller_t<Sig>;
+        using fn_t        = typename caller_type::fn_t;
+        using result_t    = typename caller_type::result_t;
+
+        static constexpr usize alignment = 64;
+
+    private:
+        fn_t* data_ = nullptr;
+        usize size_ = 0;
+        usize cap_  = 0;
+
+        static fn_t* allocate(usize n)
+        {
+            return n ? scast<fn_t*>(::operator new(n * sizeof(fn_t), std::align_val_t{ alignment })) : nullptr;
+        }
+
+        static void release(fn_t* p) noexcept
+        {
+            if (p) ::operator delete(p, std::align_val_t{ alignment });
+        }
+
+        // call_batch loads the targets of the next batch_width calls before
+        // making the current ones, so each indirect branch finds its target
+        // already loaded instead of waiting on the table
+        static constexpr usize batch_width = 16;
+
+    public:
+        caller_table() noexcept = default;
+
+        // n null entries
+        explicit caller_table(usize n)
+            : data_(allocate(n)), size_(n), cap_(n)
+        {
+            std::fill_n(data_, n, nullptr);
+        }
+
+        caller_table(std::initializer_list<caller_type> init)
+            : caller_table(init.size())
+        {
+            std::ranges::transform(init, data_, [](caller_type c) { return c.fn; });
+        }
+
+        caller_table(const caller_table& other)
+            : data_(allocate(other.size_)), size_(other.size_), cap_(other.size_)
+        {
+            if (size_) std::memcpy(data_, other.data_, size_ * sizeof(fn_t));
+        }
+
+        caller_table(caller_table&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr))
+            , size_(std::exchange(other.size_, 0))
+            , cap_ (std::exchange(other.cap_, 0))
+        {}
+
+        caller_table& operator=(caller_table other) noexcept
+        {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(cap_,  other.cap_);
+            return *this;
+        }
+
+        ~caller_table() { release(data_); }
+
+        // --- state ---------------------------------------------------------
+
+        [[nodiscard]] usize size()     const noexcept { return size_; }
+        [[nodiscard]] usize capacity() const noexcept { return cap_; }
+        [[nodiscard]] bool  empty()    const noexcept { return size_ == 0; }
+
+        [[nodiscard]] const fn_t* data()  const noexcept { return data_; }
+        [[nodiscard]] const fn_t* begin() const noexcept { return data_; }
+        [[nodiscard]] const fn_t* end()   const noexcept { return data_ + size_; }
+
+        [[nodiscard]] caller_type operator[](usize i) const noexcept { return data_[i]; }
+
+        // --- edit ----------------------------------------------------------
+
+        void reserve(usize n)
+        {
+            if (n <= cap_) return;
+            auto* p = allocate(n);
+            if (size_) std::memcpy(p, data_, size_ * sizeof(fn_t));
+            release(std::exchange(data_, p));
+            cap_ = n;
+        }
+
+        // new entries are null
+        void resize(usize n)
+        {
+            reserve(n);
+            if (n > size_) std::fill(data_ + size_, data_ + n, nullptr);
+            size_ = n;
+        }
+
+        // returns the new entry's index
+        usize push_back(caller_type c)
+        {
+            if (size_ == cap_) reserve(std::max<usize>(alignment / sizeof(fn_t), cap_ * 2));
+            data_[size_] = c.fn;
+            return size_++;
+        }
+
+        void set(usize i, caller_type c) noexcept { data_[i] = c.fn; }
+
+        template<address_like Addr>
+        void set(usize i, Addr addr) noexcept { data_[i] = caller_type(addr).fn; }
+
+        void clear() noexcept { size_ = 0; }
+
+        // --- call ----------------------------------------------------------
+
+        template<class... A>
+            requires std::is_invocable_v<fn_t, A...>
+        result_t call(usize i, A&&... a) const
+        {
+            return data_[i](std::forward<A>(a)...);
+        }
+
+        // entry i through a guard for the Known targets: a hit is a direct,
+        // inlinable call, a miss falls back to the indirect one
+        template<fn_t... Known, class... A>
+            requires std::is_invocable_v<fn_t, A...>
+        result_t call_known(usize i, A&&... a) const
+        {
+            return details::guarded_call<Known...>(data_[i], std::forward<A>(a)...);
+        }
+
+        // every non-null entry in order, with the same arguments (hook chains)
+        template<class... A>
+            requires std::is_invocable_v<fn_t, A...>
+        void call_all(const A&... a) const
+        {
+            for (auto* p = data_, *e = data_ + size_; p != e; ++p)
+                if (*p) (*p)(a...);
+        }
+
+        // --- batched call --------------------------------------------------
+        // For k in [0, size(ids)): entry ids[k] with args[k] (a single
+        // argument, or a tuple / pair unpacked into the call). The result goes
+        // to *out++ when an output iterator is given. Targets are loaded one
+        // batch ahead of the calls that use them, so a handler that rewrites
+        // the table affects calls from the batch after next onwards.
+
+        template<std::ranges::random_access_range Ids, std::ranges::random_access_range Args, class Out>
+        void call_batch(const Ids& ids, Args&& args, Out out) const
+        {
+            using std::ranges::begin;
+
+            auto const n  = scast<usize>(std::ranges::size(ids));
+            auto       id = begin(ids);
+            auto       ar = begin(args);
+
+            // two buffers: batch k + 1 is loaded into one while batch k is
+            // called from the other
+            std::array<fn_t, batch_width> fns[2];
+            auto load = [&](std::array<fn_t, batch_width>& dst, usize k) {
+                auto const m = std::min(batch_width, n - k);
+                for (usize j = 0; j < m; ++j) dst[j] = data_[scast<usize>(id[k + j])];
+            };
+
+            if (n != 0) load(fns[0], 0);
+            for (usize k = 0, b = 0; k < n; k += batch_width, b ^= 1) {
+                auto const m = std::min(batch_width, n - k);
+                if (k + batch_width < n) load(fns[b ^ 1], k + batch_width);
+                auto const& cur = fns[b];
+                for (usize j = 0; j < m; ++j) {
+                    if constexpr (std::is_void_v<result_t>) {
+                        details::apply_args(cur[j], ar[k + j]);
+                    } else {
+                        *out = details::apply_args(cur[j], ar[k + j]);
+                        ++out;
+                    }
+                }
+            }
+        }
+
+        template<std::ranges::random_access_range Ids, std::ranges::random_access_range Args>
+        void call_batch(const Ids& ids, Args&& args) const
+        {
+            call_batch(ids, std::forward<Args>(args), details::discard_out{});
+        }
+    };
+}
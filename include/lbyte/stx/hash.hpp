@@ -0,0 +1,523 @@
+#pragma once
+#include "core.hpp"
+#include "ct.hpp"
+#include "simd.hpp"
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// --- kernel selection ------------------------------------------------------------
+// Compile-time, like simd.hpp. The constexpr path and every kernel produce the
+// same values; only the instructions differ.
+//   LBYTE_STX_HASH_CRC_X86    crc32c via SSE4.2 crc32 (x64, -msse4.2 / -mavx2)
+//   LBYTE_STX_HASH_CLMUL_X86  crc32 via PCLMULQDQ folding (-mpclmul -msse4.1)
+//   LBYTE_STX_HASH_CRC_ARM    crc32 and crc32c via ARMv8 CRC (-march=armv8-a+crc)
+// xxHash has no vector kernel: its multiply chains are faster as four scalar
+// lanes than as pmulld (10-cycle latency) lanes.
+
+#if !defined(LBYTE_STX_HASH_CRC_X86)
+    #if ( defined(__SSE4_2__) || LBYTE_STX_SIMD_AVX2 ) && ( defined(__x86_64__) || defined(_M_X64) )
+        #define LBYTE_STX_HASH_CRC_X86 1
+    #else
+        #define LBYTE_STX_HASH_CRC_X86 0
+    #endif
+#endif
+
+#if !defined(LBYTE_STX_HASH_CRC_ARM)
+    #if defined(__ARM_FEATURE_CRC32) && defined(__aarch64__)
+        #define LBYTE_STX_HASH_CRC_ARM 1
+    #else
+        #define LBYTE_STX_HASH_CRC_ARM 0
+    #endif
+#endif
+
+#if !defined(LBYTE_STX_HASH_CLMUL_X86)
+    #if defined(__PCLMUL__) && ( defined(__SSE4_1__) || LBYTE_STX_SIMD_AVX2 )
+        #define LBYTE_STX_HASH_CLMUL_X86 1
+    #else
+        #define LBYTE_STX_HASH_CLMUL_X86 0
+    #endif
+#endif
+
+#if LBYTE_STX_HASH_CRC_X86
+    #include <nmmintrin.h>
+#endif
+#if LBYTE_STX_HASH_CLMUL_X86
+    #include <smmintrin.h>
+    #include <wmmintrin.h>
+#endif
+#if LBYTE_STX_HASH_CRC_ARM
+    #include <arm_acle.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx::hash
+{
+    // true when the running kernel uses a CRC instruction
+    inline constexpr bool hw_crc32c = LBYTE_STX_HASH_CRC_X86 || LBYTE_STX_HASH_CRC_ARM;
+    inline constexpr bool hw_crc32  = LBYTE_STX_HASH_CLMUL_X86 || LBYTE_STX_HASH_CRC_ARM;
+
+    // contiguous bytes: std::span<u8 / std::byte / char>, std::vector, std::string, ...
+    // (arrays are excluded so a string literal never hashes its NUL)
+    template<typename R>
+    concept byte_range
+        =  contiguous_buffer<const R>
+        && !std::is_array_v<std::remove_cvref_t<R>>
+        && buffer_type<std::remove_cvref_t<decltype( *std::data( std::declval<const R&>() ))>>;
+
+    namespace details
+    {
+        // --- loads (byte loop at compile time, memcpy at run time) ---------------
+
+        template<typename C>
+        [[nodiscard]] STX_FORCE_INLINE constexpr u8 byte_at( const C* p, usize i ) noexcept
+        {
+            return scast<u8>( p[i] );
+        }
+
+        template<std::unsigned_integral T, typename C>
+        [[nodiscard]] STX_FORCE_INLINE constexpr T load( const C* p ) noexcept
+        {
+            if consteval {
+                T v = 0;
+                for ( usize i = 0; i < sizeof( T ); ++i )
+                    v |= scast<T>( byte_at( p, i )) << ( i * 8 );
+                return v;
+            } else {
+                T v;
+                std::memcpy( &v, p, sizeof( T ));
+                if constexpr ( std::endian::native == std::endian::big )
+                    v = std::byteswap( v );
+                return v;
+            }
+        }
+
+        // --- FNV-1a ----------------------------------------------------------------
+
+        template<typename C>
+        [[nodiscard]] constexpr u32 fnv1a32( const C* p, usize n ) noexcept
+        {
+            u32 h = 0x811C9DC5u;
+            for ( usize i = 0; i < n; ++i )
+                h = ( h ^ byte_at( p, i )) * 0x01000193u;
+            return h;
+        }
+
+        template<typename C>
+        [[nodiscard]] constexpr u64 fnv1a64( const C* p, usize n ) noexcept
+        {
+            u64 h = 0xCBF29CE484222325ull;
+            for ( usize i = 0; i < n; ++i )
+                h = ( h ^ byte_at( p, i )) * 0x100000001B3ull;
+            return h;
+        }
+
+        // --- xxHash32 ----------------------------------------------------------------
+
+        inline constexpr u32 xxh32_p1 = 0x9E3779B1u;
+        inline constexpr u32 xxh32_p2 = 0x85EBCA77u;
+        inline constexpr u32 xxh32_p3 = 0xC2B2AE3Du;
+        inline constexpr u32 xxh32_p4 = 0x27D4EB2Fu;
+        inline constexpr u32 xxh32_p5 = 0x165667B1u;
+
+        [[nodiscard]] STX_FORCE_INLINE constexpr u32 xxh32_round( u32 acc, u32 in ) noexcept
+        {
+            return std::rotl( acc + in * xxh32_p2, 13 ) * xxh32_p1;
+        }
+
+        template<typename C>
+        [[nodiscard]] constexpr u32 xxh32( const C* p, usize n, u32 seed ) noexcept
+        {
+            usize i = 0;
+            u32   h;
+            if ( n >= 16 ) {
+                u32 v1 = seed + xxh32_p1 + xxh32_p2, v2 = seed + xxh32_p2, v3 = seed, v4 = seed - xxh32_p1;
+                for ( ; i + 16 <= n; i += 16 ) {
+                    v1 = xxh32_round( v1, load<u32>( p + i      ));
+                    v2 = xxh32_round( v2, load<u32>( p + i + 4  ));
+                    v3 = xxh32_round( v3, load<u32>( p + i + 8  ));
+                    v4 = xxh32_round( v4, load<u32>( p + i + 12 ));
+                }
+                h = std::rotl( v1, 1 ) + std::rotl( v2, 7 ) + std::rotl( v3, 12 ) + std::rotl( v4, 18 );
+            } else {
+                h = seed + xxh32_p5;
+            }
+            h += scast<u32>( n );
+
+            for ( ; i + 4 <= n; i += 4 )
+                h = std::rotl( h + load<u32>( p + i ) * xxh32_p3, 17 ) * xxh32_p4;
+            for ( ; i < n; ++i )
+                h = std::rotl( h + byte_at( p, i ) * xxh32_p5, 11 ) * xxh32_p1;
+
+            h ^= h >> 15; h *= xxh32_p2;
+            h ^= h >> 13; h *= xxh32_p3;
+            h ^= h >> 16;
+            return h;
+        }
+
+        // --- xxHash64 (four independent lanes; 64-bit multiplies stay scalar) -------
+
+        inline constexpr u64 xxh64_p1 = 0x9E3779B185EBCA87ull;
+        inline constexpr u64 xxh64_p2 = 0xC2B2AE3D27D4EB4Full;
+        inline constexpr u64 xxh64_p3 = 0x165667B19E3779F9ull;
+        inline constexpr u64 xxh64_p4 = 0x85EBCA77C2B2AE63ull;
+        inline constexpr u64 xxh64_p5 = 0x27D4EB2F165667C5ull;
+
+        [[nodiscard]] STX_FORCE_INLINE constexpr u64 xxh64_round( u64 acc, u64 in ) noexcept
+        {
+            return std::rotl( acc + in * xxh64_p2, 31 ) * xxh64_p1;
+        }
+
+        [[nodiscard]] STX_FORCE_INLINE constexpr u64 xxh64_merge( u64 h, u64 v ) noexcept
+        {
+            return ( h ^ xxh64_round( 0, v )) * xxh64_p1 + xxh64_p4;
+        }
+
+        template<typename C>
+        [[nodiscard]] constexpr u64 xxh64( const C* p, usize n, u64 seed ) noexcept
+        {
+            usize i = 0;
+            u64   h;
+            if ( n >= 32 ) {
+                u64 v1 = seed + xxh64_p1 + xxh64_p2, v2 = seed + xxh64_p2, v3 = seed, v4 = seed - xxh64_p1;
+                for ( ; i + 32 <= n; i += 32 ) {
+                    v1 = xxh64_round( v1, load<u64>( p + i      ));
+                    v2 = xxh64_round( v2, load<u64>( p + i + 8  ));
+                    v3 = xxh64_round( v3, load<u64>( p + i + 16 ));
+                    v4 = xxh64_round( v4, load<u64>( p + i + 24 ));
+                }
+                h = std::rotl( v1, 1 ) + std::rotl( v2, 7 ) + std::rotl( v3, 12 ) + std::rotl( v4, 18 );
+                h = xxh64_merge( h, v1 );
+                h = xxh64_merge( h, v2 );
+                h = xxh64_merge( h, v3 );
+                h = xxh64_merge( h, v4 );
+            } else {
+                h = seed + xxh64_p5;
+            }
+            h += scast<u64>( n );
+
+            for ( ; i + 8 <= n; i += 8 )
+                h = std::rotl( h ^ xxh64_round( 0, load<u64>( p + i )), 27 ) * xxh64_p1 + xxh64_p4;
+            if ( i + 4 <= n ) {
+                h = std::rotl( h ^ ( u64{ load<u32>( p + i ) } * xxh64_p1 ), 23 ) * xxh64_p2 + xxh64_p3;
+                i += 4;
+            }
+            for ( ; i < n; ++i )
+                h = std::rotl( h ^ ( byte_at( p, i ) * xxh64_p5 ), 11 ) * xxh64_p1;
+
+            h ^= h >> 33; h *= xxh64_p2;
+            h ^= h >> 29; h *= xxh64_p3;
+            h ^= h >> 32;
+            return h;
+        }
+
+        // --- CRC-32 (reflected; slicing-by-8 tables) --------------------------------
+
+        inline constexpr u32 crc32_poly  = 0xEDB88320u;   // IEEE 802.3 / zlib / PNG
+        inline constexpr u32 crc32c_poly = 0x82F63B78u;   // Castagnoli / iSCSI / ext4
+
+        template<u32 Poly>
+        inline constexpr auto crc_table = [] {
+            std::array<std::array<u32, 256>, 8> t{};
+            for ( u32 i = 0; i < 256; ++i ) {
+                u32 c = i;
+                for ( int k = 0; k < 8; ++k )
+                    c = ( c >> 1 ) ^ ( Poly & ( 0u - ( c & 1 )));
+                t[0][i] = c;
+            }
+            for ( usize s = 1; s < 8; ++s )
+                for ( usize i = 0; i < 256; ++i )
+                    t[s][i] = ( t[s - 1][i] >> 8 ) ^ t[0][t[s - 1][i] & 0xFF];
+            return t;
+        }();
+
+        // raw register in, raw register out (no pre / post inversion)
+        template<u32 Poly, typename C>
+        [[nodiscard]] constexpr u32 crc_sliced( const C* p, usize n, u32 c ) noexcept
+        {
+            auto const& t = crc_table<Poly>;
+            usize i = 0;
+            for ( ; i + 8 <= n; i += 8 ) {
+                auto const lo = load<u32>( p + i ) ^ c;
+                auto const hi = load<u32>( p + i + 4 );
+                c = t[7][lo & 0xFF] ^ t[6][( lo >> 8 ) & 0xFF] ^ t[5][( lo >> 16 ) & 0xFF] ^ t[4][lo >> 24]
+                  ^ t[3][hi & 0xFF] ^ t[2][( hi >> 8 ) & 0xFF] ^ t[1][( hi >> 16 ) & 0xFF] ^ t[0][hi >> 24];
+            }
+            for ( ; i < n; ++i )
+                c = ( c >> 8 ) ^ t[0][( c ^ byte_at( p, i )) & 0xFF];
+            return c;
+        }
+
+        // --- CRC instruction kernels --------------------------------------------
+        // One crc32 instruction retires per cycle but has 3 cycles of latency, so
+        // long inputs run as three interleaved streams of crc_lane bytes each,
+        // joined with crc_shift (the register advanced over crc_lane zero bytes).
+
+        inline constexpr usize crc_lane = 4096;
+
+        // GF(2) 32x32 operator as column images
+        using gf2_op = std::array<u32, 32>;
+
+        [[nodiscard]] constexpr u32 gf2_apply( const gf2_op& m, u32 v ) noexcept
+        {
+            u32 r = 0;
+            for ( usize i = 0; v; ++i, v >>= 1 )
+                r ^= m[i] & ( 0u - ( v & 1 ));
+            return r;
+        }
+
+        // register after `bytes` zero bytes, as byte-indexed tables
+        template<u32 Poly, usize Bytes>
+        inline constexpr auto crc_shift_table = [] {
+            gf2_op step{}, acc{}, sq{};
+            step[0] = Poly;                                    // one zero bit
+            for ( usize i = 1; i < 32; ++i ) step[i] = 1u << ( i - 1 );
+            for ( usize i = 0; i < 32; ++i ) acc[i]  = 1u << i;
+
+            for ( usize n = Bytes * 8; n; n >>= 1 ) {
+                if ( n & 1 )
+                    for ( usize i = 0; i < 32; ++i ) acc[i] = gf2_apply( step, acc[i] );
+                for ( usize i = 0; i < 32; ++i ) sq[i] = gf2_apply( step, step[i] );
+                step = sq;
+            }
+
+            std::array<std::array<u32, 256>, 4> t{};
+            for ( usize k = 0; k < 4; ++k )
+                for ( u32 b = 0; b < 256; ++b )
+                    t[k][b] = gf2_apply( acc, b << ( 8 * k ));
+            return t;
+        }();
+
+        template<u32 Poly>
+        [[nodiscard]] STX_FORCE_INLINE u32 crc_shift( u32 c ) noexcept
+        {
+            auto const& t = crc_shift_table<Poly, crc_lane>;
+            return t[0][c & 0xFF] ^ t[1][( c >> 8 ) & 0xFF] ^ t[2][( c >> 16 ) & 0xFF] ^ t[3][c >> 24];
+        }
+
+        // Step8(u32, u64) / Step1(u32, u8): one crc instruction
+        template<u32 Poly, typename Step8, typename Step1>
+        [[nodiscard]] STX_FORCE_INLINE u32 crc_hw( const u8* p, usize n, u32 c, Step8 step8, Step1 step1 ) noexcept
+        {
+            auto word = [p]( usize at ) { u64 w; std::memcpy( &w, p + at, 8 ); return w; };
+
+            usize i = 0;
+            for ( ; i + 3 * crc_lane <= n; i += 3 * crc_lane ) {
+                u32 c1 = 0, c2 = 0;
+                for ( usize k = 0; k < crc_lane; k += 8 ) {
+                    c  = step8( c,  word( i + k ));
+                    c1 = step8( c1, word( i + k + crc_lane ));
+                    c2 = step8( c2, word( i + k + 2 * crc_lane ));
+                }
+                c = crc_shift<Poly>( crc_shift<Poly>( c ) ^ c1 ) ^ c2;
+            }
+            for ( ; i + 8 <= n; i += 8 )
+                c = step8( c, word( i ));
+            for ( ; i < n; ++i )
+                c = step1( c, p[i] );
+            return c;
+        }
+
+    #if LBYTE_STX_HASH_CRC_X86
+        inline u32 crc32c_hw( const u8* p, usize n, u32 c ) noexcept
+        {
+            return crc_hw<crc32c_poly>( p, n, c,
+                []( u32 r, u64 w ) { return scast<u32>( _mm_crc32_u64( r, w )); },
+                []( u32 r, u8 b )  { return _mm_crc32_u8( r, b ); });
+        }
+    #elif LBYTE_STX_HASH_CRC_ARM
+        inline u32 crc32c_hw( const u8* p, usize n, u32 c ) noexcept
+        {
+            return crc_hw<crc32c_poly>( p, n, c,
+                []( u32 r, u64 w ) { return __crc32cd( r, w ); },
+                []( u32 r, u8 b )  { return __crc32cb( r, b ); });
+        }
+    #endif
+
+    #if LBYTE_STX_HASH_CRC_ARM
+        inline u32 crc32_hw( const u8* p, usize n, u32 c ) noexcept
+        {
+            return crc_hw<crc32_poly>( p, n, c,
+                []( u32 r, u64 w ) { return __crc32d( r, w ); },
+                []( u32 r, u8 b )  { return __crc32b( r, b ); });
+        }
+    #elif LBYTE_STX_HASH_CLMUL_X86
+        // Carry-less folding of four 128-bit lanes, then Barrett reduction
+        // (Intel, "Fast CRC Computation Using PCLMULQDQ"); 64+ bytes only.
+        inline u32 crc32_clmul( const u8* p, usize n, u32 c ) noexcept
+        {
+            auto load  = []( const u8* q ) { return _mm_loadu_si128( rcast<const __m128i*>( q )); };
+            auto fold  = []( __m128i x, __m128i k, __m128i next ) {
+                return _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x, k, 0x11 ), _mm_clmulepi64_si128( x, k, 0x00 )), next );
+            };
+
+            __m128i const k1k2 = _mm_set_epi64x( 0x01C6E41596, 0x0154442BD4 );
+            __m128i const k3k4 = _mm_set_epi64x( 0x00CCAA009E, 0x01751997D0 );
+            __m128i const k5   = _mm_set_epi64x( 0, 0x0163CD6124 );
+            __m128i const poly = _mm_set_epi64x( 0x01F7011641, 0x01DB710641 );
+            __m128i const lo32 = _mm_setr_epi32( -1, 0, -1, 0 );
+
+            __m128i x1 = _mm_xor_si128( load( p ), _mm_cvtsi32_si128( scast<int>( c )));
+            __m128i x2 = load( p + 16 ), x3 = load( p + 32 ), x4 = load( p + 48 );
+            p += 64; n -= 64;
+
+            for ( ; n >= 64; p += 64, n -= 64 ) {
+                x1 = fold( x1, k1k2, load( p      ));
+                x2 = fold( x2, k1k2, load( p + 16 ));
+                x3 = fold( x3, k1k2, load( p + 32 ));
+                x4 = fold( x4, k1k2, load( p + 48 ));
+            }
+
+            x1 = fold( x1, k3k4, x2 );
+            x1 = fold( x1, k3k4, x3 );
+            x1 = fold( x1, k3k4, x4 );
+            for ( ; n >= 16; p += 16, n -= 16 )
+                x1 = fold( x1, k3k4, load( p ));
+
+            // 128 -> 64 bits
+            x1 = _mm_xor_si128( _mm_srli_si128( x1, 8 ), _mm_clmulepi64_si128( x1, k3k4, 0x10 ));
+            x1 = _mm_xor_si128( _mm_clmulepi64_si128( _mm_and_si128( x1, lo32 ), k5, 0x00 ), _mm_srli_si128( x1, 4 ));
+
+            // Barrett reduction to 32 bits
+            __m128i x2b = _mm_clmulepi64_si128( _mm_and_si128( x1, lo32 ), poly, 0x10 );
+            x2b = _mm_clmulepi64_si128( _mm_and_si128( x2b, lo32 ), poly, 0x00 );
+            c   = scast<u32>( _mm_extract_epi32( _mm_xor_si128( x1, x2b ), 1 ));
+
+            return crc_sliced<crc32_poly>( p, n, c );
+        }
+
+        inline u32 crc32_hw( const u8* p, usize n, u32 c ) noexcept
+        {
+            return n >= 64 ? crc32_clmul( p, n, c ) : crc_sliced<crc32_poly>( p, n, c );
+        }
+    #endif
+
+        // --- combine (zlib crc32_combine: crc1 * x^(8 * len2) mod P, xor crc2) -----
+
+        template<u32 Poly>
+        [[nodiscard]] constexpr u32 gf2_mulmod( u32 a, u32 b ) noexcept
+        {
+            u32 m = 1u << 31, r = 0;
+            for (;;) {
+                if ( a & m ) {
+                    r ^= b;
+                    if (( a & ( m - 1 )) == 0 ) break;
+                }
+                m >>= 1;
+                b = ( b >> 1 ) ^ ( Poly & ( 0u - ( b & 1 )));
+            }
+            return r;
+        }
+
+        // x^(2^k) mod P
+        template<u32 Poly>
+        inline constexpr auto x2n_table = [] {
+            std::array<u32, 32> t{};
+            t[0] = 1u << 30;
+            for ( usize k = 1; k < 32; ++k )
+                t[k] = gf2_mulmod<Poly>( t[k - 1], t[k - 1] );
+            return t;
+        }();
+
+        template<u32 Poly>
+        [[nodiscard]] constexpr u32 crc_combine( u32 crc1, u32 crc2, u64 len2 ) noexcept
+        {
+            u32 x = 1u << 31;   // x^0
+            for ( usize k = 3; len2; len2 >>= 1, ++k )
+                if ( len2 & 1 )
+                    x = gf2_mulmod<Poly>( x2n_table<Poly>[k & 31], x );
+            return gf2_mulmod<Poly>( x, crc1 ) ^ crc2;
+        }
+
+        template<typename C>
+        [[nodiscard]] constexpr u32 crc32( const C* p, usize n, u32 crc ) noexcept
+        {
+        #if LBYTE_STX_HASH_CLMUL_X86 || LBYTE_STX_HASH_CRC_ARM
+            if !consteval { return ~crc32_hw( rcast<const u8*>( p ), n, ~crc ); }
+        #endif
+            return ~crc_sliced<crc32_poly>( p, n, ~crc );
+        }
+
+        template<typename C>
+        [[nodiscard]] constexpr u32 crc32c( const C* p, usize n, u32 crc ) noexcept
+        {
+        #if LBYTE_STX_HASH_CRC_X86 || LBYTE_STX_HASH_CRC_ARM
+            if !consteval { return ~crc32c_hw( rcast<const u8*>( p ), n, ~crc ); }
+        #endif
+            return ~crc_sliced<crc32c_poly>( p, n, ~crc );
+        }
+    }
+
+    // --- API ---------------------------------------------------------------------
+    // Every function is constexpr and returns the same value at compile time and
+    // at run time. CRCs chain: crc32(b, crc32(a)) == crc32(a + b).
+
+    [[nodiscard]] constexpr u32 fnv1a32( std::string_view s ) noexcept { return details::fnv1a32( s.data(), s.size() ); }
+    [[nodiscard]] constexpr u64 fnv1a64( std::string_view s ) noexcept { return details::fnv1a64( s.data(), s.size() ); }
+
+    template<byte_range R>
+    [[nodiscard]] constexpr u32 fnv1a32( const R& data ) noexcept { return details::fnv1a32( std::data( data ), std::size( data )); }
+
+    template<byte_range R>
+    [[nodiscard]] constexpr u64 fnv1a64( const R& data ) noexcept { return details::fnv1a64( std::data( data ), std::size( data )); }
+
+    [[nodiscard]] constexpr u32 xxh32( std::string_view s, u32 seed = 0 ) noexcept { return details::xxh32( s.data(), s.size(), seed ); }
+    [[nodiscard]] constexpr u64 xxh64( std::string_view s, u64 seed = 0 ) noexcept { return details::xxh64( s.data(), s.size(), seed ); }
+
+    template<byte_range R>
+    [[nodiscard]] constexpr u32 xxh32( const R& data, u32 seed = 0 ) noexcept { return details::xxh32( std::data( data ), std::size( data ), seed ); }
+
+    template<byte_range R>
+    [[nodiscard]] constexpr u64 xxh64( const R& data, u64 seed = 0 ) noexcept { return details::xxh64( std::data( data ), std::size( data ), seed ); }
+
+    [[nodiscard]] constexpr u32 crc32 ( std::string_view s, u32 crc = 0 ) noexcept { return details::crc32 ( s.data(), s.size(), crc ); }
+    [[nodiscard]] constexpr u32 crc32c( std::string_view s, u32 crc = 0 ) noexcept { return details::crc32c( s.data(), s.size(), crc ); }
+
+    template<byte_range R>
+    [[nodiscard]] constexpr u32 crc32( const R& data, u32 crc = 0 ) noexcept { return details::crc32( std::data( data ), std::size( data ), crc ); }
+
+    template<byte_range R>
+    [[nodiscard]] constexpr u32 crc32c( const R& data, u32 crc = 0 ) noexcept { return details::crc32c( std::data( data ), std::size( data ), crc ); }
+
+    // crc of a + b from crc(a), crc(b) and b's length; O(log len)
+    [[nodiscard]] constexpr u32 crc32_combine ( u32 a, u32 b, u64 len_b ) noexcept { return details::crc_combine<details::crc32_poly >( a, b, len_b ); }
+    [[nodiscard]] constexpr u32 crc32c_combine( u32 a, u32 b, u64 len_b ) noexcept { return details::crc_combine<details::crc32c_poly>( a, b, len_b ); }
+
+    // --- compile-time values over ct::fixed_string ---------------------------------
+
+    enum class algo : u8
+    {
+        fnv1a32,
+        fnv1a64,
+        xxh32  ,
+        xxh64  ,
+        crc32  ,
+        crc32c ,
+    };
+
+    template<algo A>
+    [[nodiscard]] constexpr auto of( std::string_view s ) noexcept
+    {
+        if constexpr      ( A == algo::fnv1a32 ) return fnv1a32( s );
+        else if constexpr ( A == algo::fnv1a64 ) return fnv1a64( s );
+        else if constexpr ( A == algo::xxh32   ) return xxh32( s );
+        else if constexpr ( A == algo::xxh64   ) return xxh64( s );
+        else if constexpr ( A == algo::crc32   ) return crc32( s );
+        else                                     return crc32c( s );
+    }
+
+    // hash::value<"LoadLibraryA", hash::algo::crc32c> (no NUL)
+    template<ct::fixed_string S, algo A = algo::fnv1a64>
+    inline constexpr auto value = of<A>( std::string_view{ S.data, S.size() } );
+}
+
+#undef STX_FORCE_INLINE
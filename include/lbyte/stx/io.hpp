@@ -1,956 +1,10 @@
 #pragma once
-#include "./core.hpp"
-#include "./mem.hpp"
-
-#include <expected>
-#include <istream>
-#include <memory>
-#include <ostream>
-#include <system_error>
-#include <utility>
-#include <vector>
-#include <span>
-#include <filesystem>
-
-#if !defined(_WIN32)
-    #include <sys/mman.h>
-    #include <sys/stat.h>
-    #include <fcntl.h>
-    #include <unistd.h>
-#else
-    #if !defined(NOMINMAX)
-        #define NOMINMAX
-    #endif
-    #if !defined(WIN32_LEAN_AND_MEAN)
-        #define WIN32_LEAN_AND_MEAN
-    #endif
-    #include <windows.h>
-#endif
-
-namespace lbyte::stx
-{
-    // ALLOCATOR ----------------------------------------------------------------
-    namespace details
-    {
-        template<typename T>
-        class vec_init_allocator
-        {
-        public:
-            using value_type = T;
-
-            vec_init_allocator() noexcept = default;
-
-            template<typename U>
-            vec_init_allocator(const vec_init_allocator<U>&) noexcept {}
-
-            template<typename U>
-            void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>) {
-                if constexpr (std::is_default_constructible_v<U>) {
-                    ::new(static_cast<void*>(ptr)) U;
-                }
-            }
-
-            template<typename U, typename... Args>
-            void construct(U* ptr, Args&&... args) {
-                ::new(static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
-            }
-
-            [[nodiscard]] T* allocate(std::size_t n) {
-                return static_cast<T*>(::operator new(n * sizeof(T)));
-            }
-
-            void deallocate(T* p, std::size_t n) noexcept {
-                ::operator delete(p);
-            }
-        };
-    }
-
-    // DIRTY VECTOR + FILE STREAM UTILITIES ------------------------------------
-    namespace io {
-
-        template<binary_readable Type = u8>
-        using dirty_vector = std::vector<Type, details::vec_init_allocator<Type>>;
-
-        enum class origin : u8
-        {
-            begin  = 0,
-            current,
-            end    ,
-        };
-
-        [[nodiscard]] constexpr std::ios_base::seekdir to_stl_seekdir(const origin dir) noexcept {
-            switch (dir) {
-                case origin::begin:   return std::ios_base::beg;
-                case origin::current: return std::ios_base::cur;
-                case origin::end:     return std::ios_base::end;
-            }
-
-            return std::ios_base::beg;
-        }
-
-        inline void setpos(
-            std::istream& file,
-            const off_s offset,
-            const origin dir = origin::begin
-        ) noexcept {
-            file.seekg(
-                scast<std::streamoff>( offset.get() ),
-                to_stl_seekdir( dir )
-            );
-        }
-
-        template<binary_readable Type> [[nodiscard]]
-        std::expected<Type, std::errc> read(
-            std::istream& file,
-            const off_s offset = off_s{0},
-            const origin dir = origin::begin
-        ) noexcept {
-            Type value;
-            setpos(file, offset, dir);
-            file.read(rcast<char*>(&value), sizeof(Type));
-
-            if (file.fail()) [[unlikely]]
-                return std::unexpected(std::errc::io_error);
-
-            return value;
-        }
-
-
-        template<binary_readable Type>
-        std::expected<void, std::errc> read(
-            std::istream& file,
-            std::span<Type> out_buffer,
-            const off_s offset,
-            const origin dir = origin::begin
-        ) noexcept {
-            setpos(file, offset, dir);
-            file.read(
-                rcast<char*>(std::data(out_buffer)),
-                scast<std::streamsize>(sizeof(Type) * out_buffer.size())
-            );
-
-            if (file.fail()) [[unlikely]]
-                return std::unexpected(std::errc::io_error);
-
-            return {};
-        }
-
-
-        template<binary_readable Type = u8> [[nodiscard]]
-        std::expected<dirty_vector<Type>, std::errc> read(
-            std::istream&  file  ,
-            const off_s    offset,
-            const usize    count ,
-            const origin   dir   = origin::begin
-        ) {
-            dirty_vector<Type> vec(count);
-            auto result = read<Type>(file, std::span<std::type_identity_t<Type>>{vec}, offset, dir);
-            if (!result) [[unlikely]]
-                return std::unexpected(result.error());
-            return vec;
-        }
-
-
-        template<binary_readable Type, usize Size >
-        requires ( Size > 0 ) [[nodiscard]]
-        std::expected<std::array<Type, Size>, std::errc> read(
-            std::istream& file  ,
-            const off_s   offset = off_s{0},
-            const origin  dir = origin::begin
-        ) noexcept {
-            std::array<Type, Size> arr;
-            auto result = read<Type>(file, std::span<std::type_identity_t<Type>>{arr}, offset, dir);
-
-            if (!result) [[unlikely]]
-                return std::unexpected(result.error());
-
-            return arr;
-        }
-
-        inline
-        void advance(
-            std::istream& file,
-            const off_s offset
-        ) noexcept {
-            setpos(file, offset, origin::current);
-        }
-
-        // FILE WRITE UTILITIES ----------------------------------------------------
-        inline void setpos(
-            std::ostream& file,
-            const off_s offset,
-            const origin dir = origin::begin
-        ) noexcept {
-            file.seekp(
-                scast<std::streamoff>( offset.get() ),
-                to_stl_seekdir( dir )
-            );
-        }
-
-        template<binary_readable Type>
-            requires (not contiguous_buffer<Type>)
-        std::expected<void, std::errc> write(
-            std::ostream& file,
-            const off_s offset,
-            const Type& value,
-            const origin dir = origin::begin
-        ) noexcept {
-            setpos(file, offset, dir);
-            file.write(
-                rcast<const char*>(&value),
-                sizeof(Type)
-            );
-            if (file.fail()) [[unlikely]]
-                return std::unexpected(std::errc::io_error);
-            return {};
-        }
-
-        template<binary_readable Type>
-            requires (not contiguous_buffer<Type>)
-        std::expected<void, std::errc> write(
-            std::ostream& file,
-            const Type& value,
-            const origin dir = origin::begin
-        ) noexcept { return lbyte::stx::io::write( file, off_s{0}, value, dir ); }
-
-        template<contiguous_buffer R>
-        std::expected<void, std::errc> write(
-            std::ostream& file,
-            const off_s offset,
-            const R& buffer,
-            const origin dir = origin::begin
-        ) noexcept {
-            setpos(file, offset, dir);
-            auto const bytes = std::size(buffer) * sizeof(*std::data(buffer));
-            file.write(
-                rcast<const char*>(std::data(buffer)),
-                scast<std::streamsize>(bytes)
-            );
-            if (file.fail()) [[unlikely]]
-                return std::unexpected(std::errc::io_error);
-            return {};
-        }
-
-        template<contiguous_buffer R>
-        std::expected<void, std::errc> write(
-            std::ostream& file,
-            const R& buffer,
-            const origin dir = origin::begin
-        ) noexcept { return lbyte::stx::io::write( file, off_s{0}, buffer, dir ); }
-
-        void advance(
-            std::ostream& file,
-            const off_s offset
-        ) noexcept {
-            setpos(file, offset, origin::current);
-        }
-
-    } // namespace io
-
-    using io::origin;
-
-    // MAP_FILE -------------------------------------------------------------------
-
-    enum class map_flag : u8 {
-        none     = 0,
-        write    = 1 << 0,
-        exec     = 1 << 1,
-        shared   = 1 << 2,
-        priv     = 1 << 3,
-        populate = 1 << 4,
-    };
-
-    inline constexpr map_flag operator|(map_flag a, map_flag b) noexcept {
-        return static_cast<map_flag>(static_cast<u8>(a) | static_cast<u8>(b));
-    }
-
-    inline constexpr map_flag operator&(map_flag a, map_flag b) noexcept {
-        return static_cast<map_flag>(static_cast<u8>(a) & static_cast<u8>(b));
-    }
-
-    inline constexpr map_flag operator^(map_flag a, map_flag b) noexcept {
-        return static_cast<map_flag>(static_cast<u8>(a) ^ static_cast<u8>(b));
-    }
-
-    inline constexpr map_flag operator~(map_flag a) noexcept {
-        return static_cast<map_flag>(~static_cast<u8>(a));
-    }
-
-    inline constexpr map_flag& operator|=(map_flag& a, map_flag b) noexcept {
-        return a = a | b;
-    }
-
-    inline constexpr map_flag& operator&=(map_flag& a, map_flag b) noexcept {
-        return a = a & b;
-    }
-
-    inline constexpr map_flag& operator^=(map_flag& a, map_flag b) noexcept {
-        return a = a ^ b;
-    }
-
-    inline constexpr bool operator!(map_flag a) noexcept {
-        return static_cast<u8>(a) == 0;
-    }
-
-    // --- memcur<ByteType> (bounded cursor over a buffer) -----------------------
-
-    template<buffer_type ByteType = std::byte>
-    class memcur
-    {
-    protected:
-        ptr<ByteType>  base_;
-        usize          size_{};
-        ptr<ByteType>  cur_;
-
-    public:
-        memcur() noexcept = default;
-
-        memcur(memcur&& other) noexcept
-            : base_(std::exchange(other.base_, ptr<ByteType>{}))
-            , size_(std::exchange(other.size_, 0))
-            , cur_(std::exchange(other.cur_, ptr<ByteType>{}))
-        {}
-
-        constexpr memcur& operator=(memcur&& other) noexcept
-        {
-            if (this != &other) {
-                base_ = std::exchange(other.base_, ptr<ByteType>{});
-                size_ = std::exchange(other.size_, 0);
-                cur_  = std::exchange(other.cur_, ptr<ByteType>{});
-            }
-            return *this;
-        }
-
-        memcur(std::span<ByteType> buf) noexcept
-            : base_(buf.data())
-            , size_(buf.size())
-            , cur_(base_)
-        {}
-
-        memcur(ptr<ByteType> base, usize size) noexcept
-            : base_(base)
-            , size_(size)
-            , cur_(base_)
-        {}
-
-        template<typename Ptr>
-            requires std::is_pointer_v<Ptr>
-                  && std::convertible_to<Ptr, const void*>
-        [[nodiscard]] constexpr memcur(Ptr data, usize size) noexcept
-            : base_(data)
-            , size_(size)
-            , cur_(base_)
-        {}
-
-    protected:
-        // for inheritance: construct with cursor already positioned
-        memcur(ptr<ByteType> base, usize size, off_s pos) noexcept
-            : base_(base)
-            , size_(size)
-            , cur_(base + off_s{scast<off_s::value_type>(pos.get() < 0 ? 0 : pos.get())})
-        {
-            const auto position = pos.get();
-            auto target_offset = position < 0 ? 0 : position;
-
-            if (target_offset > scast<off_s::value_type>(size_))
-                target_offset = scast<off_s::value_type>(size_);
-
-            cur_ = base_ + off_s{target_offset};
-        }
-
-    public:
-        // --- state ---------------------------------------------------------
-
-        explicit operator bool() const noexcept { return base_.addr() != 0; }
-        usize size() const noexcept { return size_; }
-        uptr  base() const noexcept { return base_.addr(); }
-
-        void seek(off_s off, origin dir = origin::begin) noexcept {
-            auto const o = off.get();
-            off_s::value_type target_offset = 0;
-
-            switch (dir) {
-                case origin::begin:
-                    target_offset = o;
-                    break;
-                case origin::current:
-                    target_offset = tell().get() + o;
-                    break;
-                case origin::end:
-                    target_offset = scast<off_s::value_type>( size_ ) + o;
-                    break;
-            }
-
-            if ( target_offset < 0 )
-                target_offset = 0;
-            else if ( target_offset > scast<off_s::value_type>( size_ ))
-                target_offset = scast<off_s::value_type>(size_);
-
-            cur_ = base_ + off_s{target_offset};
-        }
-
-        void advance(const off_s offset) noexcept { seek(offset, origin::current); }
-
-        off_s tell() const noexcept { return cur_.diff(base_); }
-        off_s remaining() const noexcept {
-            auto rem = scast<off_s::value_type>(size_) - tell().get();
-            return off_s{rem < 0 ? off_s::value_type{0} : rem};
-        }
-
-        // --- pop (read + advance) ------------------------------------------
-
-        template<binary_readable T>
-        T pop() noexcept {
-            return cur_.template pop<T>();
-        }
-
-        template<bounded_array U>
-        details::bounded_array_t<U> pop() noexcept {
-            return cur_.template pop<U>();
-        }
-
-        // --- push (write + advance) ----------------------------------------
-
-        template<binary_readable T>
-            requires (!contiguous_buffer<T>) && (!std::is_const_v<ByteType>)
-        auto& push(const T& value) noexcept {
-            cur_.push(value);
-            return *this;
-        }
-
-        template<contiguous_buffer R>
-            requires (!std::is_const_v<ByteType>)
-        auto& push(R&& buf) noexcept {
-            cur_.push(std::forward<R>(buf));
-            return *this;
-        }
-
-        // --- zero-copy view (no advance) -----------------------------------
-
-        template<bounded_array U>
-        std::span<const std::remove_all_extents_t<U>> as_view() noexcept
-        {
-            using element_type = std::remove_all_extents_t<U>;
-            using flat_array = details::bounded_array_t<U>;
-            return std::span<const element_type>(
-                rcast<const element_type*>(cur_.addr()),
-                sizeof(flat_array) / sizeof(element_type)
-            );
-        }
-
-        template<binary_readable T>
-        std::span<const T> as_view(usize count) noexcept
-        {
-            return std::span<const T>( rcast<const T*>( cur_.addr() ), count );
-        }
-
-        // --- read into (no advance) / pop into (advance) -------------------
-
-        template<writable_buffer R>
-        void read_into(R&& buf) noexcept
-        {
-            auto const bytes = std::size(buf) * sizeof(*std::data(buf));
-            std::memcpy(
-                rcast<std::byte*>(std::data(buf)),
-                rcast<const std::byte*>(cur_.addr()),
-                static_cast<usize>(bytes)
-            );
-        }
-
-        template<writable_buffer R>
-        auto& pop_into(R&& buf) noexcept
-        {
-            auto const bytes = std::size(buf) * sizeof(*std::data(buf));
-            std::memcpy(
-                rcast<std::byte*>(std::data(buf)),
-                rcast<const std::byte*>(cur_.addr()),
-                static_cast<usize>(bytes)
-            );
-            cur_ += off_s{scast<off_s::value_type>(bytes)};
-            return *this;
-        }
-
-        std::string_view read_strvw() noexcept
-        {
-            return read_strvw(size_ - static_cast<usize>(tell().get()));
-        }
-
-        std::string_view read_strvw(usize max) noexcept
-        {
-            auto pos = static_cast<usize>(tell().get());
-            auto rem = size_ - pos;
-            auto avail = std::min(max, rem);
-            if (avail == 0) return {};
-            auto* base = rcast<const char*>(cur_.addr());
-            auto len = strnlen(base, avail);
-            cur_ = cur_ + off_s{scast<off_s::value_type>(len < avail ? len + 1 : avail)};
-            return {base, len};
-        }
-
-        template<typename T = ByteType>
-        [[nodiscard]] constexpr ptr<T> as_p() const noexcept
-        {
-            return ptr<T>(cur_.addr());
-        }
-
-        [[nodiscard]] constexpr std::span<ByteType> bytes() noexcept
-        {
-            auto const rem = remaining().get();
-            return std::span<ByteType>(rcast<ByteType*>(cur_.addr()), scast<usize>(rem < 0 ? 0 : rem));
-        }
-
-        [[nodiscard]] constexpr std::span<const ByteType> bytes() const noexcept
-        {
-            auto const rem = remaining().get();
-            return std::span<const ByteType>(rcast<const ByteType*>(cur_.addr()), scast<usize>(rem < 0 ? 0 : rem));
-        }
-    };
-
-    // --- deduction guides for memcur -----------------------------------------
-
-    template<lbyte::stx::buffer_type B>
-    memcur(B*, usize) -> memcur<B>;
-
-    template<typename T>
-        requires (!lbyte::stx::buffer_type<T>)
-    memcur(T*, usize) -> memcur<std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>>;
-
-    class map_file : private memcur<std::byte>
-    {
-        void*           raw_    = nullptr;  // mmap base (for unmap)
-        usize           raw_sz_ = 0;        // mapped size (for munmap)
-        map_flag        flags_{};
-
-        auto unmap() noexcept -> void;
-
-        struct sys_ctor_tag {};
-        map_file(sys_ctor_tag, void* raw, usize raw_sz, ptr<std::byte> data, usize sz, off_s pos, map_flag fl) noexcept
-            : memcur(data, sz, pos)
-            , raw_(raw), raw_sz_(raw_sz), flags_(fl)
-        {}
-
-        static auto sys_map(const std::filesystem::path&, usize offset, usize size, map_flag) noexcept
-            -> std::expected<map_file, std::errc>;
-
-    public:
-        map_file() noexcept = default;
-
-        map_file(map_file&& other) noexcept
-            : memcur(std::move(other))
-            , raw_(std::exchange(other.raw_, nullptr))
-            , raw_sz_(std::exchange(other.raw_sz_, 0))
-            , flags_(std::exchange(other.flags_, map_flag::none))
-        {}
-
-        auto operator=(map_file&& other) noexcept -> map_file&
-        {
-            if (this != &other) {
-                unmap();
-                memcur::operator=(std::move(other));
-                raw_    = std::exchange(other.raw_, nullptr);
-                raw_sz_ = std::exchange(other.raw_sz_, 0);
-                flags_  = std::exchange(other.flags_, map_flag::none);
-            }
-            return *this;
-        }
-
-        map_file(const map_file&) = delete;
-        auto operator=(const map_file&) -> map_file& = delete;
-
-        ~map_file() noexcept { unmap(); }
-
-        // --- factory -------------------------------------------------------
-
-        static auto open(const std::filesystem::path& path, map_flag flags = {}) noexcept
-            -> std::expected<map_file, std::errc>
-        {
-            return sys_map(path, 0, 0, flags);
-        }
-
-        static auto open(const std::filesystem::path& path, off_s offset, usize size, map_flag flags = {}) noexcept
-            -> std::expected<map_file, std::errc>
-        {
-            if (offset.get() < 0)
-                return std::unexpected(std::errc::invalid_argument);
-            return sys_map(path, static_cast<usize>(offset.get()), size, flags);
-        }
-
-        // --- re-exports from memcur ---------------------------------------
-
-        using memcur::operator bool;
-        using memcur::size;
-        using memcur::base;
-        using memcur::seek;
-        using memcur::advance;
-        using memcur::tell;
-        using memcur::remaining;
-        using memcur::pop;
-        using memcur::push;
-        using memcur::as_view;
-        using memcur::read_into;
-        using memcur::pop_into;
-        using memcur::read_strvw;
-        using memcur::bytes;
-        using memcur::as_p;
-
-        // --- map_file-specific --------------------------------------------
-
-        map_flag flags() const noexcept { return flags_; }
-        bool     is_alive() const noexcept { return memcur::operator bool(); }
-
-        void swap(map_file& other) noexcept
-        {
-            using std::swap;
-            swap(static_cast<memcur<std::byte>&>(*this), static_cast<memcur<std::byte>&>(other));
-            swap(raw_, other.raw_);
-            swap(raw_sz_, other.raw_sz_);
-            swap(flags_, other.flags_);
-        }
-
-        auto flush() noexcept -> std::expected<void, std::errc>
-        {
-            if (!raw_ || !(flags_ & map_flag::write))
-                return {};
-
-            #if defined(_WIN32)
-                if (FlushViewOfFile(raw_, raw_sz_) == 0) [[unlikely]] {
-                    return std::unexpected(std::errc::io_error);
-                }
-            #else // Linux / POSIX
-                if (::msync(raw_, raw_sz_, MS_SYNC) < 0) [[unlikely]] {
-                    return std::unexpected(std::errc::io_error);
-                }
-            #endif
-
-            return {};
-        }
-    };
-
-    // --- read/write overloads for map_file -------------------------------
-
-    namespace io {
-
-        template<binary_readable Type> [[nodiscard]]
-        std::expected<Type, std::errc> read(
-            const map_file& m,
-            const off_s offset
-        ) noexcept
-        {
-            auto const byte_off = offset.get();
-            if (byte_off + static_cast<off_s::value_type>(sizeof(Type)) > static_cast<off_s::value_type>(m.size()))
-                return std::unexpected(std::errc::argument_out_of_domain);
-            auto target = m.base() + static_cast<uptr>(byte_off);
-            return ptr<Type>(target).template read<Type>();
-        }
-
-        template<binary_readable Type>
-            requires (not contiguous_buffer<Type>)
-        std::expected<void, std::errc> write(
-            map_file& m,
-            const off_s offset,
-            const Type& value,
-            const origin dir = origin::begin
-        ) noexcept
-        {
-            if (!(m.flags() & map_flag::write))
-                return std::unexpected(std::errc::permission_denied);
-
-            off_s actual_off{0};
-            switch (dir) {
-                case origin::begin:   actual_off = offset; break;
-                case origin::current: actual_off = off_s{m.tell().get() + offset.get()}; break;
-                case origin::end:     actual_off = off_s{scast<off_s::value_type>(m.size()) + offset.get()}; break;
-            }
-
-            auto const byte_off = actual_off.get();
-            if (byte_off + static_cast<off_s::value_type>(sizeof(Type)) > static_cast<off_s::value_type>(m.size()))
-                return std::unexpected(std::errc::argument_out_of_domain);
-            auto target = m.base() + static_cast<uptr>(byte_off);
-            ptr<Type>(target).write(value);
-            return {};
-        }
-
-        template<binary_readable Type>
-            requires (not contiguous_buffer<Type>)
-        std::expected<void, std::errc> write(
-            map_file& m,
-            const Type& value,
-            const origin dir = origin::begin
-        ) noexcept { return lbyte::stx::io::write( m, off_s{0}, value, dir ); }
-
-        template<contiguous_buffer R>
-        std::expected<void, std::errc> write(
-            map_file& m,
-            const off_s offset,
-            const R& buffer,
-            const origin dir = origin::begin
-        ) noexcept
-        {
-            if (!(m.flags() & map_flag::write))
-                return std::unexpected(std::errc::permission_denied);
-
-            off_s actual_off{0};
-            switch (dir) {
-                case origin::begin:   actual_off = offset; break;
-                case origin::current: actual_off = off_s{m.tell().get() + offset.get()}; break;
-                case origin::end:     actual_off = off_s{scast<off_s::value_type>(m.size()) + offset.get()}; break;
-            }
-
-            auto const byte_off = actual_off.get();
-            auto const bytes = std::size(buffer) * sizeof(*std::data(buffer));
-            if (byte_off + static_cast<off_s::value_type>(bytes) > static_cast<off_s::value_type>(m.size()))
-                return std::unexpected(std::errc::argument_out_of_domain);
-            auto target = rcast<void*>(m.base() + static_cast<uptr>(byte_off));
-            std::memcpy(target, rcast<const void*>(std::data(buffer)), static_cast<usize>(bytes));
-            return {};
-        }
-
-        template<contiguous_buffer R>
-        std::expected<void, std::errc> write(
-            map_file& m,
-            const R& buffer,
-            const origin dir = origin::begin
-        ) noexcept { return lbyte::stx::io::write( m, off_s{0}, buffer, dir ); }
-
-        // --- read overloads for spans (positional, no reader_view needed) -
-
-        template<binary_readable Type> [[nodiscard]]
-        std::expected<Type, std::errc> read(
-            std::span<const std::byte> buf,
-            const off_s offset = off_s{0}
-        ) noexcept
-        {
-            auto end = offset.get() + static_cast<off_s::value_type>(sizeof(Type));
-            if (end > static_cast<off_s::value_type>(buf.size()))
-                return std::unexpected(std::errc::argument_out_of_domain);
-            Type val;
-            std::memcpy(&val, buf.data() + offset.get(), sizeof(Type));
-            return val;
-        }
-
-    } // namespace io
-
-    // --- platform ------------------------------------------------------------
-
-    #if defined(_WIN32)
-
-        inline auto map_file::sys_map(
-            const std::filesystem::path& path,
-            usize offset,
-            usize size,
-            map_flag flags
-        ) noexcept -> std::expected<map_file, std::errc>
-        {
-            DWORD dwDesiredAccess = GENERIC_READ;
-            DWORD flProtect = PAGE_READONLY;
-            DWORD dwFileMapAccess = FILE_MAP_READ;
-
-            if ((flags & map_flag::write) != map_flag::none) {
-                dwDesiredAccess |= GENERIC_WRITE;
-                if ((flags & map_flag::priv) != map_flag::none) {
-                    flProtect = PAGE_WRITECOPY;
-                    dwFileMapAccess = FILE_MAP_COPY;
-                } else {
-                    flProtect = PAGE_READWRITE;
-                    dwFileMapAccess = FILE_MAP_ALL_ACCESS;
-                }
-            }
-            if ((flags & map_flag::exec) != map_flag::none) {
-                if ((flags & map_flag::write) != map_flag::none) {
-                    if ((flags & map_flag::priv) != map_flag::none) {
-                        flProtect = PAGE_EXECUTE_WRITECOPY;
-                    } else {
-                        flProtect = PAGE_EXECUTE_READWRITE;
-                    }
-                } else {
-                    flProtect = PAGE_EXECUTE_READ;
-                }
-                dwFileMapAccess = FILE_MAP_EXECUTE | (dwFileMapAccess & ~FILE_MAP_COPY);
-                if ((flags & map_flag::priv) != map_flag::none) dwFileMapAccess |= FILE_MAP_COPY;
-            }
-            if ((flags & map_flag::shared) != map_flag::none) {
-                if ((flags & map_flag::priv) != map_flag::none)
-                    return std::unexpected(std::errc::invalid_argument);
-            }
-            if ((flags & map_flag::priv) != map_flag::none) {
-                dwDesiredAccess |= GENERIC_WRITE;
-            }
-
-            HANDLE hFile = CreateFileW(
-                path.c_str(),
-                dwDesiredAccess,
-                FILE_SHARE_READ,
-                nullptr,
-                OPEN_EXISTING,
-                FILE_ATTRIBUTE_NORMAL,
-                nullptr
-            );
-            if (hFile == INVALID_HANDLE_VALUE)
-                return std::unexpected(std::errc::no_such_file_or_directory);
-
-            LARGE_INTEGER fileSize;
-            if (!GetFileSizeEx(hFile, &fileSize)) {
-                CloseHandle(hFile);
-                return std::unexpected(std::errc::io_error);
-            }
-
-            usize file_size = static_cast<usize>(fileSize.QuadPart);
-            if ( file_size == 0 ) {
-                CloseHandle(hFile);
-                return map_file(sys_ctor_tag{}, nullptr, 0, ptr<std::byte>{}, 0, off_s{0}, flags);
-            }
-
-            if (offset > file_size) {
-                CloseHandle(hFile);
-                return std::unexpected(std::errc::argument_out_of_domain);
-            }
-
-            if ( size == 0 )
-                size = file_size - offset;
-
-            if ( size > file_size - offset ) {
-                CloseHandle(hFile);
-                return std::unexpected(std::errc::argument_out_of_domain);
-            }
-
-            // MapViewOfFile requires offset to be aligned to allocation granularity
-            SYSTEM_INFO si;
-            GetSystemInfo(&si);
-            usize gran = static_cast<usize>(si.dwAllocationGranularity);
-            usize align_off = (offset / gran) * gran;
-            usize delta = offset - align_off;
-            usize view_sz = size + delta;
-
-            DWORD dwFileOffsetLow  = static_cast<DWORD>(align_off & 0xFFFFFFFF);
-            DWORD dwFileOffsetHigh = static_cast<DWORD>((align_off >> 32) & 0xFFFFFFFF);
-
-            HANDLE hMap = CreateFileMappingW(
-                hFile,
-                nullptr,
-                flProtect,
-                0, 0,
-                nullptr
-            );
-            if (!hMap) {
-                CloseHandle(hFile);
-                return std::unexpected(std::errc::io_error);
-            }
-
-            void* raw = MapViewOfFile(
-                hMap,
-                dwFileMapAccess,
-                dwFileOffsetHigh,
-                dwFileOffsetLow,
-                view_sz
-            );
-
-            CloseHandle(hMap);
-            CloseHandle(hFile);
-
-            if (!raw)
-                return std::unexpected(std::errc::io_error);
-
-            auto* data = static_cast<std::byte*>(raw) + delta;
-            return map_file(sys_ctor_tag{}, raw, view_sz, data, size, off_s{0}, flags);
-        }
-
-        inline auto map_file::unmap() noexcept -> void
-        {
-            if (raw_) UnmapViewOfFile(raw_);
-        }
-
-    #else // Linux / POSIX
-
-        inline auto map_file::sys_map(
-            const std::filesystem::path& path,
-            usize offset,
-            usize size,
-            map_flag flags
-        ) noexcept -> std::expected<map_file, std::errc>
-        {
-            if ((flags & map_flag::shared) != map_flag::none && (flags & map_flag::priv) != map_flag::none)
-                return std::unexpected(std::errc::invalid_argument);
-
-            int oflags = O_RDONLY;
-            int prot   = PROT_READ;
-            int mflags = MAP_PRIVATE;
-
-            if (!!(flags & map_flag::write)) {
-                oflags = O_RDWR;
-                prot |= PROT_WRITE;
-                mflags = MAP_SHARED;
-            }
-            if (!!(flags & map_flag::exec)) {
-                prot |= PROT_EXEC;
-            }
-            if (!!(flags & map_flag::shared)) {
-                mflags = MAP_SHARED;
-            }
-            if (!!(flags & map_flag::priv)) {
-                mflags = MAP_PRIVATE;
-            }
-            if (!!(flags & map_flag::populate)) {
-                mflags |= MAP_POPULATE;
-            }
-
-            int fd = ::open(path.c_str(), oflags);
-            if (fd < 0)
-                return std::unexpected(std::errc::no_such_file_or_directory);
-
-            struct stat st;
-            if (::fstat(fd, &st) < 0) {
-                ::close(fd);
-                return std::unexpected(std::errc::io_error);
-            }
-
-            usize file_size = static_cast<usize>(st.st_size);
-            if (file_size == 0) {
-                ::close(fd);
-                return map_file(sys_ctor_tag{}, nullptr, 0, ptr<std::byte>{}, 0, off_s{0}, flags);
-            }
-
-            if (offset > file_size) {
-                ::close(fd);
-                return std::unexpected(std::errc::argument_out_of_domain);
-            }
-
-            if (size == 0) size = file_size - offset;
-            if (size > file_size - offset) {
-                ::close(fd);
-                return std::unexpected(std::errc::argument_out_of_domain);
-            }
-
-            // mmap requires page-aligned offset
-            long page = sysconf(_SC_PAGE_SIZE);
-            if (page <= 0) page = 4096;
-            usize align_off = (offset / static_cast<usize>(page)) * static_cast<usize>(page);
-            usize delta = offset - align_off;
-            usize map_sz = size + delta;
-
-            void* raw = ::mmap(
-                nullptr,
-                map_sz,
-                prot,
-                mflags,
-                fd,
-                static_cast<off_t>(align_off)
-            );
-
-            ::close(fd);
-
-            if (raw == MAP_FAILED)
-                return std::unexpected(std::errc::io_error);
-
-            auto* data = static_cast<std::byte*>(raw) + delta;
-            return map_file(sys_ctor_tag{}, raw, map_sz, data, size, off_s{0}, flags);
-        }
-
-        inline auto map_file::unmap() noexcept -> void
-        {
-            if (raw_) ::munmap(raw_, raw_sz_);
-        }
-
-    #endif
-
-}
-
+// Umbrella for the io surface. Each piece can be included on its own:
+//   io_base.hpp    dirty_vector
+//   io_stream.hpp  io::read / write / setpos / advance over std::istream / std::ostream
+//   memcur.hpp     memcur (core, ct and mem only)
+//   map_file.hpp   map_file, map_flag, map_advice
+#include "./io_base.hpp"        // IWYU pragma: export
+#include "./io_stream.hpp"      // IWYU pragma: export
+#include "./memcur.hpp"         // IWYU pragma: export
+#include "./map_file.hpp"       // IWYU pragma: export
@@ -0,0 +1,82 @@
+#pragma once
+#include "./core.hpp"
+
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Shared by the io headers: dirty_vector. io::origin lives in core.hpp so
+// memcur can use it without this header. Pulls in no stream, filesystem or OS
+// headers.
+
+namespace lbyte::stx
+{
+    // ALLOCATOR ----------------------------------------------------------------
+    namespace details
+    {
+        template<typename A>
+        concept allocator_like = requires( A& a, usize n ) {
+            typename A::value_type;
+            a.allocate( n );
+        };
+
+        // Default-initializes on value construction; everything else goes to Base
+        template<typename T, typename Base = std::allocator<T>>
+        class vec_init_allocator
+            : public std::allocator_traits<Base>::template rebind_alloc<T>
+        {
+            using base_type = typename std::allocator_traits<Base>::template rebind_alloc<T>;
+
+        public:
+            using value_type = T;
+
+            template<typename U>
+            struct rebind {
+                using other = vec_init_allocator<U, typename std::allocator_traits<Base>::template rebind_alloc<U>>;
+            };
+
+            using base_type::base_type;
+
+            vec_init_allocator() = default;
+
+            vec_init_allocator(const base_type& base) noexcept
+                : base_type(base) {}
+
+            template<typename U, typename B>
+            vec_init_allocator(const vec_init_allocator<U, B>& other) noexcept
+                : base_type(static_cast<const B&>(other)) {}
+
+            template<typename U>
+            void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>) {
+                if constexpr (std::is_default_constructible_v<U>) {
+                    ::new(static_cast<void*>(ptr)) U;
+                }
+            }
+
+            template<typename U, typename... Args>
+            void construct(U* ptr, Args&&... args) {
+                ::new(static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+            }
+
+            friend bool operator==(const vec_init_allocator& a, const vec_init_allocator& b) noexcept {
+                return static_cast<const base_type&>(a) == static_cast<const base_type&>(b);
+            }
+        };
+    }
+
+    // DIRTY VECTOR -------------------------------------------------------------
+    namespace io {
+
+        // Alloc: any allocator (rebound to Type), e.g. mem::arena_allocator
+        template<binary_readable Type = u8, typename Alloc = std::allocator<Type>>
+        using dirty_vector = std::vector<Type, details::vec_init_allocator<Type, Alloc>>;
+
+        namespace pmr {
+            template<binary_readable Type = u8>
+            using dirty_vector = io::dirty_vector<Type, std::pmr::polymorphic_allocator<Type>>;
+        }
+
+    } // namespace io
+}
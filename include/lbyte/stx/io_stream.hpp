@@ -0,0 +1,207 @@
+#pragma once
+#include "./core.hpp"
+#include "./io_base.hpp"
+#include "./stats.hpp"
+
+#include <array>
+#include <expected>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <system_error>
+
+namespace lbyte::stx
+{
+    // FILE STREAM UTILITIES ------------------------------------------------------
+    namespace io {
+
+        [[nodiscard]] constexpr std::ios_base::seekdir to_stl_seekdir(const origin dir) noexcept {
+            switch (dir) {
+                case origin::begin:   return std::ios_base::beg;
+                case origin::current: return std::ios_base::cur;
+                case origin::end:     return std::ios_base::end;
+            }
+
+            return std::ios_base::beg;
+        }
+
+        inline void setpos(
+            std::istream& file,
+            const off_s offset,
+            const origin dir = origin::begin
+        ) noexcept {
+            file.seekg(
+                scast<std::streamoff>( offset.get() ),
+                to_stl_seekdir( dir )
+            );
+        }
+
+        template<binary_readable Type> [[nodiscard]]
+        std::expected<Type, std::errc> read(
+            std::istream& file,
+            const off_s offset = off_s{0},
+            const origin dir = origin::begin
+        ) noexcept {
+            Type value;
+            setpos(file, offset, dir);
+            file.read(rcast<char*>(&value), sizeof(Type));
+            stats::on_read(sizeof(Type), scast<usize>(file.gcount()), file.fail());
+
+            if (file.fail()) [[unlikely]]
+                return std::unexpected(std::errc::io_error);
+
+            return value;
+        }
+
+
+        template<binary_readable Type>
+        std::expected<void, std::errc> read(
+            std::istream& file,
+            std::span<Type> out_buffer,
+            const off_s offset,
+            const origin dir = origin::begin
+        ) noexcept {
+            setpos(file, offset, dir);
+            file.read(
+                rcast<char*>(std::data(out_buffer)),
+                scast<std::streamsize>(sizeof(Type) * out_buffer.size())
+            );
+            stats::on_read(out_buffer.size_bytes(), scast<usize>(file.gcount()), file.fail());
+
+            if (file.fail()) [[unlikely]]
+                return std::unexpected(std::errc::io_error);
+
+            return {};
+        }
+
+
+        template<binary_readable Type = u8> [[nodiscard]]
+        std::expected<dirty_vector<Type>, std::errc> read(
+            std::istream&  file  ,
+            const off_s    offset,
+            const usize    count ,
+            const origin   dir   = origin::begin
+        ) {
+            dirty_vector<Type> vec(count);
+            auto result = read<Type>(file, std::span<std::type_identity_t<Type>>{vec}, offset, dir);
+            if (!result) [[unlikely]]
+                return std::unexpected(result.error());
+            return vec;
+        }
+
+        // same, allocating from `alloc` (e.g. an arena for the whole parse)
+        template<binary_readable Type = u8, details::allocator_like Alloc> [[nodiscard]]
+        std::expected<dirty_vector<Type, Alloc>, std::errc> read(
+            std::istream&  file  ,
+            const off_s    offset,
+            const usize    count ,
+            const Alloc&   alloc ,
+            const origin   dir   = origin::begin
+        ) {
+            dirty_vector<Type, Alloc> vec(count, alloc);
+            auto result = read<Type>(file, std::span<std::type_identity_t<Type>>{vec}, offset, dir);
+            if (!result) [[unlikely]]
+                return std::unexpected(result.error());
+            return vec;
+        }
+
+
+        template<binary_readable Type, usize Size >
+        requires ( Size > 0 ) [[nodiscard]]
+        std::expected<std::array<Type, Size>, std::errc> read(
+            std::istream& file  ,
+            const off_s   offset = off_s{0},
+            const origin  dir = origin::begin
+        ) noexcept {
+            std::array<Type, Size> arr;
+            auto result = read<Type>(file, std::span<std::type_identity_t<Type>>{arr}, offset, dir);
+
+            if (!result) [[unlikely]]
+                return std::unexpected(result.error());
+
+            return arr;
+        }
+
+        inline
+        void advance(
+            std::istream& file,
+            const off_s offset
+        ) noexcept {
+            setpos(file, offset, origin::current);
+        }
+
+        // FILE WRITE UTILITIES ----------------------------------------------------
+        inline void setpos(
+            std::ostream& file,
+            const off_s offset,
+            const origin dir = origin::begin
+        ) noexcept {
+            file.seekp(
+                scast<std::streamoff>( offset.get() ),
+                to_stl_seekdir( dir )
+            );
+        }
+
+        template<binary_readable Type>
+            requires (not contiguous_buffer<Type>)
+        std::expected<void, std::errc> write(
+            std::ostream& file,
+            const off_s offset,
+            const Type& value,
+            const origin dir = origin::begin
+        ) noexcept {
+            setpos(file, offset, dir);
+            file.write(
+                rcast<const char*>(&value),
+                sizeof(Type)
+            );
+            stats::on_write(sizeof(Type), file.fail() ? 0 : sizeof(Type), file.fail());
+            if (file.fail()) [[unlikely]]
+                return std::unexpected(std::errc::io_error);
+            return {};
+        }
+
+        template<binary_readable Type>
+            requires (not contiguous_buffer<Type>)
+        std::expected<void, std::errc> write(
+            std::ostream& file,
+            const Type& value,
+            const origin dir = origin::begin
+        ) noexcept { return lbyte::stx::io::write( file, off_s{0}, value, dir ); }
+
+        template<contiguous_buffer R>
+        std::expected<void, std::errc> write(
+            std::ostream& file,
+            const off_s offset,
+            const R& buffer,
+            const origin dir = origin::begin
+        ) noexcept {
+            setpos(file, offset, dir);
+            auto const bytes = std::size(buffer) * sizeof(*std::data(buffer));
+            file.write(
+                rcast<const char*>(std::data(buffer)),
+                scast<std::streamsize>(bytes)
+            );
+            stats::on_write(bytes, file.fail() ? 0 : bytes, file.fail());
+            if (file.fail()) [[unlikely]]
+                return std::unexpected(std::errc::io_error);
+            return {};
+        }
+
+        template<contiguous_buffer R>
+        std::expected<void, std::errc> write(
+            std::ostream& file,
+            const R& buffer,
+            const origin dir = origin::begin
+        ) noexcept { return lbyte::stx::io::write( file, off_s{0}, buffer, dir ); }
+
+        inline
+        void advance(
+            std::ostream& file,
+            const off_s offset
+        ) noexcept {
+            setpos(file, offset, origin::current);
+        }
+
+    } // namespace io
+}
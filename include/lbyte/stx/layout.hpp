@@ -0,0 +1,425 @@
+#pragma once
+#include "core.hpp"
+#include "mem.hpp"
+#include "endian.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx::layout
+{
+    namespace details
+    {
+        template<typename M>
+        struct member_traits;
+
+        template<typename C, typename M>
+        struct member_traits<M C::*>
+        {
+            using class_type = C;
+            using type       = M;
+        };
+
+        // column element for a member: T[N] -> std::array<T, N>
+        template<typename M>
+        using column_t = ::lbyte::stx::details::bounded_array_t<M>;
+
+        // wire W stored in the same bytes as member M: decode is a plain copy
+        template<typename W, typename M>
+        inline constexpr bool same_repr = sizeof(W) == sizeof(M)
+            && ( std::is_same_v<W, M> || std::is_array_v<M> || std::is_array_v<W> );
+
+        // native type carried by a wire type: endian_value<T, O> -> T
+        template<typename W>
+        struct wire_native { using type = W; };
+
+        template<endian::compatible T, endian::order O>
+        struct wire_native<endian::endian_value<T, O>> { using type = T; };
+
+        template<typename W>
+        using wire_native_t = typename wire_native<W>::type;
+
+        template<typename M, typename V>
+        STX_FORCE_INLINE void assign( M& dst, const V& src ) noexcept
+        {
+            if constexpr ( std::is_array_v<M> || std::is_array_v<V> )
+                std::memcpy( &dst, &src, sizeof( M ));
+            else
+                dst = src;
+        }
+    }
+
+    // --- items -----------------------------------------------------------------
+    // field<&T::m, Wire>        : T::m stored as Wire (le<u32>, be<u16>, u8[8], ...)
+    //                             next to the previous item; Wire defaults to the
+    //                             member type (native order)
+    // field_at<Off, &T::m, Wire>: same, at a fixed record offset
+    // skip<N>                   : N reserved bytes
+
+    template<auto Member, typename Wire = void>
+    struct field
+    {
+        using class_type = typename details::member_traits<decltype( Member )>::class_type;
+        using value_type = typename details::member_traits<decltype( Member )>::type;
+        using wire_type  = std::conditional_t<std::is_void_v<Wire>, value_type, Wire>;
+
+        static_assert( binary_readable<wire_type>, "layout::field: wire type must be binary_readable" );
+
+        static constexpr bool                is_field = true;
+        static constexpr auto                member   = Member;
+        static constexpr off_s::value_type   at       = -1;
+        static constexpr usize               width    = sizeof( wire_type );
+        static constexpr usize               align    = alignof( wire_type );
+
+        [[nodiscard]] STX_FORCE_INLINE
+        static value_type& ref( class_type& o ) noexcept { return o.*Member; }
+
+        [[nodiscard]] STX_FORCE_INLINE
+        static const value_type& ref( const class_type& o ) noexcept { return o.*Member; }
+
+        STX_FORCE_INLINE
+        static void load( class_type& out, const std::byte* p ) noexcept
+        {
+            if constexpr ( endian::is_endian_value_v<wire_type> ) {
+                wire_type w;
+                std::memcpy( &w, p, width );
+                ref( out ) = static_cast<value_type>( w.get() );
+            } else if constexpr ( details::same_repr<wire_type, value_type> ) {
+                std::memcpy( &ref( out ), p, width );
+            } else {
+                wire_type w;
+                std::memcpy( &w, p, width );
+                ref( out ) = static_cast<value_type>( w );
+            }
+        }
+
+        STX_FORCE_INLINE
+        static void store( const class_type& in, std::byte* p ) noexcept
+        {
+            if constexpr ( details::same_repr<wire_type, value_type> ) {
+                std::memcpy( p, &ref( in ), width );
+            } else {
+                wire_type const w{ static_cast<details::wire_native_t<wire_type>>( ref( in )) };
+                std::memcpy( p, &w, width );
+            }
+        }
+    };
+
+    template<off_s::value_type Offset, auto Member, typename Wire = void>
+    struct field_at : field<Member, Wire>
+    {
+        static_assert( Offset >= 0, "layout::field_at: negative offset" );
+        static constexpr off_s::value_type at = Offset;
+    };
+
+    template<usize N>
+    struct skip
+    {
+        using class_type = void;
+        using wire_type  = std::array<std::byte, N>;
+
+        static constexpr bool              is_field = false;
+        static constexpr off_s::value_type at       = -1;
+        static constexpr usize             width    = N;
+        static constexpr usize             align    = 1;
+
+        template<typename C> STX_FORCE_INLINE static void load( C&, const std::byte* ) noexcept {}
+        template<typename C> STX_FORCE_INLINE static void store( const C&, std::byte* ) noexcept {}
+    };
+
+    // --- record ------------------------------------------------------------------
+    // Offsets are resolved at compile time; decode() is one fixed-offset load per
+    // field with the byte swap folded in (bswap / movbe), encode() the reverse.
+    //   record        : packed, items follow each other (wire formats)
+    //   natural_record: C struct alignment of the wire types (in-memory structs)
+
+    template<bool Natural, typename Dest, typename... Items>
+    struct basic_record
+    {
+        static_assert( (( std::is_void_v<typename Items::class_type> || std::is_same_v<typename Items::class_type, Dest> ) && ... ),
+                       "layout::record: field of another type" );
+
+        using value_type = Dest;
+        using items      = std::tuple<Items...>;
+
+        template<usize I>
+        using item = std::tuple_element_t<I, items>;
+
+        static constexpr usize count = sizeof...( Items );
+
+        static constexpr std::array<usize, count> offsets = [] {
+            std::array<usize, count> out{};
+            usize pos = 0, i = 0;
+            ( [&] {
+                if constexpr ( Items::at >= 0 )
+                    pos = scast<usize>( Items::at );
+                else if constexpr ( Natural )
+                    pos = mem::align_up( pos, Items::align );
+                out[i++] = pos;
+                pos += Items::width;
+            }(), ... );
+            return out;
+        }();
+
+        static constexpr usize alignment = std::max( { usize{ 1 }, Items::align... } );
+
+        // bytes one record spans (the array stride)
+        static constexpr usize size = [] {
+            usize end = 0, i = 0;
+            ( ( end = std::max( end, offsets[i++] + Items::width )), ... );
+            return Natural ? mem::align_up( end, alignment ) : end;
+        }();
+
+        // without explicit offsets the layout is exactly gap_v / gap_align_v
+        static_assert( (( Items::at >= 0 ) || ... ) || size == scast<usize>(
+            ( Natural ? mem::gap_align_v<alignment, typename Items::wire_type...>
+                      : mem::gap_v<typename Items::wire_type...> ).get() ));
+
+        template<usize I>
+        static constexpr off_s offset_v = off_s{ scast<off_s::value_type>( offsets[I] ) };
+
+        // index of the item describing `Member`
+        template<auto Member>
+        static constexpr usize index_of = [] {
+            usize i = 0, hit = count;
+            ( [&] {
+                if constexpr ( Items::is_field ) {
+                    if constexpr ( std::is_same_v<std::remove_cv_t<decltype( Items::member )>, decltype( Member )> )
+                        if ( Items::member == Member && hit == count ) hit = i;
+                }
+                ++i;
+            }(), ... );
+            return hit;
+        }();
+
+        // --- single record -------------------------------------------------
+
+        template<address_like Addr> [[nodiscard]] STX_FORCE_INLINE
+        static Dest decode( Addr src ) noexcept
+        {
+            auto const* p = rcast<const std::byte*>( normalize_addr( src ));
+            Dest out{};
+            [&]<usize... I>( std::index_sequence<I...> ) {
+                ( item<I>::load( out, p + offsets[I] ), ... );
+            }( std::make_index_sequence<count>{} );
+            return out;
+        }
+
+        template<address_like Addr> STX_FORCE_INLINE
+        static void encode( const Dest& in, Addr dst ) noexcept
+        {
+            auto* p = rcast<std::byte*>( normalize_addr( dst ));
+            [&]<usize... I>( std::index_sequence<I...> ) {
+                ( item<I>::store( in, p + offsets[I] ), ... );
+            }( std::make_index_sequence<count>{} );
+        }
+
+        // one size-byte pop from a memcur / stream_cur, then decode from registers
+        template<typename Cur> [[nodiscard]] STX_FORCE_INLINE
+        static Dest pop( Cur& cur ) noexcept
+        {
+            auto const raw = cur.template pop<std::array<std::byte, size>>();
+            return decode( raw.data() );
+        }
+
+        // --- arrays (stride = size) ----------------------------------------
+
+        template<address_like Addr>
+        static void decode_n( Addr src, std::span<Dest> out ) noexcept
+        {
+            auto const* p = rcast<const std::byte*>( normalize_addr( src ));
+            for ( auto& o : out ) {
+                o = decode( p );
+                p += size;
+            }
+        }
+
+        template<address_like Addr>
+        static void encode_n( std::span<const Dest> in, Addr dst ) noexcept
+        {
+            auto* p = rcast<std::byte*>( normalize_addr( dst ));
+            for ( auto const& i : in ) {
+                encode( i, p );
+                p += size;
+            }
+        }
+    };
+
+    template<typename Dest, typename... Items>
+    using record = basic_record<false, Dest, Items...>;
+
+    template<typename Dest, typename... Items>
+    using natural_record = basic_record<true, Dest, Items...>;
+
+    // --- soa (one column per field) ----------------------------------------------
+    // Table decode reads field by field: each column is a strided gather followed
+    // by one vectorized endian pass (endian::convert_endian) instead of a swap per
+    // element.
+
+    namespace details
+    {
+        template<typename R, typename Seq = std::make_index_sequence<R::count>>
+        struct field_indices;
+
+        template<typename R, usize... I>
+        struct field_indices<R, std::index_sequence<I...>>
+        {
+            static constexpr usize n = ( usize{ R::template item<I>::is_field } + ... + 0 );
+
+            static constexpr std::array<usize, n> value = [] {
+                std::array<usize, n> out{};
+                usize k = 0;
+                ( [&] { if constexpr ( R::template item<I>::is_field ) out[k++] = I; }(), ... );
+                return out;
+            }();
+        };
+
+        template<typename R, usize K>
+        using soa_item = typename R::template item<field_indices<R>::value[K]>;
+
+        template<typename R, template<typename> class Alloc, typename Seq = std::make_index_sequence<field_indices<R>::n>>
+        struct soa_columns;
+
+        template<typename R, template<typename> class Alloc, usize... K>
+        struct soa_columns<R, Alloc, std::index_sequence<K...>>
+        {
+            using type = std::tuple<std::vector<
+                column_t<typename soa_item<R, K>::value_type>,
+                Alloc<column_t<typename soa_item<R, K>::value_type>>>...>;
+        };
+    }
+
+    template<typename R, template<typename> class Alloc = std::allocator>
+    class soa
+    {
+        using indices = details::field_indices<R>;
+
+        typename details::soa_columns<R, Alloc>::type cols_;
+
+        template<usize K, typename Col>
+        static void gather( Col& col, usize first, const std::byte* src, usize n ) noexcept
+        {
+            using it    = details::soa_item<R, K>;
+            using wire  = typename it::wire_type;
+            using value = typename it::value_type;
+            constexpr usize off = R::offsets[indices::value[K]];
+
+            auto* out = col.data() + first;
+            if constexpr ( details::same_repr<wire, value> || endian::is_endian_value_v<wire> ) {
+                // endian fields whose native type is the member type: copy raw, swap once
+                constexpr bool raw_copy = !endian::is_endian_value_v<wire>
+                    || std::is_same_v<details::wire_native_t<wire>, value>;
+
+                if constexpr ( raw_copy ) {
+                    for ( usize i = 0; i < n; ++i )
+                        std::memcpy( out + i, src + i * R::size + off, it::width );
+                    if constexpr ( endian::is_endian_value_v<wire> ) {
+                        if constexpr ( wire::needs_swap )
+                            endian::convert_endian( std::span<value>{ out, n } );
+                    }
+                    return;
+                }
+            }
+            for ( usize i = 0; i < n; ++i ) {
+                typename R::value_type tmp;
+                it::load( tmp, src + i * R::size + off );
+                details::assign( out[i], it::ref( tmp ));
+            }
+        }
+
+    public:
+        using record_type = R;
+        using value_type  = typename R::value_type;
+
+        static constexpr usize columns = indices::n;
+
+        soa() = default;
+
+        // every column allocates from `alloc` (rebound), e.g. an arena_allocator
+        template<typename A>
+        explicit soa( const A& alloc )
+            : soa( alloc, std::make_index_sequence<columns>{} )
+        {}
+
+        [[nodiscard]] usize size()  const noexcept { return std::get<0>( cols_ ).size(); }
+        [[nodiscard]] bool  empty() const noexcept { return size() == 0; }
+
+        void reserve( usize n ) { std::apply( [n]( auto&... c ) { ( c.reserve( n ), ... ); }, cols_ ); }
+        void resize ( usize n ) { std::apply( [n]( auto&... c ) { ( c.resize( n ), ... ); }, cols_ ); }
+        void clear() noexcept   { std::apply( []( auto&... c ) { ( c.clear(), ... ); }, cols_ ); }
+
+        // K-th field column (skips are not counted)
+        template<usize K> [[nodiscard]] auto&       get()       noexcept { return std::get<K>( cols_ ); }
+        template<usize K> [[nodiscard]] const auto& get() const noexcept { return std::get<K>( cols_ ); }
+
+        // column of `Member`
+        template<auto Member> [[nodiscard]] auto& column() noexcept
+        {
+            return std::get<find<Member>()>( cols_ );
+        }
+
+        template<auto Member> [[nodiscard]] const auto& column() const noexcept
+        {
+            return std::get<find<Member>()>( cols_ );
+        }
+
+        // row i, reassembled
+        [[nodiscard]] value_type row( usize i ) const
+        {
+            value_type out{};
+            [&]<usize... K>( std::index_sequence<K...> ) {
+                ( details::assign( details::soa_item<R, K>::ref( out ), std::get<K>( cols_ )[i] ), ... );
+            }( std::make_index_sequence<columns>{} );
+            return out;
+        }
+
+        // append the `n` records at `src` (stride R::size)
+        template<address_like Addr>
+        void append( Addr src, usize n )
+        {
+            auto const* p     = rcast<const std::byte*>( normalize_addr( src ));
+            auto const  first = size();
+            resize( first + n );
+            [&]<usize... K>( std::index_sequence<K...> ) {
+                ( gather<K>( std::get<K>( cols_ ), first, p, n ), ... );
+            }( std::make_index_sequence<columns>{} );
+        }
+
+        // append every whole record in `src`
+        void append( std::span<const std::byte> src )
+        {
+            append( src.data(), src.size() / R::size );
+        }
+
+    private:
+        template<typename A, usize... K>
+        soa( const A& alloc, std::index_sequence<K...> )
+            : cols_{ std::tuple_element_t<K, decltype( cols_ )>( alloc )... }
+        {}
+
+        template<auto Member>
+        static consteval usize find()
+        {
+            constexpr usize item_index = R::template index_of<Member>;
+            static_assert( item_index < R::count, "layout::soa: member not in record" );
+            for ( usize k = 0; k < columns; ++k )
+                if ( indices::value[k] == item_index ) return k;
+            return columns;
+        }
+    };
+}
+
+#undef STX_FORCE_INLINE
@@ -1,6 +1,8 @@
 #pragma once
 #include "./mem.hpp"
 #include "./endian.hpp"
+#include "./ct.hpp"
+#include "./hash.hpp"
 
 namespace lbyte::stx::literals
 {
@@ -53,6 +55,17 @@ namespace lbyte::stx::literals
         return ptr<std::byte>{ static_cast<uptr>(v) };
     }
 
+    // --- HASHES (identical to hash::fnv1a64 / fnv1a32 at run time) ----------
+    template<ct::fixed_string S>
+    consteval u64 operator""_hash() noexcept {
+        return hash::fnv1a64( std::string_view{ S.data, S.size() } );
+    }
+
+    template<ct::fixed_string S>
+    consteval u32 operator""_hash32() noexcept {
+        return hash::fnv1a32( std::string_view{ S.data, S.size() } );
+    }
+
     // --- ENDIAN TYPES (auto-sized) -----------------------------------------
     namespace details {
         constexpr auto hex_val(char c) noexcept -> unsigned long long {
@@ -0,0 +1,379 @@
+#pragma once
+#include "./core.hpp"
+#include "./io_base.hpp"
+#include "./io_stream.hpp"
+#include "./memcur.hpp"
+#include "./stats.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <utility>
+
+// The map_file class and its io overloads. OS calls live in
+// map_file_platform.hpp: included below in header-only builds, compiled once
+// into the stx library when LBYTE_STX_COMPILED is set.
+
+namespace lbyte::stx
+{
+    // MAP_FILE -------------------------------------------------------------------
+
+    enum class map_flag : u16 {
+        none       = 0,
+        write      = 1 << 0,
+        exec       = 1 << 1,
+        shared     = 1 << 2,
+        priv       = 1 << 3,
+        populate   = 1 << 4,
+        // access hints, applied to the whole view right after mapping
+        sequential = 1 << 5,
+        random     = 1 << 6,
+        willneed   = 1 << 7,
+        huge       = 1 << 8,    // transparent huge pages (MADV_HUGEPAGE), best effort
+        hugetlb    = 1 << 9,    // MAP_HUGETLB; falls back to `huge` if the kernel refuses
+    };
+
+    inline constexpr map_flag operator|(map_flag a, map_flag b) noexcept {
+        return static_cast<map_flag>(static_cast<u16>(a) | static_cast<u16>(b));
+    }
+
+    inline constexpr map_flag operator&(map_flag a, map_flag b) noexcept {
+        return static_cast<map_flag>(static_cast<u16>(a) & static_cast<u16>(b));
+    }
+
+    inline constexpr map_flag operator^(map_flag a, map_flag b) noexcept {
+        return static_cast<map_flag>(static_cast<u16>(a) ^ static_cast<u16>(b));
+    }
+
+    inline constexpr map_flag operator~(map_flag a) noexcept {
+        return static_cast<map_flag>(~static_cast<u16>(a));
+    }
+
+    inline constexpr map_flag& operator|=(map_flag& a, map_flag b) noexcept {
+        return a = a | b;
+    }
+
+    inline constexpr map_flag& operator&=(map_flag& a, map_flag b) noexcept {
+        return a = a & b;
+    }
+
+    inline constexpr map_flag& operator^=(map_flag& a, map_flag b) noexcept {
+        return a = a ^ b;
+    }
+
+    inline constexpr bool operator!(map_flag a) noexcept {
+        return static_cast<u16>(a) == 0;
+    }
+
+    // per-range hint for map_file::advise
+    enum class map_advice : u8 {
+        normal     = 0,
+        sequential ,
+        random     ,
+        willneed   ,    // start reading the range in
+        dontneed   ,    // drop the range's pages (re-read from file on next touch);
+                        // refused on private writable maps, where it would discard edits
+        huge       ,    // back the range with transparent huge pages
+    };
+
+    class map_file : private memcur<std::byte>
+    {
+    public:
+        #if defined(_WIN32)
+            using native_type = void*;  // HANDLE
+            static inline native_type const invalid_handle = reinterpret_cast<void*>(intptr_t(-1));
+        #else
+            using native_type = int;
+            static constexpr native_type invalid_handle = -1;
+        #endif
+
+    private:
+        void*           raw_    = nullptr;  // mmap base (for unmap)
+        usize           raw_sz_ = 0;        // mapped size (for munmap)
+        map_flag        flags_{};
+        native_type     fd_     = invalid_handle;  // kept open for write mappings (resize)
+        usize           view_off_ = 0;      // file offset of the view start
+
+        auto unmap() noexcept -> void;
+
+        struct sys_ctor_tag {};
+        map_file(sys_ctor_tag, void* raw, usize raw_sz, ptr<std::byte> data, usize sz, off_s pos, map_flag fl,
+                 native_type fd = invalid_handle, usize view_off = 0) noexcept
+            : memcur(data, sz, pos)
+            , raw_(raw), raw_sz_(raw_sz), flags_(fl), fd_(fd), view_off_(view_off)
+        {}
+
+        // called with the open handle before sys_map maps (and maybe closes) it;
+        // map_cache takes the file identity from here rather than a second stat
+        using probe_fn = void (*)(native_type, void*) noexcept;
+
+        static auto sys_map(const std::filesystem::path&, usize offset, usize size, map_flag,
+                            probe_fn probe = nullptr, void* ctx = nullptr) noexcept
+            -> std::expected<map_file, std::errc>;
+
+        // sys_map plus the map_opens / map_failures / bytes_mapped counters
+        static auto traced_map(const std::filesystem::path& path, usize offset, usize size, map_flag flags,
+                               probe_fn probe = nullptr, void* ctx = nullptr) noexcept
+            -> std::expected<map_file, std::errc>
+        {
+            auto m = sys_map(path, offset, size, flags, probe, ctx);
+            stats::add(stats::counter::map_opens);
+            if (m) stats::add(stats::counter::bytes_mapped, m->raw_sz_);
+            else   stats::add(stats::counter::map_failures);
+            return m;
+        }
+
+        static auto sys_create(const std::filesystem::path&, usize size) noexcept
+            -> std::expected<void, std::errc>;
+
+        auto sys_resize(usize new_size) noexcept -> std::expected<void, std::errc>;
+
+        friend class map_cache;
+
+    public:
+        map_file() noexcept = default;
+
+        map_file(map_file&& other) noexcept
+            : memcur(std::move(other))
+            , raw_(std::exchange(other.raw_, nullptr))
+            , raw_sz_(std::exchange(other.raw_sz_, 0))
+            , flags_(std::exchange(other.flags_, map_flag::none))
+            , fd_(std::exchange(other.fd_, invalid_handle))
+            , view_off_(std::exchange(other.view_off_, 0))
+        {}
+
+        auto operator=(map_file&& other) noexcept -> map_file&
+        {
+            if (this != &other) {
+                unmap();
+                memcur::operator=(std::move(other));
+                raw_    = std::exchange(other.raw_, nullptr);
+                raw_sz_ = std::exchange(other.raw_sz_, 0);
+                flags_  = std::exchange(other.flags_, map_flag::none);
+                fd_     = std::exchange(other.fd_, invalid_handle);
+                view_off_ = std::exchange(other.view_off_, 0);
+            }
+            return *this;
+        }
+
+        map_file(const map_file&) = delete;
+        auto operator=(const map_file&) -> map_file& = delete;
+
+        ~map_file() noexcept { unmap(); }
+
+        // --- factory -------------------------------------------------------
+
+        static auto open(const std::filesystem::path& path, map_flag flags = {}) noexcept
+            -> std::expected<map_file, std::errc>
+        {
+            return traced_map(path, 0, 0, flags);
+        }
+
+        static auto open(const std::filesystem::path& path, off_s offset, usize size, map_flag flags = {}) noexcept
+            -> std::expected<map_file, std::errc>
+        {
+            if (offset.get() < 0)
+                return std::unexpected(std::errc::invalid_argument);
+            return traced_map(path, static_cast<usize>(offset.get()), size, flags);
+        }
+
+        // Create (or truncate) `path` to `size` bytes and map it read-write.
+        // The result can grow with resize(); an empty file maps to a dead view.
+        static auto create(const std::filesystem::path& path, usize size, map_flag flags = {}) noexcept
+            -> std::expected<map_file, std::errc>
+        {
+            if (!!(flags & map_flag::priv))
+                return std::unexpected(std::errc::invalid_argument);
+            if (auto made = sys_create(path, size); !made) {
+                stats::add(stats::counter::map_opens);
+                stats::add(stats::counter::map_failures);
+                return std::unexpected(made.error());
+            }
+            return traced_map(path, 0, 0, flags | map_flag::write);
+        }
+
+        // --- re-exports from memcur ---------------------------------------
+
+        using memcur::operator bool;
+        using memcur::size;
+        using memcur::base;
+        using memcur::seek;
+        using memcur::advance;
+        using memcur::tell;
+        using memcur::remaining;
+        using memcur::pop;
+        using memcur::push;
+        using memcur::as_view;
+        using memcur::read_into;
+        using memcur::pop_into;
+        using memcur::read_strvw;
+        using memcur::bytes;
+        using memcur::as_p;
+        using memcur::matches;
+        using memcur::expect;
+
+        // --- map_file-specific --------------------------------------------
+
+        map_flag flags() const noexcept { return flags_; }
+        bool     is_alive() const noexcept { return memcur::operator bool(); }
+
+        void swap(map_file& other) noexcept
+        {
+            using std::swap;
+            swap(static_cast<memcur<std::byte>&>(*this), static_cast<memcur<std::byte>&>(other));
+            swap(raw_, other.raw_);
+            swap(raw_sz_, other.raw_sz_);
+            swap(flags_, other.flags_);
+            swap(fd_, other.fd_);
+            swap(view_off_, other.view_off_);
+        }
+
+        auto flush() noexcept -> std::expected<void, std::errc>;
+
+        // Write back only [offset, offset + size) of the view (size 0 = to the end).
+        auto flush(off_s offset, usize size) noexcept -> std::expected<void, std::errc>;
+
+        // Change the view length to `new_size` bytes past the view start,
+        // remapping in place where the OS allows (mremap on Linux). The file is
+        // extended when the new view runs past its end and shortened only when
+        // the view spans the whole file, so a sub-range view never drops data
+        // outside itself. The cursor offset is kept, clamped to the new size.
+        // Growing past end of file exposes zero bytes. Needs a shared write mapping.
+        auto resize(usize new_size) noexcept -> std::expected<void, std::errc>
+        {
+            if (!(flags_ & map_flag::write) || !!(flags_ & map_flag::priv) || fd_ == invalid_handle)
+                return std::unexpected(std::errc::permission_denied);
+            return sys_resize(new_size);
+        }
+
+        // Hint the kernel about access to [offset, offset + size) of the view;
+        // size 0 means up to the end. Widened to page boundaries. dontneed on a
+        // write | priv map returns errc::operation_not_permitted.
+        auto advise(off_s offset, usize size, map_advice hint) noexcept -> std::expected<void, std::errc>;
+    };
+
+    // --- read/write overloads for map_file -------------------------------
+
+    namespace io {
+
+        template<binary_readable Type> [[nodiscard]]
+        std::expected<Type, std::errc> read(
+            const map_file& m,
+            const off_s offset
+        ) noexcept
+        {
+            auto const byte_off = offset.get();
+            if (byte_off + static_cast<off_s::value_type>(sizeof(Type)) > static_cast<off_s::value_type>(m.size())) [[unlikely]] {
+                stats::add(stats::counter::bounds_failures);
+                return std::unexpected(std::errc::argument_out_of_domain);
+            }
+            auto target = m.base() + static_cast<uptr>(byte_off);
+            return ptr<Type>(target).template read<Type>();
+        }
+
+        template<binary_readable Type>
+            requires (not contiguous_buffer<Type>)
+        std::expected<void, std::errc> write(
+            map_file& m,
+            const off_s offset,
+            const Type& value,
+            const origin dir = origin::begin
+        ) noexcept
+        {
+            if (!(m.flags() & map_flag::write)) [[unlikely]] {
+                stats::add(stats::counter::write_failures);
+                return std::unexpected(std::errc::permission_denied);
+            }
+
+            off_s actual_off{0};
+            switch (dir) {
+                case origin::begin:   actual_off = offset; break;
+                case origin::current: actual_off = off_s{m.tell().get() + offset.get()}; break;
+                case origin::end:     actual_off = off_s{scast<off_s::value_type>(m.size()) + offset.get()}; break;
+            }
+
+            auto const byte_off = actual_off.get();
+            if (byte_off + static_cast<off_s::value_type>(sizeof(Type)) > static_cast<off_s::value_type>(m.size())) [[unlikely]] {
+                stats::add(stats::counter::bounds_failures);
+                return std::unexpected(std::errc::argument_out_of_domain);
+            }
+            auto target = m.base() + static_cast<uptr>(byte_off);
+            ptr<Type>(target).write(value);
+            stats::on_write(sizeof(Type), sizeof(Type), false);
+            return {};
+        }
+
+        template<binary_readable Type>
+            requires (not contiguous_buffer<Type>)
+        std::expected<void, std::errc> write(
+            map_file& m,
+            const Type& value,
+            const origin dir = origin::begin
+        ) noexcept { return lbyte::stx::io::write( m, off_s{0}, value, dir ); }
+
+        template<contiguous_buffer R>
+        std::expected<void, std::errc> write(
+            map_file& m,
+            const off_s offset,
+            const R& buffer,
+            const origin dir = origin::begin
+        ) noexcept
+        {
+            if (!(m.flags() & map_flag::write)) [[unlikely]] {
+                stats::add(stats::counter::write_failures);
+                return std::unexpected(std::errc::permission_denied);
+            }
+
+            off_s actual_off{0};
+            switch (dir) {
+                case origin::begin:   actual_off = offset; break;
+                case origin::current: actual_off = off_s{m.tell().get() + offset.get()}; break;
+                case origin::end:     actual_off = off_s{scast<off_s::value_type>(m.size()) + offset.get()}; break;
+            }
+
+            auto const byte_off = actual_off.get();
+            auto const bytes = std::size(buffer) * sizeof(*std::data(buffer));
+            if (byte_off + static_cast<off_s::value_type>(bytes) > static_cast<off_s::value_type>(m.size())) [[unlikely]] {
+                stats::add(stats::counter::bounds_failures);
+                return std::unexpected(std::errc::argument_out_of_domain);
+            }
+            auto target = rcast<void*>(m.base() + static_cast<uptr>(byte_off));
+            std::memcpy(target, rcast<const void*>(std::data(buffer)), static_cast<usize>(bytes));
+            stats::on_write(bytes, bytes, false);
+            return {};
+        }
+
+        template<contiguous_buffer R>
+        std::expected<void, std::errc> write(
+            map_file& m,
+            const R& buffer,
+            const origin dir = origin::begin
+        ) noexcept { return lbyte::stx::io::write( m, off_s{0}, buffer, dir ); }
+
+        // --- read overloads for spans (positional, no reader_view needed) -
+
+        template<binary_readable Type> [[nodiscard]]
+        std::expected<Type, std::errc> read(
+            std::span<const std::byte> buf,
+            const off_s offset = off_s{0}
+        ) noexcept
+        {
+            auto end = offset.get() + static_cast<off_s::value_type>(sizeof(Type));
+            if (end > static_cast<off_s::value_type>(buf.size())) [[unlikely]] {
+                stats::add(stats::counter::bounds_failures);
+                return std::unexpected(std::errc::argument_out_of_domain);
+            }
+            Type val;
+            std::memcpy(&val, buf.data() + offset.get(), sizeof(Type));
+            return val;
+        }
+
+    } // namespace io
+}
+
+#if !LBYTE_STX_COMPILED
+    #include "./map_file_platform.hpp"
+#endif
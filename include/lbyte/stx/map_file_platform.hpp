@@ -0,0 +1,648 @@
+#pragma once
+#include "./map_file.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+
+#if !defined(_WIN32)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#else
+    #if !defined(NOMINMAX)
+        #define NOMINMAX
+    #endif
+    #if !defined(WIN32_LEAN_AND_MEAN)
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#endif
+
+// Defined empty by src/stx/platform.cpp, the one TU that owns these bodies
+// when the library is compiled.
+#if !defined(LBYTE_STX_PLATFORM_INLINE)
+    #define LBYTE_STX_PLATFORM_INLINE inline
+#endif
+
+namespace lbyte::stx
+{
+    // --- platform ------------------------------------------------------------
+
+    namespace details
+    {
+        // [offset, offset + size) of the data view, widened to whole pages and
+        // clipped to the raw mapping
+        LBYTE_STX_PLATFORM_INLINE auto page_range(
+            uptr data, usize data_sz,
+            void* raw, usize raw_sz,
+            off_s offset, usize size, usize page
+        ) noexcept -> std::expected<std::pair<void*, usize>, std::errc>
+        {
+            if (!raw)
+                return std::pair<void*, usize>{ nullptr, 0 };
+            if (offset.get() < 0 || static_cast<usize>(offset.get()) > data_sz)
+                return std::unexpected(std::errc::argument_out_of_domain);
+
+            auto const off = static_cast<usize>(offset.get());
+            if (size == 0 || size > data_sz - off)
+                size = data_sz - off;
+
+            auto const lo_raw = rcast<uptr>(raw);
+            auto const lo = std::max(lo_raw, (data + off) / page * page);
+            auto const hi = std::min(lo_raw + raw_sz, (data + off + size + page - 1) / page * page);
+            if (hi <= lo)
+                return std::pair<void*, usize>{ nullptr, 0 };
+            return std::pair<void*, usize>{ rcast<void*>(lo), hi - lo };
+        }
+    }
+
+    #if defined(_WIN32)
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::sys_map(
+            const std::filesystem::path& path,
+            usize offset,
+            usize size,
+            map_flag flags,
+            probe_fn probe,
+            void* ctx
+        ) noexcept -> std::expected<map_file, std::errc>
+        {
+            DWORD dwDesiredAccess = GENERIC_READ;
+            DWORD flProtect = PAGE_READONLY;
+            DWORD dwFileMapAccess = FILE_MAP_READ;
+
+            if ((flags & map_flag::write) != map_flag::none) {
+                dwDesiredAccess |= GENERIC_WRITE;
+                if ((flags & map_flag::priv) != map_flag::none) {
+                    flProtect = PAGE_WRITECOPY;
+                    dwFileMapAccess = FILE_MAP_COPY;
+                } else {
+                    flProtect = PAGE_READWRITE;
+                    dwFileMapAccess = FILE_MAP_ALL_ACCESS;
+                }
+            }
+            if ((flags & map_flag::exec) != map_flag::none) {
+                if ((flags & map_flag::write) != map_flag::none) {
+                    if ((flags & map_flag::priv) != map_flag::none) {
+                        flProtect = PAGE_EXECUTE_WRITECOPY;
+                    } else {
+                        flProtect = PAGE_EXECUTE_READWRITE;
+                    }
+                } else {
+                    flProtect = PAGE_EXECUTE_READ;
+                }
+                dwFileMapAccess = FILE_MAP_EXECUTE | (dwFileMapAccess & ~FILE_MAP_COPY);
+                if ((flags & map_flag::priv) != map_flag::none) dwFileMapAccess |= FILE_MAP_COPY;
+            }
+            if ((flags & map_flag::shared) != map_flag::none) {
+                if ((flags & map_flag::priv) != map_flag::none)
+                    return std::unexpected(std::errc::invalid_argument);
+            }
+            if ((flags & map_flag::priv) != map_flag::none) {
+                dwDesiredAccess |= GENERIC_WRITE;
+            }
+
+            HANDLE hFile = CreateFileW(
+                path.c_str(),
+                dwDesiredAccess,
+                FILE_SHARE_READ,
+                nullptr,
+                OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL,
+                nullptr
+            );
+            if (hFile == INVALID_HANDLE_VALUE)
+                return std::unexpected(std::errc::no_such_file_or_directory);
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(hFile, &fileSize)) {
+                CloseHandle(hFile);
+                return std::unexpected(std::errc::io_error);
+            }
+            if (probe) probe(hFile, ctx);
+
+            // shared write views keep the handle so they can be resized
+            bool const keep = !!(flags & map_flag::write) && !(flags & map_flag::priv);
+
+            usize file_size = static_cast<usize>(fileSize.QuadPart);
+            if ( file_size == 0 ) {
+                if (!keep) CloseHandle(hFile);
+                return map_file(sys_ctor_tag{}, nullptr, 0, ptr<std::byte>{}, 0, off_s{0}, flags,
+                                keep ? hFile : invalid_handle, offset);
+            }
+
+            if (offset > file_size) {
+                CloseHandle(hFile);
+                return std::unexpected(std::errc::argument_out_of_domain);
+            }
+
+            if ( size == 0 )
+                size = file_size - offset;
+
+            if ( size > file_size - offset ) {
+                CloseHandle(hFile);
+                return std::unexpected(std::errc::argument_out_of_domain);
+            }
+
+            // MapViewOfFile requires offset to be aligned to allocation granularity
+            SYSTEM_INFO si;
+            GetSystemInfo(&si);
+            usize gran = static_cast<usize>(si.dwAllocationGranularity);
+            usize align_off = (offset / gran) * gran;
+            usize delta = offset - align_off;
+            usize view_sz = size + delta;
+
+            DWORD dwFileOffsetLow  = static_cast<DWORD>(align_off & 0xFFFFFFFF);
+            DWORD dwFileOffsetHigh = static_cast<DWORD>((align_off >> 32) & 0xFFFFFFFF);
+
+            HANDLE hMap = CreateFileMappingW(
+                hFile,
+                nullptr,
+                flProtect,
+                0, 0,
+                nullptr
+            );
+            if (!hMap) {
+                CloseHandle(hFile);
+                return std::unexpected(std::errc::io_error);
+            }
+
+            void* raw = MapViewOfFile(
+                hMap,
+                dwFileMapAccess,
+                dwFileOffsetHigh,
+                dwFileOffsetLow,
+                view_sz
+            );
+
+            CloseHandle(hMap);
+
+            if (!raw) {
+                CloseHandle(hFile);
+                return std::unexpected(std::errc::io_error);
+            }
+            if (!keep) CloseHandle(hFile);
+
+            auto* data = static_cast<std::byte*>(raw) + delta;
+            map_file m(sys_ctor_tag{}, raw, view_sz, data, size, off_s{0}, flags,
+                       keep ? hFile : invalid_handle, offset);
+            if (!!(flags & map_flag::willneed))
+                (void)m.advise(off_s{0}, 0, map_advice::willneed);
+            return m;
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::unmap() noexcept -> void
+        {
+            if (raw_) {
+                UnmapViewOfFile(raw_);
+                stats::add(stats::counter::unmaps);
+                stats::add(stats::counter::bytes_unmapped, raw_sz_);
+            }
+            if (fd_ != invalid_handle) CloseHandle(fd_);
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::sys_create(const std::filesystem::path& path, usize size) noexcept
+            -> std::expected<void, std::errc>
+        {
+            HANDLE h = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                                   nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (h == INVALID_HANDLE_VALUE)
+                return std::unexpected(std::errc::permission_denied);
+
+            LARGE_INTEGER end;
+            end.QuadPart = static_cast<LONGLONG>(size);
+            bool const ok = SetFilePointerEx(h, end, nullptr, FILE_BEGIN) && SetEndOfFile(h);
+            CloseHandle(h);
+            if (!ok) return std::unexpected(std::errc::io_error);
+            return {};
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::sys_resize(usize new_size) noexcept -> std::expected<void, std::errc>
+        {
+            LARGE_INTEGER cur;
+            if (!GetFileSizeEx(fd_, &cur))
+                return std::unexpected(std::errc::io_error);
+
+            auto const pos       = tell();
+            auto const old_size  = size_;
+            auto const file_size = static_cast<usize>(cur.QuadPart);
+            auto const new_end   = view_off_ + new_size;
+
+            // extend the file only when the view would run past its end, and
+            // shorten it only when the view is the whole file: a sub-range view
+            // never cuts off data outside itself
+            bool const extend = new_end > file_size;
+            bool const trim   = view_off_ == 0 && old_size == file_size && new_end < file_size;
+
+            SYSTEM_INFO si;
+            GetSystemInfo(&si);
+            usize gran = static_cast<usize>(si.dwAllocationGranularity);
+            usize align_off = (view_off_ / gran) * gran;
+            usize delta = view_off_ - align_off;
+            bool const exec = !!(flags_ & map_flag::exec);
+
+            auto set_length = [&](usize len) {
+                LARGE_INTEGER end;
+                end.QuadPart = static_cast<LONGLONG>(len);
+                return SetFilePointerEx(fd_, end, nullptr, FILE_BEGIN) && SetEndOfFile(fd_);
+            };
+
+            auto map_view = [&](usize len) -> void* {
+                HANDLE hMap = CreateFileMappingW(fd_, nullptr, exec ? PAGE_EXECUTE_READWRITE : PAGE_READWRITE, 0, 0, nullptr);
+                if (!hMap)
+                    return nullptr;
+                void* raw = MapViewOfFile(
+                    hMap,
+                    FILE_MAP_ALL_ACCESS | (exec ? FILE_MAP_EXECUTE : 0),
+                    static_cast<DWORD>((align_off >> 32) & 0xFFFFFFFF),
+                    static_cast<DWORD>(align_off & 0xFFFFFFFF),
+                    len + delta
+                );
+                CloseHandle(hMap);
+                return raw;
+            };
+
+            auto install = [&](void* raw, usize len) {
+                raw_ = raw; raw_sz_ = len + delta;
+                base_ = ptr<std::byte>(static_cast<std::byte*>(raw) + delta);
+                size_ = len;
+                cur_  = base_;
+                seek(pos);
+            };
+
+            // the file cannot change length while a view of it exists
+            if (raw_) UnmapViewOfFile(raw_);
+            raw_ = nullptr; raw_sz_ = 0;
+            memcur::operator=(memcur{});
+
+            bool const sized = !(extend || trim) || set_length(new_end);
+            if (sized) {
+                if (new_size == 0)
+                    return {};
+                if (void* raw = map_view(new_size)) {
+                    install(raw, new_size);
+                    return {};
+                }
+                if (extend || trim) (void)set_length(file_size);
+            }
+
+            // put the old view back; if that fails too the map stays dead and
+            // operator bool reports false
+            if (old_size != 0)
+                if (void* raw = map_view(old_size))
+                    install(raw, old_size);
+            return std::unexpected(std::errc::io_error);
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::flush() noexcept -> std::expected<void, std::errc>
+        {
+            if (!raw_ || !(flags_ & map_flag::write))
+                return {};
+
+            stats::add(stats::counter::flushes);
+            [[maybe_unused]] stats::timer<stats::counter::flush_ns, "stx.map_file.flush"> const timed;
+
+            if (FlushViewOfFile(raw_, raw_sz_) == 0) [[unlikely]] {
+                stats::add(stats::counter::flush_failures);
+                return std::unexpected(std::errc::io_error);
+            }
+
+            return {};
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::flush(off_s offset, usize size) noexcept -> std::expected<void, std::errc>
+        {
+            if (!raw_ || !(flags_ & map_flag::write))
+                return {};
+
+            SYSTEM_INFO si;
+            GetSystemInfo(&si);
+            auto range = details::page_range(base(), this->size(), raw_, raw_sz_, offset, size, static_cast<usize>(si.dwPageSize));
+            if (!range) return std::unexpected(range.error());
+            auto [at, len] = *range;
+            if (len == 0) return {};
+
+            stats::add(stats::counter::flushes);
+            [[maybe_unused]] stats::timer<stats::counter::flush_ns, "stx.map_file.flush"> const timed;
+            if (FlushViewOfFile(at, len) == 0) [[unlikely]] {
+                stats::add(stats::counter::flush_failures);
+                return std::unexpected(std::errc::io_error);
+            }
+            return {};
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::advise(off_s offset, usize size, map_advice hint) noexcept
+            -> std::expected<void, std::errc>
+        {
+            auto range = details::page_range(base(), this->size(), raw_, raw_sz_, offset, size, 4096);
+            if (!range) return std::unexpected(range.error());
+            auto [at, len] = *range;
+            if (len == 0) return {};
+
+            switch (hint) {
+                case map_advice::willneed: {
+                    WIN32_MEMORY_RANGE_ENTRY entry{ at, len };
+                    if (!PrefetchVirtualMemory(GetCurrentProcess(), 1, &entry, 0))
+                        return std::unexpected(std::errc::io_error);
+                    return {};
+                }
+                case map_advice::dontneed:
+                    // unlocking pages that are not locked trims them from the working set
+                    VirtualUnlock(at, len);
+                    return {};
+                default:
+                    // no per-range readahead or THP control for file views
+                    return {};
+            }
+        }
+
+    #else // Linux / POSIX
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::sys_map(
+            const std::filesystem::path& path,
+            usize offset,
+            usize size,
+            map_flag flags,
+            probe_fn probe,
+            void* ctx
+        ) noexcept -> std::expected<map_file, std::errc>
+        {
+            if ((flags & map_flag::shared) != map_flag::none && (flags & map_flag::priv) != map_flag::none)
+                return std::unexpected(std::errc::invalid_argument);
+
+            int oflags = O_RDONLY;
+            int prot   = PROT_READ;
+            int mflags = MAP_PRIVATE;
+
+            if (!!(flags & map_flag::write)) {
+                oflags = O_RDWR;
+                prot |= PROT_WRITE;
+                mflags = MAP_SHARED;
+            }
+            if (!!(flags & map_flag::exec)) {
+                prot |= PROT_EXEC;
+            }
+            if (!!(flags & map_flag::shared)) {
+                mflags = MAP_SHARED;
+            }
+            if (!!(flags & map_flag::priv)) {
+                mflags = MAP_PRIVATE;
+            }
+            if (!!(flags & map_flag::populate)) {
+                mflags |= MAP_POPULATE;
+            }
+            #if defined(MAP_HUGETLB)
+                if (!!(flags & map_flag::hugetlb)) {
+                    mflags |= MAP_HUGETLB;
+                }
+            #endif
+
+            int fd = ::open(path.c_str(), oflags);
+            if (fd < 0)
+                return std::unexpected(std::errc::no_such_file_or_directory);
+
+            struct stat st;
+            if (::fstat(fd, &st) < 0) {
+                ::close(fd);
+                return std::unexpected(std::errc::io_error);
+            }
+            if (probe) probe(fd, ctx);
+
+            // shared write views keep the descriptor so they can be resized
+            bool const keep = !!(flags & map_flag::write) && !(flags & map_flag::priv);
+
+            usize file_size = static_cast<usize>(st.st_size);
+            if (file_size == 0) {
+                if (!keep) ::close(fd);
+                return map_file(sys_ctor_tag{}, nullptr, 0, ptr<std::byte>{}, 0, off_s{0}, flags,
+                                keep ? fd : invalid_handle, offset);
+            }
+
+            if (offset > file_size) {
+                ::close(fd);
+                return std::unexpected(std::errc::argument_out_of_domain);
+            }
+
+            if (size == 0) size = file_size - offset;
+            if (size > file_size - offset) {
+                ::close(fd);
+                return std::unexpected(std::errc::argument_out_of_domain);
+            }
+
+            // mmap requires page-aligned offset
+            long page = sysconf(_SC_PAGE_SIZE);
+            if (page <= 0) page = 4096;
+            usize align_off = (offset / static_cast<usize>(page)) * static_cast<usize>(page);
+            usize delta = offset - align_off;
+            usize map_sz = size + delta;
+
+            #if defined(POSIX_FADV_SEQUENTIAL)
+                // widen (or disable) page-cache readahead for the file itself
+                if (!!(flags & map_flag::sequential))
+                    ::posix_fadvise(fd, static_cast<off_t>(align_off), static_cast<off_t>(map_sz), POSIX_FADV_SEQUENTIAL);
+                else if (!!(flags & map_flag::random))
+                    ::posix_fadvise(fd, static_cast<off_t>(align_off), static_cast<off_t>(map_sz), POSIX_FADV_RANDOM);
+            #endif
+
+            void* raw = ::mmap(
+                nullptr,
+                map_sz,
+                prot,
+                mflags,
+                fd,
+                static_cast<off_t>(align_off)
+            );
+
+            #if defined(MAP_HUGETLB)
+                // hugetlb only works on hugetlbfs; fall back to transparent huge pages
+                if (raw == MAP_FAILED && (mflags & MAP_HUGETLB)) {
+                    flags = (flags & ~map_flag::hugetlb) | map_flag::huge;
+                    raw = ::mmap(nullptr, map_sz, prot, mflags & ~MAP_HUGETLB, fd, static_cast<off_t>(align_off));
+                }
+            #endif
+
+            if (raw == MAP_FAILED) {
+                ::close(fd);
+                return std::unexpected(std::errc::io_error);
+            }
+            if (!keep) ::close(fd);
+
+            auto* data = static_cast<std::byte*>(raw) + delta;
+            map_file m(sys_ctor_tag{}, raw, map_sz, data, size, off_s{0}, flags,
+                       keep ? fd : invalid_handle, offset);
+
+            // whole-view hints are best effort; the mapping is usable either way
+            if (!!(flags & map_flag::sequential)) (void)m.advise(off_s{0}, 0, map_advice::sequential);
+            if (!!(flags & map_flag::random))     (void)m.advise(off_s{0}, 0, map_advice::random);
+            if (!!(flags & map_flag::willneed))   (void)m.advise(off_s{0}, 0, map_advice::willneed);
+            if (!!(flags & map_flag::huge))       (void)m.advise(off_s{0}, 0, map_advice::huge);
+            return m;
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::unmap() noexcept -> void
+        {
+            if (raw_) {
+                ::munmap(raw_, raw_sz_);
+                stats::add(stats::counter::unmaps);
+                stats::add(stats::counter::bytes_unmapped, raw_sz_);
+            }
+            if (fd_ != invalid_handle) ::close(fd_);
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::sys_create(const std::filesystem::path& path, usize size) noexcept
+            -> std::expected<void, std::errc>
+        {
+            int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (fd < 0)
+                return std::unexpected(static_cast<std::errc>(errno));
+
+            int const rc = ::ftruncate(fd, static_cast<off_t>(size));
+            int const err = errno;
+            ::close(fd);
+            if (rc < 0) return std::unexpected(static_cast<std::errc>(err));
+            return {};
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::sys_resize(usize new_size) noexcept -> std::expected<void, std::errc>
+        {
+            long page = sysconf(_SC_PAGE_SIZE);
+            if (page <= 0) page = 4096;
+            usize align_off = (view_off_ / static_cast<usize>(page)) * static_cast<usize>(page);
+            usize delta = view_off_ - align_off;
+            usize map_sz = new_size + delta;
+
+            struct stat st;
+            if (::fstat(fd_, &st) < 0)
+                return std::unexpected(static_cast<std::errc>(errno));
+
+            auto const pos       = tell();
+            auto const file_size = static_cast<usize>(st.st_size);
+            auto const new_end   = view_off_ + new_size;
+
+            // extend the file only when the view would run past its end, and
+            // shorten it only when the view is the whole file: a sub-range view
+            // never cuts off data outside itself. Growing happens before the
+            // remap and shrinking after, so no page of the view is past EOF.
+            bool const extend = new_end > file_size;
+            bool const trim   = view_off_ == 0 && size_ == file_size && new_end < file_size;
+
+            if (extend && ::ftruncate(fd_, static_cast<off_t>(new_end)) < 0)
+                return std::unexpected(static_cast<std::errc>(errno));
+
+            void* raw = nullptr;
+            if (new_size == 0) {
+                if (raw_) ::munmap(raw_, raw_sz_);
+            } else if (raw_) {
+                #if defined(__linux__) && defined(MREMAP_MAYMOVE)
+                    raw = ::mremap(raw_, raw_sz_, map_sz, MREMAP_MAYMOVE);
+                #else
+                    int prot = PROT_READ | PROT_WRITE | (!!(flags_ & map_flag::exec) ? PROT_EXEC : 0);
+                    raw = ::mmap(nullptr, map_sz, prot, MAP_SHARED, fd_, static_cast<off_t>(align_off));
+                    if (raw != MAP_FAILED) ::munmap(raw_, raw_sz_);
+                #endif
+            } else {
+                int prot = PROT_READ | PROT_WRITE | (!!(flags_ & map_flag::exec) ? PROT_EXEC : 0);
+                raw = ::mmap(nullptr, map_sz, prot, MAP_SHARED, fd_, static_cast<off_t>(align_off));
+            }
+            if (raw == MAP_FAILED) {
+                // the old view is untouched; give back what we added to the file
+                if (extend) (void)::ftruncate(fd_, static_cast<off_t>(file_size));
+                return std::unexpected(std::errc::not_enough_memory);
+            }
+
+            if (new_size == 0) {
+                raw_ = nullptr; raw_sz_ = 0;
+                memcur::operator=(memcur{});
+            } else {
+                raw_    = raw;
+                raw_sz_ = map_sz;
+                base_   = ptr<std::byte>(static_cast<std::byte*>(raw) + delta);
+                size_   = new_size;
+                cur_    = base_;
+                seek(pos);
+            }
+
+            if (trim && ::ftruncate(fd_, static_cast<off_t>(new_end)) < 0)
+                return std::unexpected(static_cast<std::errc>(errno));
+            return {};
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::flush() noexcept -> std::expected<void, std::errc>
+        {
+            if (!raw_ || !(flags_ & map_flag::write))
+                return {};
+
+            stats::add(stats::counter::flushes);
+            [[maybe_unused]] stats::timer<stats::counter::flush_ns, "stx.map_file.flush"> const timed;
+
+            if (::msync(raw_, raw_sz_, MS_SYNC) < 0) [[unlikely]] {
+                stats::add(stats::counter::flush_failures);
+                return std::unexpected(std::errc::io_error);
+            }
+
+            return {};
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::flush(off_s offset, usize size) noexcept -> std::expected<void, std::errc>
+        {
+            if (!raw_ || !(flags_ & map_flag::write))
+                return {};
+
+            long page = sysconf(_SC_PAGE_SIZE);
+            if (page <= 0) page = 4096;
+
+            auto range = details::page_range(base(), this->size(), raw_, raw_sz_, offset, size, static_cast<usize>(page));
+            if (!range) return std::unexpected(range.error());
+            auto [at, len] = *range;
+            if (len == 0) return {};
+
+            stats::add(stats::counter::flushes);
+            [[maybe_unused]] stats::timer<stats::counter::flush_ns, "stx.map_file.flush"> const timed;
+            if (::msync(at, len, MS_SYNC) < 0) [[unlikely]] {
+                stats::add(stats::counter::flush_failures);
+                return std::unexpected(std::errc::io_error);
+            }
+            return {};
+        }
+
+        LBYTE_STX_PLATFORM_INLINE auto map_file::advise(off_s offset, usize size, map_advice hint) noexcept
+            -> std::expected<void, std::errc>
+        {
+            long page = sysconf(_SC_PAGE_SIZE);
+            if (page <= 0) page = 4096;
+
+            // MADV_DONTNEED on a copy-on-write mapping throws the private
+            // copies away: the next touch re-reads the file, losing the edits
+            if (hint == map_advice::dontneed && !!(flags_ & map_flag::write) && !!(flags_ & map_flag::priv))
+                return std::unexpected(std::errc::operation_not_permitted);
+
+            auto range = details::page_range(base(), this->size(), raw_, raw_sz_, offset, size, static_cast<usize>(page));
+            if (!range) return std::unexpected(range.error());
+            auto [at, len] = *range;
+            if (len == 0) return {};
+
+            int advice = MADV_NORMAL;
+            switch (hint) {
+                case map_advice::normal:     advice = MADV_NORMAL;     break;
+                case map_advice::sequential: advice = MADV_SEQUENTIAL; break;
+                case map_advice::random:     advice = MADV_RANDOM;     break;
+                case map_advice::willneed:   advice = MADV_WILLNEED;   break;
+                case map_advice::dontneed:   advice = MADV_DONTNEED;   break;
+                case map_advice::huge:
+                    #if defined(MADV_HUGEPAGE)
+                        advice = MADV_HUGEPAGE;
+                        break;
+                    #else
+                        return std::unexpected(std::errc::not_supported);
+                    #endif
+            }
+
+            if (::madvise(at, len, advice) < 0)
+                return std::unexpected(static_cast<std::errc>(errno));
+            return {};
+        }
+
+    #endif
+}
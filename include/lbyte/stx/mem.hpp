@@ -1,14 +1,18 @@
 #pragma once
 #include "core.hpp"
+#include "ct.hpp"
+#include "endian.hpp"
 #include "fn.hpp"
 #include <bit>
 #include <compare>
 #include <cstring>
+#include <expected>
 #include <functional>
 #include <memory>
 #include <iterator>
 #include <span>
 #include <string_view>
+#include <system_error>
 #include <memory>
 
 #if defined(__GNUC__) || defined(__clang__)
@@ -61,6 +65,34 @@ namespace lbyte::stx
             return static_cast<Type>(raw);
         }
 
+        // BULK ENDIAN-AWARE READ (out.size() elements from base) -------------------
+        template<byte_swappable Type, address_like Addr>
+        STX_FORCE_INLINE
+        void read_le_n( Addr base, std::span<Type> out ) noexcept
+        {
+            // source may be unaligned: the kernel only sees bytes
+            auto const* src = rcast<const u8*>( normalize_addr( base ));
+            if ( out.empty() )
+                return;
+            if constexpr ( std::endian::native == std::endian::big && sizeof(Type) > 1 )
+                endian::details::swap_n<sizeof(Type)>( src, rcast<u8*>( out.data() ), out.size() );
+            else
+                std::memcpy( out.data(), src, out.size_bytes() );
+        }
+
+        template<byte_swappable Type, address_like Addr>
+        STX_FORCE_INLINE
+        void read_be_n( Addr base, std::span<Type> out ) noexcept
+        {
+            auto const* src = rcast<const u8*>( normalize_addr( base ));
+            if ( out.empty() )
+                return;
+            if constexpr ( std::endian::native == std::endian::little && sizeof(Type) > 1 )
+                endian::details::swap_n<sizeof(Type)>( src, rcast<u8*>( out.data() ), out.size() );
+            else
+                std::memcpy( out.data(), src, out.size_bytes() );
+        }
+
         template<binary_readable Type, address_like Addr>
             requires (not contiguous_buffer<Type>)
         STX_FORCE_INLINE
@@ -584,6 +616,24 @@ namespace lbyte::stx
             return std::span<const U>( rcast<const U*>( address ), count );
         }
 
+        // ---- MATCH (no advance) -----------------------------------
+        // N-byte compare against a compile-time block (see ct::matches);
+        // the caller guarantees N readable bytes.
+
+        template<usize N>
+        [[nodiscard]] STX_FORCE_INLINE
+        bool matches( const ct::byte_block<N>& blk ) const noexcept
+        {
+            return ::lbyte::stx::ct::matches( rcast<const void*>( address ), blk );
+        }
+
+        template<ct::fixed_string Str>
+        [[nodiscard]] STX_FORCE_INLINE
+        bool matches() const noexcept
+        {
+            return matches( ct::vstr<Str> );
+        }
+
         // ---- UNSAFE (direct deref) --------------------------------
 
         template<typename U = T>
@@ -602,6 +652,20 @@ namespace lbyte::stx
             *rcast<U*>( address ) = value;
         }
 
+        // ---- ADDRESS TRANSLATION ---------------------------------
+        // ptr to the file bytes behind an rva_s / va_s when this points at a
+        // file image (Map: addr::map); the map's error otherwise.
+
+        template<typename A, typename Map>
+            requires requires( const Map& m, A a ) { m.to_off( a ).value(); }
+        [[nodiscard]] constexpr auto at( A a, const Map& m ) const noexcept
+            -> std::expected<ptr<T>, std::errc>
+        {
+            auto const off = m.to_off( a );
+            if ( !off ) return std::unexpected( off.error() );
+            return ptr<T>( address + static_cast<::lbyte::stx::uptr>( off->get() ));
+        }
+
         // ---- TYPE REBIND -----------------------------------------
 
         template<typename U>
@@ -0,0 +1,297 @@
+#pragma once
+#include "./core.hpp"
+#include "./ct.hpp"
+#include "./mem.hpp"
+
+// The clamp counter is the only stats hook here; with stats off (the default)
+// memcur doesn't pull in stats.hpp at all.
+#if defined(LBYTE_STX_ENABLE_STATS) && LBYTE_STX_ENABLE_STATS
+    #include "./stats.hpp"
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <utility>
+
+// Scanning, string tables, address translation and bit fields at the cursor
+// are free functions over byte_cursor in scan.hpp, strtab.hpp, addr.hpp and
+// bit.hpp, so this header stays at core, ct and mem.
+
+namespace lbyte::stx
+{
+    // --- memcur<ByteType> (bounded cursor over a buffer) -----------------------
+
+    template<buffer_type ByteType = std::byte>
+    class memcur
+    {
+    protected:
+        ptr<ByteType>  base_;
+        usize          size_{};
+        ptr<ByteType>  cur_;
+
+    public:
+        memcur() noexcept = default;
+
+        memcur(memcur&& other) noexcept
+            : base_(std::exchange(other.base_, ptr<ByteType>{}))
+            , size_(std::exchange(other.size_, 0))
+            , cur_(std::exchange(other.cur_, ptr<ByteType>{}))
+        {}
+
+        constexpr memcur& operator=(memcur&& other) noexcept
+        {
+            if (this != &other) {
+                base_ = std::exchange(other.base_, ptr<ByteType>{});
+                size_ = std::exchange(other.size_, 0);
+                cur_  = std::exchange(other.cur_, ptr<ByteType>{});
+            }
+            return *this;
+        }
+
+        memcur(std::span<ByteType> buf) noexcept
+            : base_(buf.data())
+            , size_(buf.size())
+            , cur_(base_)
+        {}
+
+        memcur(ptr<ByteType> base, usize size) noexcept
+            : base_(base)
+            , size_(size)
+            , cur_(base_)
+        {}
+
+        template<typename Ptr>
+            requires std::is_pointer_v<Ptr>
+                  && std::convertible_to<Ptr, const void*>
+        [[nodiscard]] constexpr memcur(Ptr data, usize size) noexcept
+            : base_(data)
+            , size_(size)
+            , cur_(base_)
+        {}
+
+    protected:
+        // for inheritance: construct with cursor already positioned
+        memcur(ptr<ByteType> base, usize size, off_s pos) noexcept
+            : base_(base)
+            , size_(size)
+            , cur_(base + off_s{scast<off_s::value_type>(pos.get() < 0 ? 0 : pos.get())})
+        {
+            const auto position = pos.get();
+            auto target_offset = position < 0 ? 0 : position;
+
+            if (target_offset > scast<off_s::value_type>(size_))
+                target_offset = scast<off_s::value_type>(size_);
+
+            cur_ = base_ + off_s{target_offset};
+        }
+
+        static void count_clamp() noexcept
+        {
+#if defined(LBYTE_STX_ENABLE_STATS) && LBYTE_STX_ENABLE_STATS
+            stats::add( stats::counter::cursor_clamps );
+#endif
+        }
+
+    public:
+        // --- state ---------------------------------------------------------
+
+        explicit operator bool() const noexcept { return base_.addr() != 0; }
+        usize size() const noexcept { return size_; }
+        uptr  base() const noexcept { return base_.addr(); }
+
+        void seek(off_s off, origin dir = origin::begin) noexcept {
+            auto const o = off.get();
+            off_s::value_type target_offset = 0;
+
+            switch (dir) {
+                case origin::begin:
+                    target_offset = o;
+                    break;
+                case origin::current:
+                    target_offset = tell().get() + o;
+                    break;
+                case origin::end:
+                    target_offset = scast<off_s::value_type>( size_ ) + o;
+                    break;
+            }
+
+            if ( target_offset < 0 ) [[unlikely]] {
+                count_clamp();
+                target_offset = 0;
+            } else if ( target_offset > scast<off_s::value_type>( size_ )) [[unlikely]] {
+                count_clamp();
+                target_offset = scast<off_s::value_type>(size_);
+            }
+
+            cur_ = base_ + off_s{target_offset};
+        }
+
+        void advance(const off_s offset) noexcept { seek(offset, origin::current); }
+
+        off_s tell() const noexcept { return cur_.diff(base_); }
+        off_s remaining() const noexcept {
+            auto rem = scast<off_s::value_type>(size_) - tell().get();
+            return off_s{rem < 0 ? off_s::value_type{0} : rem};
+        }
+
+        // --- pop (read + advance) ------------------------------------------
+
+        template<binary_readable T>
+        T pop() noexcept {
+            return cur_.template pop<T>();
+        }
+
+        template<bounded_array U>
+        details::bounded_array_t<U> pop() noexcept {
+            return cur_.template pop<U>();
+        }
+
+        // --- push (write + advance) ----------------------------------------
+
+        template<binary_readable T>
+            requires (!contiguous_buffer<T>) && (!std::is_const_v<ByteType>)
+        auto& push(const T& value) noexcept {
+            cur_.push(value);
+            return *this;
+        }
+
+        template<contiguous_buffer R>
+            requires (!std::is_const_v<ByteType>)
+        auto& push(R&& buf) noexcept {
+            cur_.push(std::forward<R>(buf));
+            return *this;
+        }
+
+        // --- zero-copy view (no advance) -----------------------------------
+
+        template<bounded_array U>
+        std::span<const std::remove_all_extents_t<U>> as_view() noexcept
+        {
+            using element_type = std::remove_all_extents_t<U>;
+            using flat_array = details::bounded_array_t<U>;
+            return std::span<const element_type>(
+                rcast<const element_type*>(cur_.addr()),
+                sizeof(flat_array) / sizeof(element_type)
+            );
+        }
+
+        template<binary_readable T>
+        std::span<const T> as_view(usize count) noexcept
+        {
+            return std::span<const T>( rcast<const T*>( cur_.addr() ), count );
+        }
+
+        // --- compare (matches: no advance, expect: advance on match) -------
+        // False, without moving, when fewer than N bytes remain.
+
+        template<usize N>
+        [[nodiscard]] bool matches(const ct::byte_block<N>& blk) const noexcept
+        {
+            return scast<usize>(remaining().get()) >= N && cur_.matches(blk);
+        }
+
+        template<ct::fixed_string Str>
+        [[nodiscard]] bool matches() const noexcept
+        {
+            return matches(ct::vstr<Str>);
+        }
+
+        template<usize N>
+        [[nodiscard]] bool expect(const ct::byte_block<N>& blk) noexcept
+        {
+            if (!matches(blk)) return false;
+            cur_ += off_s{scast<off_s::value_type>(N)};
+            return true;
+        }
+
+        template<ct::fixed_string Str>
+        [[nodiscard]] bool expect() noexcept
+        {
+            return expect(ct::vstr<Str>);
+        }
+
+        // --- read into (no advance) / pop into (advance) -------------------
+
+        template<writable_buffer R>
+        void read_into(R&& buf) noexcept
+        {
+            auto const bytes = std::size(buf) * sizeof(*std::data(buf));
+            std::memcpy(
+                rcast<std::byte*>(std::data(buf)),
+                rcast<const std::byte*>(cur_.addr()),
+                static_cast<usize>(bytes)
+            );
+        }
+
+        template<writable_buffer R>
+        auto& pop_into(R&& buf) noexcept
+        {
+            auto const bytes = std::size(buf) * sizeof(*std::data(buf));
+            std::memcpy(
+                rcast<std::byte*>(std::data(buf)),
+                rcast<const std::byte*>(cur_.addr()),
+                static_cast<usize>(bytes)
+            );
+            cur_ += off_s{scast<off_s::value_type>(bytes)};
+            return *this;
+        }
+
+        // decode `Order`-encoded elements (e.g. an endian::be<u32> table) into native values
+        template<endian::order Order, byte_swappable T>
+        auto& pop_into(std::span<T> out) noexcept
+        {
+            if constexpr (Order == endian::order::big)
+                mem::read_be_n(cur_.addr(), out);
+            else
+                mem::read_le_n(cur_.addr(), out);
+            cur_ += off_s{scast<off_s::value_type>(out.size_bytes())};
+            return *this;
+        }
+
+        std::string_view read_strvw() noexcept
+        {
+            return read_strvw(size_ - static_cast<usize>(tell().get()));
+        }
+
+        std::string_view read_strvw(usize max) noexcept
+        {
+            auto pos = static_cast<usize>(tell().get());
+            auto rem = size_ - pos;
+            auto avail = std::min(max, rem);
+            if (avail == 0) return {};
+            auto* base = rcast<const char*>(cur_.addr());
+            auto len = strnlen(base, avail);
+            cur_ = cur_ + off_s{scast<off_s::value_type>(len < avail ? len + 1 : avail)};
+            return {base, len};
+        }
+
+        template<typename T = ByteType>
+        [[nodiscard]] constexpr ptr<T> as_p() const noexcept
+        {
+            return ptr<T>(cur_.addr());
+        }
+
+        [[nodiscard]] constexpr std::span<ByteType> bytes() noexcept
+        {
+            auto const rem = remaining().get();
+            return std::span<ByteType>(rcast<ByteType*>(cur_.addr()), scast<usize>(rem < 0 ? 0 : rem));
+        }
+
+        [[nodiscard]] constexpr std::span<const ByteType> bytes() const noexcept
+        {
+            auto const rem = remaining().get();
+            return std::span<const ByteType>(rcast<const ByteType*>(cur_.addr()), scast<usize>(rem < 0 ? 0 : rem));
+        }
+    };
+
+    // --- deduction guides for memcur -----------------------------------------
+
+    template<lbyte::stx::buffer_type B>
+    memcur(B*, usize) -> memcur<B>;
+
+    template<typename T>
+        requires (!lbyte::stx::buffer_type<T>)
+    memcur(T*, usize) -> memcur<std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>>;
+}
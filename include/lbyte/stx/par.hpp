@@ -0,0 +1,292 @@
+#pragma once
+#include "core.hpp"
+#include "range.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace lbyte::stx::par
+{
+    // --- pool (work-stealing loop executor) --------------------------------------
+    // run(count, fn) calls fn(i) for every i in [0, count) and blocks until all are
+    // done; the calling thread participates. Each participant owns a contiguous
+    // slice of indices, takes from its front, and when empty steals the back half
+    // of another participant's slice. One loop runs at a time per pool; nested
+    // run() calls from inside a loop body execute inline.
+
+    class pool
+    {
+        static constexpr usize cache_line = 64;
+
+        struct alignas(cache_line) slot
+        {
+            // [begin, end) packed as (end << 32) | begin
+            std::atomic<u64> range{ 0 };
+        };
+
+        struct job
+        {
+            void  (*invoke)(void*, usize) = nullptr;
+            void*   ctx   = nullptr;
+            usize   base  = 0;
+            usize   width = 0;
+
+            std::unique_ptr<slot[]> slots;
+            std::atomic<usize>      next_slot{ 0 };
+            usize                   active = 0;    // workers inside the job, guarded by pool::mtx_
+            std::atomic<bool>       failed   { false };
+            std::exception_ptr      error;
+            std::mutex              error_mtx;
+        };
+
+        std::vector<std::thread> workers_;
+        std::mutex               mtx_;
+        std::condition_variable  cv_;
+        std::condition_variable  done_cv_;
+        std::mutex               run_mtx_;
+        job*                     job_ = nullptr;
+        u64                      gen_ = 0;
+        bool                     stop_ = false;
+
+        static auto current() noexcept -> const pool*&
+        {
+            thread_local const pool* p = nullptr;
+            return p;
+        }
+
+        static constexpr u64 pack( u64 b, u64 e ) noexcept { return ( e << 32 ) | b; }
+        static constexpr u64 lo( u64 r ) noexcept { return r & 0xFFFF'FFFFull; }
+        static constexpr u64 hi( u64 r ) noexcept { return r >> 32; }
+
+        // claim the front index of our own slice
+        static bool take( slot& s, usize& out ) noexcept
+        {
+            auto r = s.range.load( std::memory_order_acquire );
+            while ( lo( r ) < hi( r ) ) {
+                if ( s.range.compare_exchange_weak( r, pack( lo( r ) + 1, hi( r )), std::memory_order_acq_rel )) {
+                    out = scast<usize>( lo( r ));
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // move the back half of a victim's slice into our (empty) slot
+        static bool steal( job& j, usize self ) noexcept
+        {
+            for ( usize k = 1; k < j.width; ++k )
+            {
+                auto& victim = j.slots[( self + k ) % j.width];
+                auto  r = victim.range.load( std::memory_order_acquire );
+                while ( lo( r ) < hi( r ) ) {
+                    auto const mid = lo( r ) + ( hi( r ) - lo( r )) / 2;
+                    if ( victim.range.compare_exchange_weak( r, pack( lo( r ), mid ), std::memory_order_acq_rel )) {
+                        j.slots[self].range.store( pack( mid, hi( r )), std::memory_order_release );
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        static void participate( job& j, usize self )
+        {
+            usize i = 0;
+            for (;;) {
+                while ( take( j.slots[self], i )) {
+                    if ( j.failed.load( std::memory_order_relaxed ))
+                        continue;
+                    try {
+                        j.invoke( j.ctx, j.base + i );
+                    } catch ( ... ) {
+                        std::scoped_lock lk{ j.error_mtx };
+                        if ( !j.error ) j.error = std::current_exception();
+                        j.failed.store( true, std::memory_order_relaxed );
+                    }
+                }
+                if ( !steal( j, self ))
+                    return;
+            }
+        }
+
+        void worker_loop()
+        {
+            current() = this;
+            u64 seen = 0;
+
+            for (;;)
+            {
+                job* j = nullptr;
+                {
+                    std::unique_lock lk{ mtx_ };
+                    cv_.wait( lk, [&] { return stop_ || gen_ != seen; });
+                    if ( stop_ )
+                        return;
+                    seen = gen_;
+                    j = job_;
+                    if ( !j )
+                        continue;
+                    ++j->active;
+                }
+
+                auto const self = j->next_slot.fetch_add( 1, std::memory_order_acq_rel );
+                if ( self < j->width )
+                    participate( *j, self );
+
+                // the job lives on dispatch()'s stack: leave it under the lock
+                // so dispatch() cannot return before this worker is done with it
+                std::scoped_lock lk{ mtx_ };
+                if ( --j->active == 0 )
+                    done_cv_.notify_all();
+            }
+        }
+
+        // publish `j` to the workers, participate as slot 0, wait for the rest
+        void dispatch( job& j, usize count )
+        {
+            j.slots = std::make_unique<slot[]>( j.width );
+            for ( usize k = 0; k < j.width; ++k ) {
+                auto const b = count * k / j.width;
+                auto const e = count * ( k + 1 ) / j.width;
+                j.slots[k].range.store( pack( b, e ), std::memory_order_relaxed );
+            }
+            j.next_slot.store( 1, std::memory_order_relaxed );
+
+            {
+                std::scoped_lock lk{ mtx_ };
+                job_ = &j;
+                ++gen_;
+            }
+            cv_.notify_all();
+
+            auto const prev = current();
+            current() = this;
+            participate( j, 0 );
+            current() = prev;
+
+            {
+                std::unique_lock lk{ mtx_ };
+                job_ = nullptr;
+                done_cv_.wait( lk, [&] { return j.active == 0; });
+            }
+
+            if ( j.error )
+                std::rethrow_exception( j.error );
+        }
+
+    public:
+        // threads: worker count excluding the caller; 0 = hardware_concurrency - 1
+        explicit pool( usize threads = 0 )
+        {
+            if ( threads == 0 ) {
+                auto const hw = scast<usize>( std::thread::hardware_concurrency() );
+                threads = hw > 1 ? hw - 1 : 0;
+            }
+            workers_.reserve( threads );
+            for ( usize i = 0; i < threads; ++i )
+                workers_.emplace_back( [this] { worker_loop(); } );
+        }
+
+        pool( const pool& ) = delete;
+        pool& operator=( const pool& ) = delete;
+
+        ~pool()
+        {
+            {
+                std::scoped_lock lk{ mtx_ };
+                stop_ = true;
+            }
+            cv_.notify_all();
+            for ( auto& w : workers_ )
+                w.join();
+        }
+
+        // participants available to a loop (workers + caller)
+        [[nodiscard]] usize size() const noexcept { return workers_.size() + 1; }
+
+        // process-wide pool, created on first use
+        [[nodiscard]] static pool& shared()
+        {
+            static pool p{};
+            return p;
+        }
+
+        // width: max participants (0 = size()). Rethrows the first exception
+        // thrown by fn; remaining indices are skipped once one throws.
+        template<typename Fn>
+        void run( usize count, Fn&& fn, usize width = 0 )
+        {
+            if ( count == 0 )
+                return;
+
+            width = std::min( width == 0 ? size() : width, size() );
+            width = std::min<usize>( width, count );
+
+            if ( width <= 1 || current() == this ) {
+                for ( usize i = 0; i < count; ++i )
+                    fn( i );
+                return;
+            }
+
+            std::scoped_lock serial{ run_mtx_ };
+
+            // slices are packed into 32-bit halves
+            constexpr usize max_batch = 0xFFFF'FFFFull;
+            for ( usize base = 0; base < count; base += max_batch )
+            {
+                auto const n = std::min( max_batch, count - base );
+
+                job j;
+                j.invoke = []( void* ctx, usize i ) { ( *static_cast<std::remove_reference_t<Fn>*>( ctx ))( i ); };
+                j.ctx    = const_cast<void*>( static_cast<const void*>( std::addressof( fn )));
+                j.base   = base;
+                j.width  = std::min( width, n );
+                dispatch( j, n );
+            }
+        }
+    };
+
+    // --- parallel_for (range_view over a pool) -----------------------------------
+    // Calls fn(value) for every value of a range / irange, keeping its step,
+    // direction, bounds mode and element type (off_s stays off_s). Values are
+    // handed out in runs of `grain` consecutive elements; call order is
+    // unspecified.
+
+    struct for_options
+    {
+        usize      grain   = 1;         // consecutive values per task
+        usize      threads = 0;         // max participants, 0 = whole pool
+        par::pool* pool    = nullptr;   // nullptr = par::pool::shared()
+    };
+
+    template<::lbyte::stx::details::rangeable T, typename Fn>
+    void parallel_for( const ::lbyte::stx::details::range_view<T>& r, Fn&& fn, const for_options& opt = {} )
+    {
+        auto const n     = r.size();
+        auto const grain = std::max<usize>( opt.grain, 1 );
+        auto const tasks = n / grain + ( n % grain != 0 );
+
+        auto& workers = opt.pool ? *opt.pool : pool::shared();
+        workers.run( tasks, [&]( usize t ) {
+            auto const count = std::min( grain, n - t * grain );
+            auto it = r.begin() + scast<std::ptrdiff_t>( t * grain );
+            for ( usize k = 0; k < count; ++k, ++it )
+                fn( *it );
+        }, opt.threads );
+    }
+
+    // fn(range_view) once per chunk, for loops with per-chunk setup or results
+    template<::lbyte::stx::details::rangeable T, typename Fn>
+    void parallel_for( const ::lbyte::stx::details::range_chunks<T>& parts, Fn&& fn, const for_options& opt = {} )
+    {
+        auto& workers = opt.pool ? *opt.pool : pool::shared();
+        workers.run( parts.size(), [&]( usize k ) { fn( parts[k] ); }, opt.threads );
+    }
+}
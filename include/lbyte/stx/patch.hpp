@@ -0,0 +1,338 @@
+#pragma once
+#include "./core.hpp"
+#include "./io.hpp"
+#include "./file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <iterator>
+#include <map>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace lbyte::stx::patch
+{
+    // --- overlay -----------------------------------------------------------------
+    // Sparse copy-on-write layer over a read-only image (a map_file opened
+    // without map_flag::write, or any byte span). Writes land in coalesced
+    // extents keyed by file offset; reads see the image with the extents on top.
+    // Memory grows with the patched bytes, not the file. The image must outlive
+    // the overlay and cannot grow through it.
+
+    class overlay
+    {
+        std::span<const std::byte>            base_;
+        std::map<u64, std::vector<std::byte>> ext_;
+        usize                                 bytes_ = 0;
+
+        using iter = std::map<u64, std::vector<std::byte>>::const_iterator;
+
+        static u64 end_of( iter it ) noexcept { return it->first + it->second.size(); }
+
+        // first extent ending after `at`
+        [[nodiscard]] iter first_after( u64 at ) const noexcept
+        {
+            auto it = ext_.upper_bound( at );
+            if ( it != ext_.begin() && end_of( std::prev( it )) > at ) --it;
+            return it;
+        }
+
+        [[nodiscard]] bool in_bounds( off_s at, usize n ) const noexcept
+        {
+            return at.get() >= 0 && scast<u64>( at.get() ) <= base_.size() && n <= base_.size() - scast<usize>( at.get() );
+        }
+
+    public:
+        overlay() noexcept = default;
+
+        explicit overlay( std::span<const std::byte> image ) noexcept : base_( image ) {}
+
+        explicit overlay( const map_file& image ) noexcept
+            : base_( rcast<const std::byte*>( image.base() ), image.size() )
+        {}
+
+        // --- state ---------------------------------------------------------
+
+        [[nodiscard]] usize size()  const noexcept { return base_.size(); }
+        [[nodiscard]] bool  empty() const noexcept { return ext_.empty(); }
+        [[nodiscard]] usize extents() const noexcept { return ext_.size(); }
+        [[nodiscard]] usize patched_bytes() const noexcept { return bytes_; }
+
+        [[nodiscard]] std::span<const std::byte> image() const noexcept { return base_; }
+
+        // drop every patch; reads see the image again
+        void clear() noexcept { ext_.clear(); bytes_ = 0; }
+
+        // --- write ---------------------------------------------------------
+        // argument_out_of_domain when [at, at + size) leaves the image
+
+        auto write( off_s at, std::span<const std::byte> in ) -> std::expected<void, std::errc>
+        {
+            if ( !in_bounds( at, in.size() )) [[unlikely]]
+                return std::unexpected( std::errc::argument_out_of_domain );
+            if ( in.empty() ) return {};
+
+            auto const lo = scast<u64>( at.get() );
+            auto const hi = lo + in.size();
+
+            // extents overlapping or touching [lo, hi)
+            auto first = ext_.upper_bound( lo );
+            if ( first != ext_.begin() && end_of( std::prev( first )) >= lo ) --first;
+            auto last = first;
+            while ( last != ext_.end() && last->first <= hi ) ++last;
+
+            if ( first == last ) {
+                ext_.emplace_hint( first, lo, std::vector<std::byte>( in.begin(), in.end() ));
+                bytes_ += in.size();
+                return {};
+            }
+
+            // inside one extent: overwrite in place
+            if ( std::next( first ) == last && first->first <= lo && end_of( first ) >= hi ) {
+                std::memcpy( first->second.data() + ( lo - first->first ), in.data(), in.size() );
+                return {};
+            }
+
+            // merge into the first extent's buffer (appends reuse its capacity)
+            auto const new_lo = std::min( lo, first->first );
+            auto const new_hi = std::max( hi, end_of( std::prev( last )));
+
+            std::vector<std::byte> buf;
+            if ( first->first == new_lo ) {
+                buf = std::move( first->second );
+                bytes_ -= buf.size();
+                ++first;
+            }
+            buf.resize( scast<usize>( new_hi - new_lo ));
+
+            for ( auto it = first; it != last; ++it ) {
+                std::memcpy( buf.data() + ( it->first - new_lo ), it->second.data(), it->second.size() );
+                bytes_ -= it->second.size();
+            }
+            std::memcpy( buf.data() + ( lo - new_lo ), in.data(), in.size() );
+
+            auto const hint = ext_.erase( ext_.lower_bound( new_lo ), last );
+            bytes_ += buf.size();
+            ext_.emplace_hint( hint, new_lo, std::move( buf ));
+            return {};
+        }
+
+        template<binary_readable T>
+            requires ( not contiguous_buffer<T> )
+        auto write( off_s at, const T& value ) -> std::expected<void, std::errc>
+        {
+            return write( at, std::as_bytes( std::span{ &value, 1 } ));
+        }
+
+        template<contiguous_buffer R>
+        auto write( off_s at, const R& buf ) -> std::expected<void, std::errc>
+        {
+            return write( at, std::span<const std::byte>{
+                rcast<const std::byte*>( std::data( buf )), std::size( buf ) * sizeof( *std::data( buf )) });
+        }
+
+        // --- read (image + patches) ----------------------------------------
+
+        auto read( off_s at, std::span<std::byte> out ) const noexcept -> std::expected<void, std::errc>
+        {
+            if ( !in_bounds( at, out.size() )) [[unlikely]]
+                return std::unexpected( std::errc::argument_out_of_domain );
+            if ( out.empty() ) return {};
+
+            auto const lo = scast<u64>( at.get() );
+            auto const hi = lo + out.size();
+            std::memcpy( out.data(), base_.data() + lo, out.size() );
+
+            for ( auto it = first_after( lo ); it != ext_.end() && it->first < hi; ++it ) {
+                auto const a = std::max( lo, it->first );
+                auto const b = std::min( hi, end_of( it ));
+                std::memcpy( out.data() + ( a - lo ), it->second.data() + ( a - it->first ), scast<usize>( b - a ));
+            }
+            return {};
+        }
+
+        template<binary_readable T> [[nodiscard]]
+        auto read( off_s at ) const noexcept -> std::expected<T, std::errc>
+        {
+            T value;
+            auto r = read( at, std::as_writable_bytes( std::span{ &value, 1 } ));
+            if ( !r ) [[unlikely]]
+                return std::unexpected( r.error() );
+            return value;
+        }
+
+        // --- diff ----------------------------------------------------------
+
+        // fn(off_s, std::span<const std::byte>) per extent, in offset order;
+        // image().subspan(off, bytes.size()) is what it replaces
+        template<typename Fn>
+        void for_each( Fn&& fn ) const
+        {
+            for ( auto const& [off, bytes] : ext_ )
+                fn( off_s{ scast<off_s::value_type>( off ) }, std::span<const std::byte>{ bytes } );
+        }
+
+        // --- commit --------------------------------------------------------
+        // Patches stay recorded; clear() afterwards to start a new set.
+
+        // every extent as one io::write batch; returns the bytes written
+        auto commit( const io::file& f ) const -> std::expected<usize, std::errc>
+        {
+            std::vector<io::write_req> reqs;
+            reqs.reserve( ext_.size() );
+            for ( auto const& [off, bytes] : ext_ )
+                reqs.push_back({ off_s{ scast<off_s::value_type>( off ) }, std::span<const std::byte>{ bytes } });
+            return io::write( f, reqs );
+        }
+
+        auto commit( const std::filesystem::path& path ) const -> std::expected<usize, std::errc>
+        {
+            auto f = io::file::open( path, io::file_mode::read_write );
+            if ( !f ) [[unlikely]]
+                return std::unexpected( f.error() );
+            return commit( *f );
+        }
+
+        // copy the patches into a writable image (a buffer copy, a shared write
+        // mapping); argument_out_of_domain when `out` is shorter than the image
+        auto apply( std::span<std::byte> out ) const noexcept -> std::expected<void, std::errc>
+        {
+            if ( out.size() < base_.size() ) [[unlikely]]
+                return std::unexpected( std::errc::argument_out_of_domain );
+            for ( auto const& [off, bytes] : ext_ )
+                std::memcpy( out.data() + off, bytes.data(), bytes.size() );
+            return {};
+        }
+    };
+
+    // --- cursor ------------------------------------------------------------------
+    // memcur surface over an overlay: pops read through the patches, pushes
+    // record them. Out-of-range access sets a sticky error (as stream_cur does)
+    // and reads yield zeroes.
+
+    class cursor
+    {
+        overlay*  ov_  = nullptr;
+        u64       pos_ = 0;
+        std::errc err_{};
+
+        void fail( std::errc e ) noexcept { if ( err_ == std::errc{} ) err_ = e; }
+
+    public:
+        cursor() noexcept = default;
+
+        explicit cursor( overlay& ov, off_s pos = off_s{ 0 } ) noexcept : ov_( &ov ) { seek( pos ); }
+
+        // --- state ---------------------------------------------------------
+
+        explicit operator bool() const noexcept { return err_ == std::errc{}; }
+
+        auto status() const noexcept -> std::expected<void, std::errc>
+        {
+            if ( err_ != std::errc{} ) return std::unexpected( err_ );
+            return {};
+        }
+
+        void clear() noexcept { err_ = std::errc{}; }
+
+        usize size() const noexcept { return ov_ ? ov_->size() : 0; }
+        off_s tell() const noexcept { return off_s{ scast<off_s::value_type>( pos_ ) }; }
+        off_s remaining() const noexcept { return off_s{ scast<off_s::value_type>( size() - pos_ ) }; }
+
+        // clamped to [0, size()], like memcur::seek
+        void seek( off_s off, origin dir = origin::begin ) noexcept
+        {
+            off_s::value_type target = 0;
+            switch ( dir ) {
+                case origin::begin:   target = off.get(); break;
+                case origin::current: target = tell().get() + off.get(); break;
+                case origin::end:     target = scast<off_s::value_type>( size() ) + off.get(); break;
+            }
+            target = std::clamp<off_s::value_type>( target, 0, scast<off_s::value_type>( size() ));
+            pos_   = scast<u64>( target );
+        }
+
+        void advance( const off_s offset ) noexcept { seek( offset, origin::current ); }
+
+        // --- pop (read + advance) ------------------------------------------
+
+        template<binary_readable T>
+        T pop() noexcept
+        {
+            T value{};
+            pop_into( std::as_writable_bytes( std::span{ &value, 1 } ));
+            return value;
+        }
+
+        template<writable_buffer R>
+        auto& pop_into( R&& buf ) noexcept
+        {
+            auto const out = std::span<std::byte>{
+                rcast<std::byte*>( std::data( buf )), std::size( buf ) * sizeof( *std::data( buf )) };
+            if ( err_ == std::errc{} ) {
+                // a default-constructed cursor has no overlay: invalid_argument
+                auto const r = ov_ ? ov_->read( tell(), out )
+                                   : std::expected<void, std::errc>{ std::unexpect, std::errc::invalid_argument };
+                if ( !r ) [[unlikely]] {
+                    std::memset( out.data(), 0, out.size() );
+                    fail( r.error() );
+                } else {
+                    pos_ += out.size();
+                }
+            }
+            return *this;
+        }
+
+        // --- push (write + advance) ----------------------------------------
+
+        template<binary_readable T>
+            requires ( not contiguous_buffer<T> )
+        auto& push( const T& value )
+        {
+            return push( std::as_bytes( std::span{ &value, 1 } ));
+        }
+
+        template<contiguous_buffer R>
+        auto& push( R&& buf )
+        {
+            auto const n = std::size( buf ) * sizeof( *std::data( buf ));
+            if ( err_ == std::errc{} ) {
+                if ( !ov_ ) [[unlikely]]
+                    fail( std::errc::invalid_argument );
+                else if ( auto r = ov_->write( tell(), buf ); !r ) [[unlikely]]
+                    fail( r.error() );
+                else
+                    pos_ += n;
+            }
+            return *this;
+        }
+    };
+}
+
+namespace lbyte::stx::io
+{
+    // --- read/write overloads for patch::overlay ---------------------------------
+
+    template<binary_readable Type> [[nodiscard]]
+    std::expected<Type, std::errc> read( const patch::overlay& o, const off_s offset ) noexcept
+    {
+        return o.read<Type>( offset );
+    }
+
+    template<binary_readable Type>
+        requires ( not contiguous_buffer<Type> )
+    std::expected<void, std::errc> write( patch::overlay& o, const off_s offset, const Type& value )
+    {
+        return o.write( offset, value );
+    }
+
+    template<contiguous_buffer R>
+    std::expected<void, std::errc> write( patch::overlay& o, const off_s offset, const R& buffer )
+    {
+        return o.write( offset, buffer );
+    }
+}
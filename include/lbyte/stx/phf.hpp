@@ -0,0 +1,382 @@
+#pragma once
+#include "core.hpp"
+#include "ct.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx::ct
+{
+    // --- perfect hashing (hash and displace) --------------------------------------
+    // Built at compile time from the key list. A lookup is one hash of the key,
+    // one per-bucket displacement load, a multiply-shift to the slot and a single
+    // compare against the key stored there; there are no probes and no chains.
+    //
+    //   bucket = h >> (64 - bucket_bits)
+    //   slot   = ((h ^ disp[bucket]) * K) >> (64 - slot_bits)
+    //
+    // Displacements are searched bucket by bucket, largest first (PTHash-style);
+    // the table doubles until every bucket fits. Load factor is 0.375..0.75.
+
+    namespace details
+    {
+        inline constexpr u64 phf_k0 = 0x9E3779B97F4A7C15ull;
+        inline constexpr u64 phf_k1 = 0xC2B2AE3D27D4EB4Full;
+
+        // murmur3 fmix64
+        [[nodiscard]] constexpr u64 phf_mix( u64 x ) noexcept
+        {
+            x ^= x >> 33; x *= 0xFF51AFD7ED558CCDull;
+            x ^= x >> 33; x *= 0xC4CEB9FE1A85EC53ull;
+            x ^= x >> 33;
+            return x;
+        }
+
+        // little-endian load of `n` (1..8) bytes, identical at compile and run time
+        [[nodiscard]] STX_FORCE_INLINE constexpr u64 phf_load( const char* p, usize n ) noexcept
+        {
+            if consteval {
+                u64 v = 0;
+                for ( usize i = 0; i < n; ++i )
+                    v |= u64{ scast<unsigned char>( p[i] ) } << ( i * 8 );
+                return v;
+            } else {
+                // the bytes fill the low-address end of v; on big-endian the
+                // whole-u64 swap then moves them to the low-order end
+                u64 v = 0;
+                std::memcpy( &v, p, n );
+                if constexpr ( std::endian::native == std::endian::big )
+                    v = std::byteswap( v );
+                return v;
+            }
+        }
+
+        // first / last 8 bytes and the length: enough to tell most key sets apart
+        [[nodiscard]] STX_FORCE_INLINE constexpr u64 phf_hash_short( std::string_view s ) noexcept
+        {
+            auto const n = s.size();
+            u64 a = 0, b = 0;
+            if ( n >= 8 ) {
+                a = phf_load( s.data(), 8 );
+                b = phf_load( s.data() + n - 8, 8 );
+            } else if ( n >= 4 ) {
+                a = phf_load( s.data(), 4 );
+                b = phf_load( s.data() + n - 4, 4 );
+            } else if ( n > 0 ) {
+                a = u64{ scast<unsigned char>( s[0] ) }
+                  | u64{ scast<unsigned char>( s[n / 2] ) } << 8
+                  | u64{ scast<unsigned char>( s[n - 1] ) } << 16;
+            }
+            return phf_mix( a ^ ( b * phf_k1 ) ^ ( u64{ n } * phf_k0 ));
+        }
+
+        // every byte (FNV-1a); used when two keys share length and both ends
+        [[nodiscard]] constexpr u64 phf_hash_full( std::string_view s ) noexcept
+        {
+            u64 h = 0xCBF29CE484222325ull;
+            for ( char c : s )
+                h = ( h ^ scast<unsigned char>( c )) * 0x100000001B3ull;
+            return phf_mix( h ^ u64{ s.size() } );
+        }
+
+        template<bool Full>
+        [[nodiscard]] STX_FORCE_INLINE constexpr u64 phf_hash( std::string_view s ) noexcept
+        {
+            if constexpr ( Full ) return phf_hash_full( s );
+            else                  return phf_hash_short( s );
+        }
+
+        struct phf_shape
+        {
+            u32 slot_bits   = 0;
+            u32 bucket_bits = 0;
+            bool ok         = false;
+        };
+
+        inline constexpr u32 phf_max_pilot = 1u << 14;
+
+        [[nodiscard]] constexpr usize phf_bucket( u64 h, u32 bits ) noexcept { return scast<usize>( h >> ( 64 - bits )); }
+        [[nodiscard]] constexpr usize phf_slot( u64 h, u64 disp, u32 bits ) noexcept { return scast<usize>((( h ^ disp ) * phf_k0 ) >> ( 64 - bits )); }
+
+        // displacement search for a fixed shape; fills disp / slots on success
+        template<typename Disp, typename Slots>
+        constexpr bool phf_place( const u64* hashes, usize n, phf_shape s, Disp& disp, Slots& slots ) noexcept
+        {
+            usize const m = usize{ 1 } << s.slot_bits;
+            usize const b = usize{ 1 } << s.bucket_bits;
+
+            std::vector<std::vector<usize>> buckets( b );
+            for ( usize i = 0; i < n; ++i )
+                buckets[phf_bucket( hashes[i], s.bucket_bits )].push_back( i );
+
+            std::vector<usize> order( b );
+            for ( usize i = 0; i < b; ++i ) order[i] = i;
+            std::sort( order.begin(), order.end(), [&]( usize x, usize y ) {
+                return buckets[x].size() != buckets[y].size() ? buckets[x].size() > buckets[y].size() : x < y;
+            });
+
+            std::vector<bool>  taken( m, false );
+            std::vector<usize> pos;
+            for ( auto bi : order ) {
+                auto const& keys = buckets[bi];
+                if ( keys.empty() ) break;
+
+                bool placed = false;
+                for ( u32 p = 0; p < phf_max_pilot && !placed; ++p ) {
+                    auto const d = phf_mix( p );
+                    pos.clear();
+                    placed = true;
+                    for ( auto k : keys ) {
+                        auto const at = phf_slot( hashes[k], d, s.slot_bits );
+                        if ( taken[at] || std::find( pos.begin(), pos.end(), at ) != pos.end() ) {
+                            placed = false;
+                            break;
+                        }
+                        pos.push_back( at );
+                    }
+                    if ( placed ) {
+                        disp[bi] = d;
+                        for ( usize j = 0; j < keys.size(); ++j ) {
+                            taken[pos[j]] = true;
+                            slots[pos[j]] = scast<typename Slots::value_type>( keys[j] );
+                        }
+                    }
+                }
+                if ( !placed ) return false;
+            }
+            return true;
+        }
+
+        struct phf_discard
+        {
+            using value_type = u32;
+            struct sink { template<typename T> constexpr sink& operator=( T ) noexcept { return *this; } };
+            constexpr sink operator[]( usize ) const noexcept { return {}; }
+        };
+
+        [[nodiscard]] constexpr bool phf_unique( const u64* hashes, usize n ) noexcept
+        {
+            std::vector<u64> sorted( hashes, hashes + n );
+            std::sort( sorted.begin(), sorted.end() );
+            return std::adjacent_find( sorted.begin(), sorted.end() ) == sorted.end();
+        }
+
+        // smallest table that places every key (hashes must be unique)
+        [[nodiscard]] constexpr phf_shape phf_solve( const u64* hashes, usize n ) noexcept
+        {
+            auto const want = std::max<usize>( n, 1 );
+            u32 slot_bits = std::max<u32>( 1, scast<u32>( std::bit_width( want - 1 )));
+            if ( want * 4 > ( usize{ 1 } << slot_bits ) * 3 )
+                ++slot_bits;
+
+            for ( ; slot_bits < 28; ++slot_bits ) {
+                phf_shape s{ .slot_bits = slot_bits, .bucket_bits = std::max<u32>( 1, slot_bits - 2 ), .ok = true };
+                std::vector<u64> disp( usize{ 1 } << s.bucket_bits );
+                phf_discard slots;
+                if ( phf_place( hashes, n, s, disp, slots ))
+                    return s;
+            }
+            return {};
+        }
+
+        template<usize N, phf_shape Shape, typename Index>
+        struct phf_table
+        {
+            static constexpr usize   slots_n   = usize{ 1 } << Shape.slot_bits;
+            static constexpr usize   buckets_n = usize{ 1 } << Shape.bucket_bits;
+            static constexpr Index   empty     = scast<Index>( -1 );
+
+            std::array<u64, buckets_n> disp{};
+            std::array<Index, slots_n> slots{};
+        };
+
+        template<usize N, phf_shape Shape>
+        using phf_index_t = std::conditional_t<( N < 0xFF ), u8, std::conditional_t<( N < 0xFFFF ), u16, u32>>;
+
+        template<usize N, phf_shape Shape>
+        [[nodiscard]] constexpr auto phf_build( const std::array<u64, N>& hashes ) noexcept
+        {
+            using index = phf_index_t<N, Shape>;
+            phf_table<N, Shape, index> t{};
+            t.slots.fill( phf_table<N, Shape, index>::empty );
+            ( void )phf_place( hashes.data(), N, Shape, t.disp, t.slots );
+            return t;
+        }
+    }
+
+    // --- phf_set<"key"...> (string keys) -------------------------------------------
+
+    template<fixed_string... Keys>
+    class phf_set
+    {
+        static constexpr usize n_ = sizeof...( Keys );
+
+        static constexpr std::array<std::string_view, n_> keys_{ std::string_view{ Keys.data, Keys.size() }... };
+
+        // the short hash unless two keys share their length and both 8-byte ends
+        static constexpr bool full_ = [] {
+            std::array<u64, n_> h{};
+            for ( usize i = 0; i < n_; ++i ) h[i] = details::phf_hash_short( keys_[i] );
+            return !details::phf_unique( h.data(), n_ );
+        }();
+
+        static constexpr std::array<u64, n_> hashes_ = [] {
+            std::array<u64, n_> h{};
+            for ( usize i = 0; i < n_; ++i ) h[i] = details::phf_hash<full_>( keys_[i] );
+            return h;
+        }();
+        static_assert( details::phf_unique( hashes_.data(), n_ ), "ct::phf_set: duplicate keys" );
+
+        static constexpr details::phf_shape shape_ = details::phf_solve( hashes_.data(), n_ );
+        static_assert( shape_.ok, "ct::phf_set: no perfect hash found for this key set" );
+
+        static constexpr auto table_ = details::phf_build<n_, shape_>( hashes_ );
+
+        template<fixed_string K>
+        static consteval usize locate() noexcept
+        {
+            constexpr std::string_view k{ K.data, K.size() };
+            for ( usize i = 0; i < n_; ++i )
+                if ( keys_[i] == k ) return i;
+            return usize( -1 );
+        }
+
+    public:
+        static constexpr usize npos       = usize( -1 );
+        static constexpr usize size       = n_;
+        static constexpr usize table_size = decltype( table_ )::slots_n;
+
+        // position of K in the key list; ill-formed when K is not a key
+        template<fixed_string K> requires ( locate<K>() != usize( -1 ))
+        static constexpr usize index_of = locate<K>();
+
+        // position of `s` in the key list, npos when absent
+        [[nodiscard]] STX_FORCE_INLINE static constexpr usize find( std::string_view s ) noexcept
+        {
+            auto const h  = details::phf_hash<full_>( s );
+            auto const at = details::phf_slot( h, table_.disp[details::phf_bucket( h, shape_.bucket_bits )], shape_.slot_bits );
+            auto const i  = scast<usize>( table_.slots[at] );
+            return i < n_ && keys_[i] == s ? i : npos;
+        }
+
+        [[nodiscard]] STX_FORCE_INLINE static constexpr bool contains( std::string_view s ) noexcept { return find( s ) != npos; }
+
+        [[nodiscard]] static constexpr std::string_view key( usize i ) noexcept { return keys_[i]; }
+        [[nodiscard]] static constexpr const auto&      keys() noexcept { return keys_; }
+    };
+
+    template<fixed_string... Keys>
+    inline constexpr phf_set<Keys...> phf{};
+
+    // --- phf_int_set<V...> (integral keys, e.g. ct::istr tags) ---------------------
+
+    template<auto... Vs>
+        requires ( sizeof...( Vs ) > 0 && ( std::integral<decltype( Vs )> && ... ))
+    class phf_int_set
+    {
+    public:
+        using key_type = std::common_type_t<decltype( Vs )...>;
+
+    private:
+        static constexpr usize n_ = sizeof...( Vs );
+
+        static constexpr std::array<key_type, n_> keys_{ scast<key_type>( Vs )... };
+
+        static constexpr std::array<u64, n_> hashes_ = [] {
+            std::array<u64, n_> h{};
+            for ( usize i = 0; i < n_; ++i ) h[i] = details::phf_mix( scast<u64>( keys_[i] ));
+            return h;
+        }();
+
+        static_assert( details::phf_unique( hashes_.data(), n_ ), "ct::phf_int_set: duplicate keys" );
+
+        static constexpr details::phf_shape shape_ = details::phf_solve( hashes_.data(), n_ );
+        static_assert( shape_.ok, "ct::phf_int_set: no perfect hash found for this key set" );
+
+        static constexpr auto table_ = details::phf_build<n_, shape_>( hashes_ );
+
+        static consteval usize locate( key_type v ) noexcept
+        {
+            for ( usize i = 0; i < n_; ++i )
+                if ( keys_[i] == v ) return i;
+            return usize( -1 );
+        }
+
+    public:
+        static constexpr usize npos       = usize( -1 );
+        static constexpr usize size       = n_;
+        static constexpr usize table_size = decltype( table_ )::slots_n;
+
+        template<key_type V> requires ( locate( V ) != usize( -1 ))
+        static constexpr usize index_of = locate( V );
+
+        [[nodiscard]] STX_FORCE_INLINE static constexpr usize find( key_type v ) noexcept
+        {
+            auto const h  = details::phf_mix( scast<u64>( v ));
+            auto const at = details::phf_slot( h, table_.disp[details::phf_bucket( h, shape_.bucket_bits )], shape_.slot_bits );
+            auto const i  = scast<usize>( table_.slots[at] );
+            return i < n_ && keys_[i] == v ? i : npos;
+        }
+
+        [[nodiscard]] STX_FORCE_INLINE static constexpr bool contains( key_type v ) noexcept { return find( v ) != npos; }
+
+        [[nodiscard]] static constexpr key_type    key( usize i ) noexcept { return keys_[i]; }
+        [[nodiscard]] static constexpr const auto& keys() noexcept { return keys_; }
+    };
+
+    template<auto... Vs>
+    inline constexpr phf_int_set<Vs...> phf_int{};
+
+    // --- phf_tag_set<"tag"...> (<= 8-byte names packed like ct::istr<K, u64>) -------
+    // For fixed-width name fields (PE section names, magic tags): pack the raw
+    // field with pack() or mem::read<u64>, then one integer lookup.
+
+    template<fixed_string... Keys>
+        requires (( Keys.size() > 0 && Keys.size() <= 8 ) && ... )
+    class phf_tag_set : public phf_int_set<istr<Keys, u64>...>
+    {
+        using base = phf_int_set<istr<Keys, u64>...>;
+
+    public:
+        template<fixed_string K> requires ( base::template index_of<istr<K, u64>> != base::npos )
+        static constexpr usize index_of = base::template index_of<istr<K, u64>>;
+
+        // up to 8 bytes, zero-padded, little-endian (ct::istr<K, u64> layout)
+        [[nodiscard]] STX_FORCE_INLINE static constexpr u64 pack( std::string_view s ) noexcept
+        {
+            auto const n = std::min<usize>( s.size(), 8 );
+            return n ? details::phf_load( s.data(), n ) : 0;
+        }
+
+        using base::find;
+
+        [[nodiscard]] STX_FORCE_INLINE static constexpr usize find( std::string_view s ) noexcept
+        {
+            return s.size() <= 8 ? base::find( pack( s )) : base::npos;
+        }
+
+        using base::contains;
+
+        [[nodiscard]] STX_FORCE_INLINE static constexpr bool contains( std::string_view s ) noexcept
+        {
+            return find( s ) != base::npos;
+        }
+    };
+
+    template<fixed_string... Keys>
+    inline constexpr phf_tag_set<Keys...> phf_tag{};
+}
+
+#undef STX_FORCE_INLINE
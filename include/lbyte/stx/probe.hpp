@@ -0,0 +1,344 @@
+#pragma once
+#include "core.hpp"
+#include "ct.hpp"
+#include "time.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx::time
+{
+    // --- histogram (log-linear, HDR style) ---------------------------------------
+    // Values below 64 are exact; above, every power of two is split into 32
+    // buckets, so a bucket is within ~3% of the value it holds. Values from
+    // 2^44 ticks (~1.6 h at 3 GHz) land in the top bucket.
+
+    class histogram
+    {
+    public:
+        static constexpr u32   sub_bits = 5;
+        static constexpr u32   max_bits = 44;
+        static constexpr usize buckets  = usize{ max_bits - sub_bits + 1 } << sub_bits;
+
+        [[nodiscard]] static constexpr usize bucket_of( u64 v ) noexcept
+        {
+            v = std::min( v, ( u64{ 1 } << max_bits ) - 1 );
+            auto const width = scast<u32>( std::bit_width( v ));
+            if ( width <= sub_bits + 1 )
+                return scast<usize>( v );
+            auto const e = width - sub_bits - 1;
+            return ( usize{ e } << sub_bits ) + scast<usize>( v >> e );
+        }
+
+        // smallest value mapped to bucket `i`
+        [[nodiscard]] static constexpr u64 lower_of( usize i ) noexcept
+        {
+            if ( i < ( usize{ 2 } << sub_bits ))
+                return i;
+            auto const e = scast<u32>( i >> sub_bits ) - 1;
+            return scast<u64>( i - ( usize{ e } << sub_bits )) << e;
+        }
+
+        // value reported for bucket `i` (its midpoint)
+        [[nodiscard]] static constexpr u64 value_of( usize i ) noexcept
+        {
+            if ( i < ( usize{ 2 } << sub_bits ))
+                return i;
+            auto const e = scast<u32>( i >> sub_bits ) - 1;
+            return lower_of( i ) + ((( u64{ 1 } << e ) - 1 ) >> 1 );
+        }
+
+        std::array<u64, buckets> counts{};
+        u64 total = 0;
+        u64 sum   = 0;
+        u64 min   = std::numeric_limits<u64>::max();
+        u64 max   = 0;
+
+        void record( u64 v ) noexcept
+        {
+            ++counts[bucket_of( v )];
+            ++total;
+            sum += v;
+            min  = std::min( min, v );
+            max  = std::max( max, v );
+        }
+
+        histogram& merge( const histogram& o ) noexcept
+        {
+            for ( usize i = 0; i < buckets; ++i )
+                counts[i] += o.counts[i];
+            total += o.total;
+            sum   += o.sum;
+            min    = std::min( min, o.min );
+            max    = std::max( max, o.max );
+            return *this;
+        }
+
+        // value at quantile q in [0, 1]; 0 when empty
+        [[nodiscard]] u64 percentile( double q ) const noexcept
+        {
+            if ( total == 0 )
+                return 0;
+
+            auto const rank = std::max<u64>( 1, scast<u64>( std::ceil( std::clamp( q, 0.0, 1.0 ) * scast<double>( total ))));
+            u64 seen = 0;
+            for ( usize i = 0; i < buckets; ++i ) {
+                seen += counts[i];
+                if ( seen >= rank )
+                    return std::clamp( value_of( i ), min, max );
+            }
+            return max;
+        }
+
+        [[nodiscard]] double mean() const noexcept
+        {
+            return total ? scast<double>( sum ) / scast<double>( total ) : 0.0;
+        }
+    };
+
+    // --- probe_site (one named probe, one slot per thread) ------------------------
+    // Each thread records into its own slot with relaxed loads and stores (single
+    // writer, no lock prefix, no shared cache lines). snapshot() sums the slots
+    // while writers keep running; a sample in flight may be missed or counted in
+    // `counts` before `total`. Slots of exited threads keep their counts and are
+    // reused by the next thread that hits the probe.
+
+    template<ct::fixed_string Name>
+    class probe;
+
+    class probe_site
+    {
+        struct alignas( 64 ) slot
+        {
+            std::array<std::atomic<u64>, histogram::buckets> counts{};
+            std::atomic<u64>  total{ 0 };
+            std::atomic<u64>  sum  { 0 };
+            std::atomic<u64>  min  { std::numeric_limits<u64>::max() };
+            std::atomic<u64>  max  { 0 };
+            std::atomic<bool> owned{ true };
+            slot*             next = nullptr;
+
+            STX_FORCE_INLINE static void bump( std::atomic<u64>& a, u64 by ) noexcept
+            {
+                a.store( a.load( std::memory_order_relaxed ) + by, std::memory_order_relaxed );
+            }
+
+            STX_FORCE_INLINE void record( u64 v ) noexcept
+            {
+                bump( counts[histogram::bucket_of( v )], 1 );
+                bump( total, 1 );
+                bump( sum, v );
+                if ( v < min.load( std::memory_order_relaxed )) min.store( v, std::memory_order_relaxed );
+                if ( v > max.load( std::memory_order_relaxed )) max.store( v, std::memory_order_relaxed );
+            }
+        };
+
+        // returns the slot to the site when its thread exits
+        struct lease
+        {
+            slot* s = nullptr;
+            ~lease() { if ( s ) s->owned.store( false, std::memory_order_release ); }
+        };
+
+        std::string_view   name_;
+        std::atomic<slot*> slots_{ nullptr };     // push-only
+        probe_site*        next_ = nullptr;       // registry
+
+        static std::atomic<probe_site*>& registry() noexcept
+        {
+            static std::atomic<probe_site*> head{ nullptr };
+            return head;
+        }
+
+        template<typename Fn>
+        friend void for_each_probe( Fn&& fn );
+
+        template<ct::fixed_string>
+        friend class probe;
+
+        slot* acquire()
+        {
+            for ( auto* s = slots_.load( std::memory_order_acquire ); s; s = s->next ) {
+                bool expected = false;
+                if ( s->owned.compare_exchange_strong( expected, true, std::memory_order_acquire ))
+                    return s;
+            }
+
+            auto* s = new slot;
+            s->next = slots_.load( std::memory_order_relaxed );
+            while ( !slots_.compare_exchange_weak( s->next, s, std::memory_order_release, std::memory_order_relaxed ))
+                ;
+            return s;
+        }
+
+    public:
+        // registers the site; sites live for the whole program (function-local
+        // statics of probe<Name>)
+        explicit probe_site( std::string_view name ) noexcept : name_( name )
+        {
+            auto& head = registry();
+            next_ = head.load( std::memory_order_relaxed );
+            while ( !head.compare_exchange_weak( next_, this, std::memory_order_release, std::memory_order_relaxed ))
+                ;
+        }
+
+        probe_site( const probe_site& ) = delete;
+        auto operator=( const probe_site& ) -> probe_site& = delete;
+
+        [[nodiscard]] std::string_view name() const noexcept { return name_; }
+
+        [[nodiscard]] histogram snapshot() const noexcept
+        {
+            histogram h;
+            for ( auto* s = slots_.load( std::memory_order_acquire ); s; s = s->next ) {
+                for ( usize i = 0; i < histogram::buckets; ++i )
+                    h.counts[i] += s->counts[i].load( std::memory_order_relaxed );
+                h.total += s->total.load( std::memory_order_relaxed );
+                h.sum   += s->sum.load( std::memory_order_relaxed );
+                h.min    = std::min( h.min, s->min.load( std::memory_order_relaxed ));
+                h.max    = std::max( h.max, s->max.load( std::memory_order_relaxed ));
+            }
+            return h;
+        }
+
+        // zero every slot; samples recorded concurrently may survive or be lost
+        void reset() noexcept
+        {
+            for ( auto* s = slots_.load( std::memory_order_acquire ); s; s = s->next ) {
+                for ( auto& c : s->counts )
+                    c.store( 0, std::memory_order_relaxed );
+                s->total.store( 0, std::memory_order_relaxed );
+                s->sum.store( 0, std::memory_order_relaxed );
+                s->min.store( std::numeric_limits<u64>::max(), std::memory_order_relaxed );
+                s->max.store( 0, std::memory_order_relaxed );
+            }
+        }
+    };
+
+    // every registered site, newest first
+    template<typename Fn>
+    void for_each_probe( Fn&& fn )
+    {
+        for ( auto* p = probe_site::registry().load( std::memory_order_acquire ); p; p = p->next_ )
+            fn( *p );
+    }
+
+    // --- probe<Name> (scoped timer) ------------------------------------------------
+    // Two cycles() reads and a thread-local slot update per scope; cheap enough to
+    // stay compiled into release builds.
+    //
+    //     { auto _ = time::probe<"pe.sections">{}; parse_sections(cur); }
+
+    template<ct::fixed_string Name>
+    class [[nodiscard]] probe
+    {
+        u64 start_ = cycles();
+
+    public:
+        static constexpr std::string_view name{ Name.data, Name.size() };
+
+        [[nodiscard]] static probe_site& site() noexcept
+        {
+            static probe_site s{ name };
+            return s;
+        }
+
+        // an externally measured sample, in cycles() ticks
+        STX_FORCE_INLINE static void record( u64 ticks )
+        {
+            thread_local probe_site::lease mine;
+            if ( !mine.s ) [[unlikely]]
+                mine.s = site().acquire();
+            mine.s->record( ticks );
+        }
+
+        probe() noexcept = default;
+        probe( const probe& ) = delete;
+        auto operator=( const probe& ) -> probe& = delete;
+
+        STX_FORCE_INLINE ~probe() { record( cycles() - start_ ); }
+    };
+
+    // --- reports ---------------------------------------------------------------------
+
+    struct probe_summary
+    {
+        std::string_view         name;
+        u64                      count = 0;
+        std::chrono::nanoseconds min{}, p50{}, p99{}, p999{}, max{}, mean{};
+    };
+
+    [[nodiscard]] inline probe_summary summarize( std::string_view name, const histogram& h ) noexcept
+    {
+        auto ns = []( double ticks ) {
+            return std::chrono::nanoseconds{ scast<i64>( ticks * ns_per_cycle() + 0.5 ) };
+        };
+        probe_summary r{ .name = name, .count = h.total };
+        if ( h.total ) {
+            r.min  = ns( scast<double>( h.min ));
+            r.p50  = ns( scast<double>( h.percentile( 0.50  )));
+            r.p99  = ns( scast<double>( h.percentile( 0.99  )));
+            r.p999 = ns( scast<double>( h.percentile( 0.999 )));
+            r.max  = ns( scast<double>( h.max ));
+            r.mean = ns( h.mean() );
+        }
+        return r;
+    }
+
+    // summaries of every site, sorted by name
+    [[nodiscard]] inline std::vector<probe_summary> probe_report()
+    {
+        std::vector<probe_summary> out;
+        for_each_probe( [&]( const probe_site& p ) { out.push_back( summarize( p.name(), p.snapshot() )); });
+        std::ranges::sort( out, {}, &probe_summary::name );
+        return out;
+    }
+
+    // one line per site: name, count, min / p50 / p99 / p999 / max in ns
+    inline void dump_probes( std::ostream& os )
+    {
+        auto const report = probe_report();
+
+        usize width = 4;
+        for ( auto const& r : report )
+            width = std::max( width, r.name.size() );
+
+        char line[160];
+        std::snprintf( line, sizeof( line ), "%-*s %12s %10s %10s %10s %10s %10s\n",
+                       scast<int>( width ), "name", "count", "min", "p50", "p99", "p999", "max" );
+        os << line;
+
+        for ( auto const& r : report ) {
+            os.write( r.name.data(), scast<std::streamsize>( r.name.size() ));
+            std::snprintf( line, sizeof( line ), "%*s %12llu %10lld %10lld %10lld %10lld %10lld\n",
+                           scast<int>( width - r.name.size() ), "",
+                           scast<unsigned long long>( r.count ),
+                           scast<long long>( r.min.count() ),  scast<long long>( r.p50.count() ),
+                           scast<long long>( r.p99.count() ),  scast<long long>( r.p999.count() ),
+                           scast<long long>( r.max.count() ));
+            os << line;
+        }
+    }
+
+    inline void reset_probes() noexcept
+    {
+        for_each_probe( []( probe_site& p ) { p.reset(); });
+    }
+}
+
+#undef STX_FORCE_INLINE
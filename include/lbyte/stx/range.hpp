@@ -2,6 +2,9 @@
 
 #include "../stx/core.hpp"
 #include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
 
 namespace lbyte::stx
 {
@@ -35,6 +38,9 @@ namespace lbyte::stx
         template<rangeable T>
         struct range_view;
 
+        template<rangeable T>
+        struct range_chunks;
+
         template<typename T>
         constexpr auto unwrap( T value ) noexcept
         {
@@ -153,11 +159,17 @@ namespace lbyte::stx
 }
 
 // DETAILS IMPLEMENTATIONS ---------------------------------------------------
+// range_iter is random access: positions are counted by `remaining`, so two
+// iterators of one view compare and subtract without touching `cur`.
 template<lbyte::stx::details::rangeable Type>
 struct lbyte::stx::details::range_iter
 {
     using ValueT = base_type_t<Type>;
 
+    using value_type       = Type;
+    using difference_type  = std::ptrdiff_t;
+    using iterator_concept = std::random_access_iterator_tag;
+
     ValueT cur ;
     ValueT step;
 
@@ -173,6 +185,11 @@ struct lbyte::stx::details::range_iter
             return Type { cur };
     }
 
+    constexpr Type operator[]( difference_type n ) const noexcept
+    {
+        return *( *this + n );
+    }
+
     constexpr range_iter& operator++() noexcept
     {
         if ( remaining > 0 )
@@ -188,6 +205,60 @@ struct lbyte::stx::details::range_iter
         return *this;
     }
 
+    constexpr range_iter operator++( int ) noexcept { auto t = *this; ++*this; return t; }
+
+    constexpr range_iter& operator--() noexcept
+    {
+        if ( dir_ == dir::fwd )
+            cur -= step;
+        else
+            cur += step;
+
+        ++remaining;
+        return *this;
+    }
+
+    constexpr range_iter operator--( int ) noexcept { auto t = *this; --*this; return t; }
+
+    // modular in ValueT, so unsigned types step back through negative n
+    constexpr range_iter& operator+=( difference_type n ) noexcept
+    {
+        auto const delta = static_cast<ValueT>( static_cast<ValueT>( n ) * step );
+
+        if ( dir_ == dir::fwd )
+            cur = static_cast<ValueT>( cur + delta );
+        else
+            cur = static_cast<ValueT>( cur - delta );
+
+        remaining -= static_cast<::lbyte::stx::usize>( n );
+        return *this;
+    }
+
+    constexpr range_iter& operator-=( difference_type n ) noexcept { return *this += -n; }
+
+    friend constexpr range_iter operator+( range_iter it, difference_type n ) noexcept { return it += n; }
+    friend constexpr range_iter operator+( difference_type n, range_iter it ) noexcept { return it += n; }
+    friend constexpr range_iter operator-( range_iter it, difference_type n ) noexcept { return it -= n; }
+
+    friend constexpr difference_type operator-( const range_iter& a, const range_iter& b ) noexcept
+    {
+        return static_cast<difference_type>( b.remaining - a.remaining );
+    }
+
+    friend constexpr difference_type operator-( range_sentinel, const range_iter& it ) noexcept
+    {
+        return static_cast<difference_type>( it.remaining );
+    }
+
+    friend constexpr difference_type operator-( const range_iter& it, range_sentinel ) noexcept
+    {
+        return -static_cast<difference_type>( it.remaining );
+    }
+
+    constexpr bool operator==( const range_iter& o ) const noexcept { return remaining == o.remaining; }
+
+    constexpr auto operator<=>( const range_iter& o ) const noexcept { return o.remaining <=> remaining; }
+
     constexpr bool operator==( range_sentinel ) const noexcept
     {
         return remaining == 0;
@@ -208,40 +279,54 @@ struct lbyte::stx::details::range_view
     dir       dir_ ;
     range_mode mode;
 
-    constexpr auto begin() const noexcept
+    // number of values the view yields
+    [[nodiscard]] constexpr ::lbyte::stx::usize size() const noexcept
     {
-        ::lbyte::stx::usize remaining = 0;
-
         assert( step != 0 && "range: step must be non-zero" );
 
+        ::lbyte::stx::usize dist = 0;
+
         if ( dir_ == dir::fwd )
         {
-            if ( from <= to )
-            {
-                auto dist = static_cast<::lbyte::stx::usize>( to - from );
-                auto step_u = static_cast<::lbyte::stx::usize>( step );
-
-                if ( mode == range_mode::Exclusive )
-                    remaining = (dist + step_u - 1) / step_u;
-                else
-                    remaining = dist / step_u + 1;
-            }
+            if ( from > to )
+                return 0;
+            dist = static_cast<::lbyte::stx::usize>( to - from );
         }
         else
         {
-            if ( from >= to )
-            {
-                auto dist = static_cast<::lbyte::stx::usize>( from - to );
-                auto step_u = static_cast<::lbyte::stx::usize>( step );
-
-                if ( mode == range_mode::Exclusive )
-                    remaining = (dist + step_u - 1) / step_u;
-                else
-                    remaining = dist / step_u + 1;
-            }
+            if ( from < to )
+                return 0;
+            dist = static_cast<::lbyte::stx::usize>( from - to );
         }
 
-        auto it = iter_t { from, step, remaining, dir_ };
+        auto step_u = static_cast<::lbyte::stx::usize>( step );
+
+        if ( mode == range_mode::Exclusive )
+            return (dist + step_u - 1) / step_u;
+        else
+            return dist / step_u + 1;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+    // underlying value of element `i` (i < size())
+    [[nodiscard]] constexpr ValueT nth( ::lbyte::stx::usize i ) const noexcept
+    {
+        auto const delta = static_cast<ValueT>( static_cast<ValueT>( i ) * step );
+        return dir_ == dir::fwd ? static_cast<ValueT>( from + delta ) : static_cast<ValueT>( from - delta );
+    }
+
+    [[nodiscard]] constexpr T operator[]( ::lbyte::stx::usize i ) const noexcept
+    {
+        if constexpr ( std::integral<T> )
+            return nth( i );
+        else
+            return T { nth( i ) };
+    }
+
+    constexpr auto begin() const noexcept
+    {
+        auto it = iter_t { from, step, size(), dir_ };
 
         return it;
     }
@@ -249,4 +334,53 @@ struct lbyte::stx::details::range_view
     constexpr auto end() const noexcept {
         return details::range_sentinel{};
     }
+
+    // `parts` contiguous sub-views with the same step and direction; sizes
+    // differ by at most one
+    [[nodiscard]] constexpr range_chunks<T> chunks( ::lbyte::stx::usize parts ) const noexcept
+    {
+        return { *this, parts == 0 ? 1 : parts };
+    }
+};
+
+// RANGE CHUNKS -----------------------------------------------------------------
+template<lbyte::stx::details::rangeable T>
+struct lbyte::stx::details::range_chunks
+{
+    range_view<T>       whole;
+    ::lbyte::stx::usize parts;
+
+    [[nodiscard]] constexpr ::lbyte::stx::usize size() const noexcept { return parts; }
+
+    // chunk k covers elements [k * n / parts, (k + 1) * n / parts) of `whole`;
+    // stored as an inclusive view so the bound never leaves the value type
+    [[nodiscard]] constexpr range_view<T> operator[]( ::lbyte::stx::usize k ) const noexcept
+    {
+        auto const n    = whole.size();
+        auto const q    = n / parts;
+        auto const r    = n % parts;
+        auto const b    = k * q + ( k < r ? k : r );
+        auto const e    = b + q + ( k < r ? 1 : 0 );
+
+        if ( b == e )
+            return { whole.from, whole.from, whole.step, whole.dir_, range_mode::Exclusive };
+        return { whole.nth( b ), whole.nth( e - 1 ), whole.step, whole.dir_, range_mode::Inclusive };
+    }
+
+    struct iterator
+    {
+        using value_type      = range_view<T>;
+        using difference_type = std::ptrdiff_t;
+
+        const range_chunks* owner = nullptr;
+        ::lbyte::stx::usize k     = 0;
+
+        constexpr range_view<T> operator*() const noexcept { return ( *owner )[k]; }
+        constexpr iterator& operator++() noexcept { ++k; return *this; }
+        constexpr iterator operator++( int ) noexcept { auto t = *this; ++k; return t; }
+        constexpr bool operator==( const iterator& o ) const noexcept { return k == o.k; }
+    };
+
+    constexpr iterator begin() const noexcept { return { this, 0 }; }
+    constexpr iterator end()   const noexcept { return { this, parts }; }
 };
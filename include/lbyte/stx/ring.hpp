@@ -0,0 +1,556 @@
+#pragma once
+#include "core.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <new>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx::ring
+{
+    // --- layout ------------------------------------------------------------------
+    // A ring is one contiguous region: a header line, a producer line, a
+    // consumer line, then the slots. Indices are free-running u64 counters and
+    // every field is address-free, so the region can live in a shared mapping
+    // (map_file::create + map_flag::write) and be attached from another process.
+    //
+    //   [0,   64)  header    magic, kind, slot size, capacity, closed flag
+    //   [64, 128)  producer  tail (next index to write), producer-side cache
+    //   [128,192)  consumer  head (next index to read), consumer-side cache
+    //   [192, ..)  capacity slots
+
+    inline constexpr usize cache_line = 64;
+
+    static_assert(std::atomic<u64>::is_always_lock_free, "ring: needs lock-free 64-bit atomics");
+    static_assert(std::atomic<u32>::is_always_lock_free, "ring: needs lock-free 32-bit atomics");
+
+    enum class kind : u8
+    {
+        spsc = 1,
+        mpsc = 2,
+    };
+
+    namespace details
+    {
+        inline constexpr u32 ring_magic   = 0x52585453;   // "STXR"
+        inline constexpr u16 ring_version = 1;
+
+        struct alignas(cache_line) header
+        {
+            u32              magic;
+            u16              version;
+            kind             type;
+            u8               reserved;
+            u32              slot_size;
+            u32              slot_align;
+            u64              capacity;
+            std::atomic<u32> closed;
+        };
+
+        struct alignas(cache_line) side
+        {
+            std::atomic<u64> index;
+            u64              cache;   // the other side's index, as last seen
+        };
+
+        struct control
+        {
+            header h;
+            side   prod;
+            side   cons;
+        };
+
+        static_assert(sizeof(control) == 3 * cache_line);
+
+        // pause between polls; after a while, give the core away
+        struct backoff
+        {
+            u32 spins = 0;
+
+            STX_FORCE_INLINE void operator()() noexcept
+            {
+                if (spins++ < 64) {
+                #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+                    _mm_pause();
+                #elif defined(__x86_64__) || defined(__i386__)
+                    __builtin_ia32_pause();
+                #elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+                    asm volatile( "yield" );
+                #endif
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        };
+
+        struct aligned_free
+        {
+            void operator()(std::byte* p) const noexcept { ::operator delete(p, std::align_val_t{ cache_line }); }
+        };
+
+        // region bookkeeping shared by spsc and mpsc; Slot is the stored unit
+        template<class Slot>
+        class region
+        {
+        protected:
+            std::unique_ptr<std::byte, aligned_free> own_;
+            control* c_    = nullptr;
+            Slot*    s_    = nullptr;
+            u64      mask_ = 0;
+
+            region() noexcept = default;
+
+            region(control* c, std::unique_ptr<std::byte, aligned_free> own = nullptr) noexcept
+                : own_(std::move(own))
+                , c_(c)
+                , s_(rcast<Slot*>(rcast<std::byte*>(c) + sizeof(control)))
+                , mask_(c->h.capacity - 1)
+            {}
+
+            region(region&& o) noexcept
+                : own_(std::move(o.own_))
+                , c_(std::exchange(o.c_, nullptr))
+                , s_(std::exchange(o.s_, nullptr))
+                , mask_(std::exchange(o.mask_, 0))
+            {}
+
+            region& operator=(region&& o) noexcept
+            {
+                own_  = std::move(o.own_);
+                c_    = std::exchange(o.c_, nullptr);
+                s_    = std::exchange(o.s_, nullptr);
+                mask_ = std::exchange(o.mask_, 0);
+                return *this;
+            }
+
+            static constexpr usize slot_bytes(usize capacity) noexcept { return capacity * sizeof(Slot); }
+
+            static auto make(std::span<std::byte> mem, usize capacity, kind k) noexcept
+                -> std::expected<control*, std::errc>
+            {
+                if (capacity == 0 || capacity > (usize{ 1 } << 40)) [[unlikely]]
+                    return std::unexpected(std::errc::invalid_argument);
+                capacity = std::bit_ceil(capacity);
+                if (rcast<uptr>(mem.data()) % cache_line != 0) [[unlikely]]
+                    return std::unexpected(std::errc::invalid_argument);
+                if (mem.size() < sizeof(control) + slot_bytes(capacity)) [[unlikely]]
+                    return std::unexpected(std::errc::argument_out_of_domain);
+
+                auto* c = ::new (mem.data()) control{};
+                c->h.magic      = ring_magic;
+                c->h.version    = ring_version;
+                c->h.type       = k;
+                c->h.slot_size  = scast<u32>(sizeof(Slot));
+                c->h.slot_align = scast<u32>(alignof(Slot));
+                c->h.capacity   = capacity;
+                std::memset(mem.data() + sizeof(control), 0, slot_bytes(capacity));
+                return c;
+            }
+
+            static auto open(std::span<std::byte> mem, kind k) noexcept
+                -> std::expected<control*, std::errc>
+            {
+                if (rcast<uptr>(mem.data()) % cache_line != 0 || mem.size() < sizeof(control)) [[unlikely]]
+                    return std::unexpected(std::errc::invalid_argument);
+
+                auto* c = std::launder(rcast<control*>(mem.data()));
+                auto const& h = c->h;
+                if (h.magic != ring_magic || h.version != ring_version || h.type != k
+                    || h.slot_size != sizeof(Slot) || h.slot_align != alignof(Slot)
+                    || !std::has_single_bit(h.capacity)) [[unlikely]]
+                    return std::unexpected(std::errc::invalid_argument);
+                if (mem.size() - sizeof(control) < slot_bytes(scast<usize>(h.capacity))) [[unlikely]]
+                    return std::unexpected(std::errc::argument_out_of_domain);
+                return c;
+            }
+
+            // owning region; throws on a capacity make() refuses
+            static region allocate(usize capacity, kind k)
+            {
+                auto const n = sizeof(control) + slot_bytes(std::bit_ceil(std::max<usize>(capacity, 1)));
+                std::unique_ptr<std::byte, aligned_free> own{
+                    scast<std::byte*>(::operator new(n, std::align_val_t{ cache_line })) };
+                auto c = make(std::span{ own.get(), n }, std::max<usize>(capacity, 1), k);
+                if (!c) [[unlikely]]
+                    throw std::system_error(std::make_error_code(c.error()), "ring");
+                return region{ *c, std::move(own) };
+            }
+
+        public:
+            // region size for `capacity` slots (rounded up to a power of two)
+            [[nodiscard]] static constexpr usize bytes_for(usize capacity) noexcept
+            {
+                return sizeof(control) + slot_bytes(std::bit_ceil(std::max<usize>(capacity, 1)));
+            }
+
+            [[nodiscard]] usize capacity() const noexcept { return scast<usize>(mask_ + 1); }
+
+            // approximate while both sides run
+            [[nodiscard]] usize size() const noexcept
+            {
+                auto const h = c_->cons.index.load(std::memory_order_acquire);
+                auto const t = c_->prod.index.load(std::memory_order_acquire);
+                return scast<usize>(t > h ? t - h : 0);
+            }
+
+            [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+            // no more pushes; consumers drain what is left, then pop_wait fails
+            void close() noexcept { c_->h.closed.store(1, std::memory_order_release); }
+
+            [[nodiscard]] bool closed() const noexcept { return c_->h.closed.load(std::memory_order_acquire) != 0; }
+
+            // the backing region (header included)
+            [[nodiscard]] std::span<const std::byte> region_bytes() const noexcept
+            {
+                return { rcast<const std::byte*>(c_), bytes_for(capacity()) };
+            }
+        };
+    }
+
+    // --- spsc --------------------------------------------------------------------
+    // One producer thread, one consumer thread. Each side keeps the other
+    // side's index cached in its own line and rereads it only when the ring
+    // looks full (producer) or empty (consumer), so in steady state a push or
+    // pop touches one shared line. Batches are one or two memcpys.
+
+    template<binary_readable T>
+    class spsc : public details::region<T>
+    {
+        using base = details::region<T>;
+        using base::c_;
+        using base::s_;
+        using base::mask_;
+
+        spsc(details::control* c) noexcept : base(c) {}
+
+        // copy [pos, pos + n) between slots and `p`, wrapping once
+        STX_FORCE_INLINE void copy_in(u64 pos, const T* p, usize n) noexcept
+        {
+            auto const at    = scast<usize>(pos & mask_);
+            auto const first = std::min(n, this->capacity() - at);
+            std::memcpy(s_ + at, p, first * sizeof(T));
+            if (first != n) std::memcpy(s_, p + first, (n - first) * sizeof(T));
+        }
+
+        STX_FORCE_INLINE void copy_out(u64 pos, T* p, usize n) const noexcept
+        {
+            auto const at    = scast<usize>(pos & mask_);
+            auto const first = std::min(n, this->capacity() - at);
+            std::memcpy(p, s_ + at, first * sizeof(T));
+            if (first != n) std::memcpy(p + first, s_, (n - first) * sizeof(T));
+        }
+
+    public:
+        spsc() noexcept = default;
+
+        // owning ring of at least `capacity` slots (rounded up to a power of two)
+        explicit spsc(usize capacity) : base(base::allocate(capacity, kind::spsc)) {}
+
+        spsc(spsc&&) noexcept            = default;
+        spsc& operator=(spsc&&) noexcept = default;
+
+        // initialize a ring in caller memory (64-byte aligned, at least
+        // bytes_for(capacity)); the memory must outlive every view of it
+        static auto create(std::span<std::byte> mem, usize capacity) noexcept -> std::expected<spsc, std::errc>
+        {
+            auto c = base::make(mem, capacity, kind::spsc);
+            if (!c) [[unlikely]]
+                return std::unexpected(c.error());
+            return spsc{ *c };
+        }
+
+        // view a ring another view (or process) created; invalid_argument on a
+        // header that does not describe an spsc<T>
+        static auto attach(std::span<std::byte> mem) noexcept -> std::expected<spsc, std::errc>
+        {
+            auto c = base::open(mem, kind::spsc);
+            if (!c) [[unlikely]]
+                return std::unexpected(c.error());
+            return spsc{ *c };
+        }
+
+        // --- producer ------------------------------------------------------
+
+        [[nodiscard]] bool try_push(const T& v) noexcept
+        {
+            auto& p = c_->prod;
+            auto const t = p.index.load(std::memory_order_relaxed);
+            if (t - p.cache == this->capacity()) {
+                p.cache = c_->cons.index.load(std::memory_order_acquire);
+                if (t - p.cache == this->capacity()) return false;
+            }
+            std::memcpy(s_ + (t & mask_), &v, sizeof(T));
+            p.index.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        // as many of `in` as fit; returns the count pushed
+        usize push(std::span<const T> in) noexcept
+        {
+            auto& p = c_->prod;
+            auto const t = p.index.load(std::memory_order_relaxed);
+            auto room = this->capacity() - scast<usize>(t - p.cache);
+            if (room < in.size()) {
+                p.cache = c_->cons.index.load(std::memory_order_acquire);
+                room    = this->capacity() - scast<usize>(t - p.cache);
+            }
+            auto const n = std::min(room, in.size());
+            if (n == 0) return 0;
+            copy_in(t, in.data(), n);
+            p.index.store(t + n, std::memory_order_release);
+            return n;
+        }
+
+        // spins (then yields) until there is room
+        void push_wait(const T& v) noexcept
+        {
+            details::backoff wait;
+            while (!try_push(v)) wait();
+        }
+
+        void push_wait(std::span<const T> in) noexcept
+        {
+            details::backoff wait;
+            while (!in.empty()) {
+                auto const n = push(in);
+                in = in.subspan(n);
+                if (n == 0) wait();
+            }
+        }
+
+        // --- consumer ------------------------------------------------------
+
+        [[nodiscard]] bool try_pop(T& out) noexcept
+        {
+            auto& q = c_->cons;
+            auto const h = q.index.load(std::memory_order_relaxed);
+            if (h == q.cache) {
+                q.cache = c_->prod.index.load(std::memory_order_acquire);
+                if (h == q.cache) return false;
+            }
+            std::memcpy(&out, s_ + (h & mask_), sizeof(T));
+            q.index.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        // up to out.size() elements; returns the count popped
+        usize pop(std::span<T> out) noexcept
+        {
+            auto& q = c_->cons;
+            auto const h = q.index.load(std::memory_order_relaxed);
+            auto ready = scast<usize>(q.cache - h);
+            if (ready < out.size()) {
+                q.cache = c_->prod.index.load(std::memory_order_acquire);
+                ready   = scast<usize>(q.cache - h);
+            }
+            auto const n = std::min(ready, out.size());
+            if (n == 0) return 0;
+            copy_out(h, out.data(), n);
+            q.index.store(h + n, std::memory_order_release);
+            return n;
+        }
+
+        // waits for an element; false once the ring is closed and drained
+        [[nodiscard]] bool pop_wait(T& out) noexcept
+        {
+            details::backoff wait;
+            for (;;) {
+                if (try_pop(out)) return true;
+                if (this->closed()) return try_pop(out);
+                wait();
+            }
+        }
+
+        // waits for at least one element; 0 once closed and drained
+        usize pop_wait(std::span<T> out) noexcept
+        {
+            details::backoff wait;
+            for (;;) {
+                if (auto n = pop(out)) return n;
+                if (this->closed()) return pop(out);
+                wait();
+            }
+        }
+    };
+
+    // --- mpsc --------------------------------------------------------------------
+    // Any number of producers, one consumer. Producers claim a run of indices
+    // with one CAS on the tail (bounded by the consumer's head), fill it, and
+    // publish each slot through its sequence word; the consumer takes slots in
+    // order while they are published. A producer stalled between claim and
+    // publish holds back the consumer at that slot, not the other producers.
+
+    namespace details
+    {
+        template<class T>
+        struct mpsc_slot
+        {
+            std::atomic<u64> seq;   // index + 1 once the value is published
+            T                value;
+        };
+    }
+
+    template<binary_readable T>
+    class mpsc : public details::region<details::mpsc_slot<T>>
+    {
+        using slot = details::mpsc_slot<T>;
+        using base = details::region<slot>;
+        using base::c_;
+        using base::s_;
+        using base::mask_;
+
+        mpsc(details::control* c) noexcept : base(c) {}
+
+        // claims up to `want` indices; returns the first and the count
+        STX_FORCE_INLINE std::pair<u64, usize> claim(usize want) noexcept
+        {
+            auto& tail = c_->prod.index;
+            auto  t    = tail.load(std::memory_order_relaxed);
+            for (;;) {
+                auto const h    = c_->cons.index.load(std::memory_order_acquire);
+                auto const room = this->capacity() - scast<usize>(t - h);
+                auto const n    = std::min(room, want);
+                if (n == 0) return { t, 0 };
+                if (tail.compare_exchange_weak(t, t + n, std::memory_order_relaxed)) return { t, n };
+            }
+        }
+
+    public:
+        mpsc() noexcept = default;
+
+        explicit mpsc(usize capacity) : base(base::allocate(capacity, kind::mpsc)) {}
+
+        mpsc(mpsc&&) noexcept            = default;
+        mpsc& operator=(mpsc&&) noexcept = default;
+
+        static auto create(std::span<std::byte> mem, usize capacity) noexcept -> std::expected<mpsc, std::errc>
+        {
+            auto c = base::make(mem, capacity, kind::mpsc);
+            if (!c) [[unlikely]]
+                return std::unexpected(c.error());
+            return mpsc{ *c };
+        }
+
+        static auto attach(std::span<std::byte> mem) noexcept -> std::expected<mpsc, std::errc>
+        {
+            auto c = base::open(mem, kind::mpsc);
+            if (!c) [[unlikely]]
+                return std::unexpected(c.error());
+            return mpsc{ *c };
+        }
+
+        // --- producers -----------------------------------------------------
+
+        [[nodiscard]] bool try_push(const T& v) noexcept
+        {
+            auto const [t, n] = claim(1);
+            if (n == 0) return false;
+            auto& s = s_[t & mask_];
+            std::memcpy(&s.value, &v, sizeof(T));
+            s.seq.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        // one claim for the whole run that fits; returns the count pushed
+        usize push(std::span<const T> in) noexcept
+        {
+            auto const [t, n] = claim(in.size());
+            for (usize i = 0; i < n; ++i) {
+                auto& s = s_[(t + i) & mask_];
+                std::memcpy(&s.value, &in[i], sizeof(T));
+                s.seq.store(t + i + 1, std::memory_order_release);
+            }
+            return n;
+        }
+
+        void push_wait(const T& v) noexcept
+        {
+            details::backoff wait;
+            while (!try_push(v)) wait();
+        }
+
+        void push_wait(std::span<const T> in) noexcept
+        {
+            details::backoff wait;
+            while (!in.empty()) {
+                auto const n = push(in);
+                in = in.subspan(n);
+                if (n == 0) wait();
+            }
+        }
+
+        // --- consumer ------------------------------------------------------
+
+        [[nodiscard]] bool try_pop(T& out) noexcept
+        {
+            auto& head = c_->cons.index;
+            auto const h = head.load(std::memory_order_relaxed);
+            auto& s = s_[h & mask_];
+            if (s.seq.load(std::memory_order_acquire) != h + 1) return false;
+            std::memcpy(&out, &s.value, sizeof(T));
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        // the published run at the head, up to out.size(); returns the count
+        usize pop(std::span<T> out) noexcept
+        {
+            auto& head = c_->cons.index;
+            auto const h = head.load(std::memory_order_relaxed);
+            usize n = 0;
+            for (; n < out.size(); ++n) {
+                auto& s = s_[(h + n) & mask_];
+                if (s.seq.load(std::memory_order_acquire) != h + n + 1) break;
+                std::memcpy(&out[n], &s.value, sizeof(T));
+            }
+            if (n != 0) head.store(h + n, std::memory_order_release);
+            return n;
+        }
+
+        // a claimed slot is always published, so after close() the consumer
+        // keeps draining until the tail is reached
+        [[nodiscard]] bool pop_wait(T& out) noexcept
+        {
+            details::backoff wait;
+            for (;;) {
+                if (try_pop(out)) return true;
+                if (this->closed() && c_->cons.index.load(std::memory_order_relaxed)
+                                      == c_->prod.index.load(std::memory_order_acquire))
+                    return false;
+                wait();
+            }
+        }
+
+        usize pop_wait(std::span<T> out) noexcept
+        {
+            details::backoff wait;
+            for (;;) {
+                if (auto n = pop(out)) return n;
+                if (this->closed() && c_->cons.index.load(std::memory_order_relaxed)
+                                      == c_->prod.index.load(std::memory_order_acquire))
+                    return 0;
+                wait();
+            }
+        }
+    };
+}
+
+#undef STX_FORCE_INLINE
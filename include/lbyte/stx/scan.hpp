@@ -0,0 +1,767 @@
+#pragma once
+#include "core.hpp"
+#include "ct.hpp"
+#include "par.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace lbyte::stx::scan
+{
+    inline constexpr usize npos = static_cast<usize>( -1 );
+
+    // --- signature concept -------------------------------------------------------
+    // bytes()[i] is pre-masked: a byte d matches position i when (d & mask[i]) == bytes[i].
+    // anchor0/anchor1 index fully-masked (0xFF) positions used by the SIMD filter.
+
+    template<typename P>
+    concept signature = requires (const P& p) {
+        { p.size()     } -> std::convertible_to<usize>;
+        { p.bytes()    } -> std::convertible_to<std::span<const u8>>;
+        { p.mask()     } -> std::convertible_to<std::span<const u8>>;
+        { p.anchored() } -> std::convertible_to<bool>;
+        { p.anchor0()  } -> std::convertible_to<usize>;
+        { p.anchor1()  } -> std::convertible_to<usize>;
+    };
+
+    // --- details (parser + anchors) ---------------------------------------------
+    namespace details
+    {
+        [[nodiscard]] constexpr int hex_nibble( char c ) noexcept
+        {
+            if ( c >= '0' && c <= '9' ) return c - '0';
+            if ( c >= 'a' && c <= 'f' ) return 10 + ( c - 'a' );
+            if ( c >= 'A' && c <= 'F' ) return 10 + ( c - 'A' );
+            return -1;
+        }
+
+        [[nodiscard]] constexpr bool is_space( char c ) noexcept
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        // IDA-style: "48 8B ?? ? 4?" — whitespace separated, `?`/`??` full wildcard,
+        // a `?` in one nibble masks that nibble only. Writes up to `cap` entries when
+        // `bytes`/`mask` are non-null. Returns the token count, or npos on bad input.
+        constexpr usize parse_ida( std::string_view sv, u8* bytes, u8* mask, usize cap ) noexcept
+        {
+            usize n = 0;
+            usize i = 0;
+
+            while ( i < sv.size() )
+            {
+                if ( is_space( sv[i] )) { ++i; continue; }
+
+                usize j = i;
+                while ( j < sv.size() && !is_space( sv[j] )) ++j;
+                auto const tok = sv.substr( i, j - i );
+                i = j;
+
+                u8 b = 0, m = 0;
+                if ( tok == "?" || tok == "??" ) {
+                    b = 0; m = 0;
+                } else if ( tok.size() == 2 ) {
+                    auto const hi = tok[0] == '?' ? 0 : hex_nibble( tok[0] );
+                    auto const lo = tok[1] == '?' ? 0 : hex_nibble( tok[1] );
+                    if ( hi < 0 || lo < 0 )
+                        return npos;
+                    m = static_cast<u8>(( tok[0] == '?' ? 0x00 : 0xF0 ) | ( tok[1] == '?' ? 0x00 : 0x0F ));
+                    b = static_cast<u8>((( hi << 4 ) | lo ) & m );
+                } else {
+                    return npos;
+                }
+
+                if ( bytes && mask ) {
+                    if ( n >= cap ) return npos;
+                    bytes[n] = b;
+                    mask [n] = m;
+                }
+                ++n;
+            }
+
+            return n;
+        }
+
+        // first and last fully-masked positions; npos when there are none
+        struct anchors { usize a0 = npos, a1 = npos; };
+
+        [[nodiscard]] constexpr anchors pick_anchors( const u8* mask, usize n ) noexcept
+        {
+            anchors a{};
+            for ( usize i = 0; i < n; ++i ) {
+                if ( mask[i] != 0xFF ) continue;
+                if ( a.a0 == npos ) a.a0 = i;
+                a.a1 = i;
+            }
+            return a;
+        }
+
+        template<signature P> [[nodiscard]]
+        inline bool verify( const u8* at, const P& p ) noexcept
+        {
+            auto const b = p.bytes();
+            auto const m = p.mask();
+            for ( usize k = 0; k < p.size(); ++k )
+                if (( at[k] & m[k] ) != b[k] )
+                    return false;
+            return true;
+        }
+
+        // First match starting in [from, n - size]; npos if none.
+        template<signature P> [[nodiscard]]
+        inline usize find_from( const u8* data, usize n, usize from, const P& p ) noexcept
+        {
+            auto const m = static_cast<usize>( p.size() );
+            if ( m == 0 || n < m || from > n - m )
+                return npos;
+
+            auto const last = n - m;
+            auto i = from;
+
+            if ( !p.anchored() ) {
+                for ( ; i <= last; ++i )
+                    if ( verify( data + i, p ))
+                        return i;
+                return npos;
+            }
+
+            auto const a0 = static_cast<usize>( p.anchor0() );
+            auto const a1 = static_cast<usize>( p.anchor1() );
+            auto const b0 = p.bytes()[a0];
+            auto const b1 = p.bytes()[a1];
+
+            for ( ; i + simd::lanes <= last + 1; i += simd::lanes ) {
+                auto hits = simd::eq2_mask( data + i + a0, b0, data + i + a1, b1 );
+                while ( hits ) {
+                    auto const at = i + simd::first_lane( hits );
+                    if ( verify( data + at, p ))
+                        return at;
+                    hits &= hits - 1;
+                }
+            }
+
+            for ( ; i <= last; ++i )
+                if ( data[i + a0] == b0 && data[i + a1] == b1 && verify( data + i, p ))
+                    return i;
+
+            return npos;
+        }
+    }
+
+    // --- pattern (runtime-compiled signature) -----------------------------------
+
+    class pattern
+    {
+        std::vector<u8> bytes_;
+        std::vector<u8> mask_ ;
+        details::anchors anchors_{};
+
+        void compile() noexcept
+        {
+            for ( usize i = 0; i < bytes_.size(); ++i )
+                bytes_[i] &= mask_[i];
+            anchors_ = details::pick_anchors( mask_.data(), mask_.size() );
+        }
+
+    public:
+        pattern() = default;
+
+        // mask[i] == 0xFF: exact byte, 0x00: wildcard, anything else: bit mask
+        pattern( std::span<const u8> bytes, std::span<const u8> mask )
+            : bytes_( bytes.begin(), bytes.end() )
+            , mask_ ( bytes.size(), u8{0xFF} )
+        {
+            for ( usize i = 0; i < mask.size() && i < mask_.size(); ++i )
+                mask_[i] = mask[i];
+            compile();
+        }
+
+        explicit pattern( std::span<const u8> bytes )
+            : pattern( bytes, std::span<const u8>{} )
+        {}
+
+        // IDA-style text signature: "48 8B ?? ?? 89"
+        [[nodiscard]] static auto parse( std::string_view ida )
+            -> std::expected<pattern, std::errc>
+        {
+            auto const n = details::parse_ida( ida, nullptr, nullptr, 0 );
+            if ( n == npos || n == 0 )
+                return std::unexpected( std::errc::invalid_argument );
+
+            pattern p;
+            p.bytes_.resize( n );
+            p.mask_ .resize( n );
+            details::parse_ida( ida, p.bytes_.data(), p.mask_.data(), n );
+            p.compile();
+            return p;
+        }
+
+        // code-style signature: bytes + "xx??x" ('x' = match, '?' = wildcard)
+        [[nodiscard]] static auto from_mask( std::span<const u8> bytes, std::string_view mask )
+            -> std::expected<pattern, std::errc>
+        {
+            if ( bytes.size() != mask.size() || bytes.empty() )
+                return std::unexpected( std::errc::invalid_argument );
+
+            pattern p;
+            p.bytes_.assign( bytes.begin(), bytes.end() );
+            p.mask_ .resize( mask.size() );
+            for ( usize i = 0; i < mask.size(); ++i ) {
+                if ( mask[i] != 'x' && mask[i] != '?' )
+                    return std::unexpected( std::errc::invalid_argument );
+                p.mask_[i] = mask[i] == 'x' ? u8{0xFF} : u8{0x00};
+            }
+            p.compile();
+            return p;
+        }
+
+        [[nodiscard]] usize               size()     const noexcept { return bytes_.size(); }
+        [[nodiscard]] std::span<const u8> bytes()    const noexcept { return bytes_; }
+        [[nodiscard]] std::span<const u8> mask()     const noexcept { return mask_;  }
+        [[nodiscard]] bool                anchored() const noexcept { return anchors_.a0 != npos; }
+        [[nodiscard]] usize               anchor0()  const noexcept { return anchors_.a0; }
+        [[nodiscard]] usize               anchor1()  const noexcept { return anchors_.a1; }
+    };
+
+    // --- fixed_pattern<N> (compile-time signature) ------------------------------
+
+    template<usize N>
+    struct fixed_pattern
+    {
+        std::array<u8, N> bytes_{};
+        std::array<u8, N> mask_ {};
+        usize a0_ = npos;
+        usize a1_ = npos;
+
+        [[nodiscard]] static constexpr usize size() noexcept { return N; }
+        [[nodiscard]] constexpr std::span<const u8, N> bytes() const noexcept { return bytes_; }
+        [[nodiscard]] constexpr std::span<const u8, N> mask()  const noexcept { return mask_;  }
+        [[nodiscard]] constexpr bool  anchored() const noexcept { return a0_ != npos; }
+        [[nodiscard]] constexpr usize anchor0()  const noexcept { return a0_; }
+        [[nodiscard]] constexpr usize anchor1()  const noexcept { return a1_; }
+    };
+
+    //   scan::sig<"48 8B ?? ?? 89">  -> fixed_pattern<5>
+    template<ct::fixed_string Sig>
+    inline constexpr auto sig = [] {
+        constexpr auto sv = std::string_view{ Sig.data, Sig.size() };
+        constexpr auto n  = details::parse_ida( sv, nullptr, nullptr, 0 );
+        static_assert( n != npos && n > 0, "scan::sig: malformed signature" );
+
+        fixed_pattern<n> p{};
+        details::parse_ida( sv, p.bytes_.data(), p.mask_.data(), n );
+        auto const a = details::pick_anchors( p.mask_.data(), n );
+        p.a0_ = a.a0;
+        p.a1_ = a.a1;
+        return p;
+    }();
+
+    // --- find / find_all ---------------------------------------------------------
+    // Offsets are relative to the start of `buf`. Overlapping hits are reported.
+
+    template<signature P> [[nodiscard]]
+    inline std::optional<off_s> find( std::span<const std::byte> buf, const P& pat ) noexcept
+    {
+        auto const at = details::find_from(
+            rcast<const u8*>( buf.data() ), buf.size(), 0, pat
+        );
+        if ( at == npos )
+            return std::nullopt;
+        return off_s{ scast<off_s::value_type>( at ) };
+    }
+
+    template<ct::fixed_string Sig> [[nodiscard]]
+    inline std::optional<off_s> find( std::span<const std::byte> buf ) noexcept
+    {
+        return find( buf, sig<Sig> );
+    }
+
+    template<signature P, std::invocable<off_s> Fn>
+    inline void for_each( std::span<const std::byte> buf, const P& pat, Fn&& fn )
+    {
+        auto const* data = rcast<const u8*>( buf.data() );
+        for ( auto at = details::find_from( data, buf.size(), 0, pat );
+              at != npos;
+              at = details::find_from( data, buf.size(), at + 1, pat ))
+        {
+            fn( off_s{ scast<off_s::value_type>( at ) } );
+        }
+    }
+
+    template<signature P> [[nodiscard]]
+    inline std::vector<off_s> find_all( std::span<const std::byte> buf, const P& pat )
+    {
+        std::vector<off_s> hits;
+        for_each( buf, pat, [&hits]( off_s at ) { hits.push_back( at ); } );
+        return hits;
+    }
+
+    template<ct::fixed_string Sig> [[nodiscard]]
+    inline std::vector<off_s> find_all( std::span<const std::byte> buf )
+    {
+        return find_all( buf, sig<Sig> );
+    }
+
+    // --- matcher (multi-pattern, single pass) -----------------------------------
+    // Aho-Corasick over the longest exact run of each pattern; every literal hit
+    // is verified against the full pattern + mask. A stream keeps the automaton
+    // state and the last (max_length - 1) bytes, so matches spanning chunk
+    // boundaries are found. Matches are reported once confirmed, ordered by the
+    // end of their literal run, not by offset.
+
+    struct match
+    {
+        usize id;       // index into the pattern list given to build()
+        off_s offset;   // from the first byte fed / start of the buffer
+
+        friend constexpr bool operator==(const match&, const match&) noexcept = default;
+    };
+
+    class matcher
+    {
+        struct node
+        {
+            u32 fail       = 0;
+            u32 edge_begin = 0, edge_count = 0;
+            u32 out_begin  = 0, out_count  = 0;
+        };
+
+        struct edge
+        {
+            u8  byte;
+            u32 next;
+        };
+
+        struct entry
+        {
+            u32 data;       // offset into bytes_/mask_
+            u32 size;
+            u32 lit_off;    // start of the literal run inside the pattern
+            u32 lit_len;
+        };
+
+        std::array<u32, 256> root_{};
+        std::vector<node>    nodes_;
+        std::vector<edge>    edges_;
+        std::vector<u32>     out_  ;
+        std::vector<entry>   entries_;
+        std::vector<u8>      bytes_;
+        std::vector<u8>      mask_ ;
+        usize                max_len_ = 0;
+
+        [[nodiscard]] u32 step( u32 s, u8 c ) const noexcept
+        {
+            for (;;) {
+                if ( s == 0 )
+                    return root_[c];
+                auto const& n = nodes_[s];
+                for ( u32 e = n.edge_begin; e < n.edge_begin + n.edge_count; ++e )
+                    if ( edges_[e].byte == c )
+                        return edges_[e].next;
+                s = n.fail;
+            }
+        }
+
+        [[nodiscard]] bool verify( u32 id, const u8* at ) const noexcept
+        {
+            auto const& e = entries_[id];
+            for ( u32 k = 0; k < e.size; ++k )
+                if (( at[k] & mask_[e.data + k] ) != bytes_[e.data + k] )
+                    return false;
+            return true;
+        }
+
+    public:
+        class stream;
+
+        matcher() = default;
+
+        // Fails with invalid_argument when the list is empty or a pattern has
+        // no fully-masked byte to anchor on.
+        [[nodiscard]] static auto build( std::span<const pattern> patterns )
+            -> std::expected<matcher, std::errc>
+        {
+            if ( patterns.empty() )
+                return std::unexpected( std::errc::invalid_argument );
+
+            matcher m;
+            std::vector<std::vector<edge>> trie( 1 );
+            std::vector<std::vector<u32>>  own ( 1 );
+
+            for ( usize id = 0; id < patterns.size(); ++id )
+            {
+                auto const& p = patterns[id];
+                auto const b  = p.bytes();
+                auto const k  = p.mask();
+
+                usize best_off = 0, best_len = 0;
+                for ( usize i = 0; i < p.size(); ) {
+                    if ( k[i] != 0xFF ) { ++i; continue; }
+                    usize j = i;
+                    while ( j < p.size() && k[j] == 0xFF ) ++j;
+                    if ( j - i > best_len ) { best_off = i; best_len = j - i; }
+                    i = j;
+                }
+                if ( best_len == 0 )
+                    return std::unexpected( std::errc::invalid_argument );
+
+                m.entries_.push_back({
+                    scast<u32>( m.bytes_.size() ), scast<u32>( p.size() ),
+                    scast<u32>( best_off ),        scast<u32>( best_len )
+                });
+                m.bytes_.insert( m.bytes_.end(), b.begin(), b.end() );
+                m.mask_ .insert( m.mask_ .end(), k.begin(), k.end() );
+                m.max_len_ = std::max( m.max_len_, p.size() );
+
+                u32 s = 0;
+                for ( usize i = best_off; i < best_off + best_len; ++i ) {
+                    u32 next = 0;
+                    for ( auto const& e : trie[s] )
+                        if ( e.byte == b[i] ) { next = e.next; break; }
+                    if ( next == 0 ) {
+                        next = scast<u32>( trie.size() );
+                        trie[s].push_back({ b[i], next });
+                        trie.emplace_back();
+                        own .emplace_back();
+                    }
+                    s = next;
+                }
+                own[s].push_back( scast<u32>( id ));
+            }
+
+            // breadth-first: fail links and merged outputs
+            m.nodes_.resize( trie.size() );
+            std::vector<std::vector<u32>> outs( trie.size() );
+            std::vector<u32> queue;
+            queue.reserve( trie.size() );
+
+            for ( auto const& e : trie[0] ) {
+                m.root_[e.byte] = e.next;
+                queue.push_back( e.next );
+            }
+
+            for ( usize qi = 0; qi < queue.size(); ++qi )
+            {
+                auto const s = queue[qi];
+                outs[s] = own[s];
+                auto const& f = outs[m.nodes_[s].fail];
+                outs[s].insert( outs[s].end(), f.begin(), f.end() );
+
+                for ( auto const& e : trie[s] ) {
+                    m.nodes_[e.next].fail = m.step( m.nodes_[s].fail, e.byte );
+                    queue.push_back( e.next );
+                }
+
+                // publish edges of `s` only after its children's fail links are
+                // resolved through the partially built automaton
+                m.nodes_[s].edge_begin = scast<u32>( m.edges_.size() );
+                m.nodes_[s].edge_count = scast<u32>( trie[s].size() );
+                m.edges_.insert( m.edges_.end(), trie[s].begin(), trie[s].end() );
+            }
+
+            for ( usize s = 0; s < outs.size(); ++s ) {
+                m.nodes_[s].out_begin = scast<u32>( m.out_.size() );
+                m.nodes_[s].out_count = scast<u32>( outs[s].size() );
+                m.out_.insert( m.out_.end(), outs[s].begin(), outs[s].end() );
+            }
+
+            return m;
+        }
+
+        [[nodiscard]] usize size()       const noexcept { return entries_.size(); }
+        [[nodiscard]] usize max_length() const noexcept { return max_len_; }
+
+        [[nodiscard]] stream start() const;
+
+        template<std::invocable<match> Fn>
+        void for_each( std::span<const std::byte> buf, Fn&& fn ) const;
+
+        [[nodiscard]] std::vector<match> find_all( std::span<const std::byte> buf ) const
+        {
+            std::vector<match> hits;
+            for_each( buf, [&hits]( match m ) { hits.push_back( m ); } );
+            return hits;
+        }
+    };
+
+    // --- matcher::stream (resumable state) ---------------------------------------
+
+    class matcher::stream
+    {
+        struct pending
+        {
+            u32 id;
+            u64 start;
+        };
+
+        const matcher*       m_    = nullptr;
+        u32                  node_ = 0;
+        u64                  pos_  = 0;       // bytes consumed so far
+        std::vector<u8>      tail_ ;          // last (max_length - 1) bytes
+        std::vector<pending> pending_;
+
+        friend class matcher;
+        explicit stream( const matcher& m ) : m_( &m )
+        {
+            tail_.reserve( m.max_len_ );
+        }
+
+        [[nodiscard]] u8 at( u64 i, u64 base, const u8* chunk ) const noexcept
+        {
+            return i >= base ? chunk[i - base] : tail_[tail_.size() - scast<usize>( base - i )];
+        }
+
+        [[nodiscard]] bool verify_split( u32 id, u64 start, u64 base, const u8* chunk ) const noexcept
+        {
+            auto const& e = m_->entries_[id];
+            for ( u32 k = 0; k < e.size; ++k )
+                if (( at( start + k, base, chunk ) & m_->mask_[e.data + k] ) != m_->bytes_[e.data + k] )
+                    return false;
+            return true;
+        }
+
+        template<typename Fn>
+        void confirm( u32 id, u64 start, u64 base, const u8* chunk, Fn& fn ) const
+        {
+            bool const ok = start >= base
+                ? m_->verify( id, chunk + ( start - base ))
+                : verify_split( id, start, base, chunk );
+            if ( ok )
+                fn( match{ id, off_s{ scast<off_s::value_type>( start ) } } );
+        }
+
+    public:
+        stream() = default;
+
+        [[nodiscard]] off_s position() const noexcept
+        {
+            return off_s{ scast<off_s::value_type>( pos_ ) };
+        }
+
+        void reset() noexcept
+        {
+            node_ = 0;
+            pos_  = 0;
+            tail_.clear();
+            pending_.clear();
+        }
+
+        template<std::invocable<match> Fn>
+        void feed( std::span<const std::byte> chunk, Fn&& fn )
+        {
+            auto const* data = rcast<const u8*>( chunk.data() );
+            auto const  base = pos_;
+            auto const  end  = base + chunk.size();
+
+            // candidates from earlier chunks that now have all their bytes
+            std::erase_if( pending_, [&]( const pending& p ) {
+                if ( p.start + m_->entries_[p.id].size > end )
+                    return false;
+                confirm( p.id, p.start, base, data, fn );
+                return true;
+            });
+
+            auto s = node_;
+            for ( usize i = 0; i < chunk.size(); ++i )
+            {
+                s = m_->step( s, data[i] );
+                auto const& n = m_->nodes_[s];
+                if ( n.out_count == 0 ) [[likely]]
+                    continue;
+
+                auto const abs = base + i;
+                for ( u32 o = n.out_begin; o < n.out_begin + n.out_count; ++o )
+                {
+                    auto const  id = m_->out_[o];
+                    auto const& e  = m_->entries_[id];
+                    auto const  lead = u64{ e.lit_off } + e.lit_len - 1;
+                    if ( abs < lead )
+                        continue;
+
+                    auto const start = abs - lead;
+                    if ( start + e.size <= end )
+                        confirm( id, start, base, data, fn );
+                    else
+                        pending_.push_back({ id, start });
+                }
+            }
+            node_ = s;
+            pos_  = end;
+
+            // keep the bytes a pattern straddling the next boundary may need
+            auto const keep = m_->max_len_ > 0 ? m_->max_len_ - 1 : 0;
+            if ( chunk.size() >= keep ) {
+                tail_.assign( data + ( chunk.size() - keep ), data + chunk.size() );
+            } else {
+                tail_.insert( tail_.end(), data, data + chunk.size() );
+                if ( tail_.size() > keep )
+                    tail_.erase( tail_.begin(), tail_.begin() + scast<isize>( tail_.size() - keep ));
+            }
+        }
+    };
+
+    inline auto matcher::start() const -> stream
+    {
+        return stream{ *this };
+    }
+
+    template<std::invocable<match> Fn>
+    inline void matcher::for_each( std::span<const std::byte> buf, Fn&& fn ) const
+    {
+        auto s = start();
+        s.feed( buf, fn );
+    }
+
+    // --- parallel (chunked multi-core scan) --------------------------------------
+    // The buffer is split into chunks (rounded up to whole pages) that overlap by
+    // pattern length - 1 and run on a par::pool. Each hit belongs to the chunk it
+    // starts in, so results are unique and merged in ascending offset order.
+
+    struct parallel
+    {
+        usize      chunk_size = usize{ 4 } << 20;
+        usize      threads    = 0;          // max participants, 0 = whole pool
+        par::pool* pool       = nullptr;    // nullptr = par::pool::shared()
+    };
+
+    namespace details
+    {
+        inline constexpr usize page_size = 4096;
+
+        template<typename Hit, typename ScanChunk>
+        std::vector<Hit> parallel_scan(
+            std::span<const std::byte> buf,
+            usize                      overlap,
+            const parallel&            opt,
+            ScanChunk&&                scan_chunk
+        ) {
+            auto const chunk = ( std::max( opt.chunk_size, page_size ) + page_size - 1 ) / page_size * page_size;
+            auto const count = ( buf.size() + chunk - 1 ) / chunk;
+
+            std::vector<std::vector<Hit>> parts( count );
+            auto& workers = opt.pool ? *opt.pool : par::pool::shared();
+
+            workers.run( count, [&]( usize k ) {
+                auto const begin = k * chunk;
+                auto const len   = std::min( chunk, buf.size() - begin );
+                auto const ext   = std::min( len + overlap, buf.size() - begin );
+                scan_chunk( buf.subspan( begin, ext ), begin, len, parts[k] );
+            }, opt.threads );
+
+            usize total = 0;
+            for ( auto const& p : parts ) total += p.size();
+
+            std::vector<Hit> hits;
+            hits.reserve( total );
+            for ( auto& p : parts )
+                hits.insert( hits.end(), p.begin(), p.end() );
+            return hits;
+        }
+    }
+
+    template<signature P> [[nodiscard]]
+    inline std::vector<off_s> find_all( std::span<const std::byte> buf, const P& pat, const parallel& opt )
+    {
+        auto const overlap = pat.size() > 0 ? pat.size() - 1 : 0;
+        return details::parallel_scan<off_s>( buf, overlap, opt,
+            [&pat]( std::span<const std::byte> sub, usize begin, usize len, std::vector<off_s>& out ) {
+                auto const base = off_s{ scast<off_s::value_type>( begin ) };
+                for_each( sub, pat, [&]( off_s at ) {
+                    if ( scast<usize>( at.get() ) < len )
+                        out.push_back( at + base );
+                });
+            });
+    }
+
+    template<ct::fixed_string Sig> [[nodiscard]]
+    inline std::vector<off_s> find_all( std::span<const std::byte> buf, const parallel& opt )
+    {
+        return find_all( buf, sig<Sig>, opt );
+    }
+
+    // matcher hits are ordered by (offset, id)
+    [[nodiscard]] inline std::vector<match> find_all(
+        std::span<const std::byte> buf,
+        const matcher&             m,
+        const parallel&            opt
+    ) {
+        auto const overlap = m.max_length() > 0 ? m.max_length() - 1 : 0;
+        return details::parallel_scan<match>( buf, overlap, opt,
+            [&m]( std::span<const std::byte> sub, usize begin, usize len, std::vector<match>& out ) {
+                auto const base = off_s{ scast<off_s::value_type>( begin ) };
+                m.for_each( sub, [&]( match hit ) {
+                    if ( scast<usize>( hit.offset.get() ) < len )
+                        out.push_back({ hit.id, hit.offset + base });
+                });
+                std::ranges::sort( out, []( const match& a, const match& b ) {
+                    return a.offset != b.offset ? a.offset < b.offset : a.id < b.id;
+                });
+            });
+    }
+
+    // --- cursors -----------------------------------------------------------------
+    // The same from a byte_cursor (memcur, map_file, map_view) position, without
+    // moving it. Hits are offsets from the cursor's base(), so they can be fed
+    // straight back to seek().
+
+    template<signature P, byte_cursor C> [[nodiscard]]
+    std::optional<off_s> find( const C& cur, const P& pat ) noexcept
+    {
+        auto hit = find( std::as_bytes( cur.bytes() ), pat );
+        if ( !hit ) return std::nullopt;
+        return *hit + cur.tell();
+    }
+
+    template<ct::fixed_string Sig, byte_cursor C> [[nodiscard]]
+    std::optional<off_s> find( const C& cur ) noexcept
+    {
+        return find( cur, sig<Sig> );
+    }
+
+    template<signature P, byte_cursor C> [[nodiscard]]
+    std::vector<off_s> find_all( const C& cur, const P& pat )
+    {
+        std::vector<off_s> hits;
+        auto const pos = cur.tell();
+        for_each( std::as_bytes( cur.bytes() ), pat, [&]( off_s at ) { hits.push_back( at + pos ); } );
+        return hits;
+    }
+
+    template<ct::fixed_string Sig, byte_cursor C> [[nodiscard]]
+    std::vector<off_s> find_all( const C& cur )
+    {
+        return find_all( cur, sig<Sig> );
+    }
+
+    template<byte_cursor C> [[nodiscard]]
+    std::vector<match> find_all( const C& cur, const matcher& m )
+    {
+        std::vector<match> hits;
+        auto const pos = cur.tell();
+        m.for_each( std::as_bytes( cur.bytes() ), [&]( match hit ) { hits.push_back({ hit.id, hit.offset + pos }); } );
+        return hits;
+    }
+
+    template<signature P, byte_cursor C> [[nodiscard]]
+    std::vector<off_s> find_all( const C& cur, const P& pat, const parallel& opt )
+    {
+        auto hits = find_all( std::as_bytes( cur.bytes() ), pat, opt );
+        for ( auto& h : hits ) h += cur.tell();
+        return hits;
+    }
+
+    template<byte_cursor C> [[nodiscard]]
+    std::vector<match> find_all( const C& cur, const matcher& m, const parallel& opt )
+    {
+        auto hits = find_all( std::as_bytes( cur.bytes() ), m, opt );
+        for ( auto& h : hits ) h.offset += cur.tell();
+        return hits;
+    }
+}
@@ -0,0 +1,386 @@
+#pragma once
+#include "core.hpp"
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// --- target selection ------------------------------------------------------------
+// Chosen at compile time from the target flags (-mavx2, -msse2 / x64, aarch64).
+// Each macro is 0 or 1; wider sets imply the narrower ones on the same family.
+
+#if !defined(LBYTE_STX_SIMD_AVX2)
+    #if defined(__AVX2__)
+        #define LBYTE_STX_SIMD_AVX2 1
+    #else
+        #define LBYTE_STX_SIMD_AVX2 0
+    #endif
+#endif
+
+#if !defined(LBYTE_STX_SIMD_SSE2)
+    #if LBYTE_STX_SIMD_AVX2 || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define LBYTE_STX_SIMD_SSE2 1
+    #else
+        #define LBYTE_STX_SIMD_SSE2 0
+    #endif
+#endif
+
+#if !defined(LBYTE_STX_SIMD_NEON)
+    #if defined(__ARM_NEON) && defined(__aarch64__)
+        #define LBYTE_STX_SIMD_NEON 1
+    #else
+        #define LBYTE_STX_SIMD_NEON 0
+    #endif
+#endif
+
+#if LBYTE_STX_SIMD_AVX2
+    #include <immintrin.h>
+#elif LBYTE_STX_SIMD_SSE2
+    #include <emmintrin.h>
+    #if defined(__SSSE3__)
+        #include <tmmintrin.h>
+    #endif
+#elif LBYTE_STX_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx::simd
+{
+    // --- isa ---------------------------------------------------------------------
+
+    enum class isa : u8
+    {
+        scalar,
+        sse2  ,
+        avx2  ,
+        neon  ,
+    };
+
+    #if LBYTE_STX_SIMD_AVX2
+        inline constexpr isa   native = isa::avx2;
+        inline constexpr usize lanes  = 32;
+    #elif LBYTE_STX_SIMD_SSE2
+        inline constexpr isa   native = isa::sse2;
+        inline constexpr usize lanes  = 16;
+    #elif LBYTE_STX_SIMD_NEON
+        inline constexpr isa   native = isa::neon;
+        inline constexpr usize lanes  = 16;
+    #else
+        inline constexpr isa   native = isa::scalar;
+        inline constexpr usize lanes  = 8;
+    #endif
+
+    // lane mask: bit i <-> byte i of the block
+    using mask_t = u32;
+
+    #if LBYTE_STX_SIMD_NEON && !LBYTE_STX_SIMD_SSE2
+    namespace details
+    {
+        STX_FORCE_INLINE mask_t movemask( uint8x16_t v ) noexcept
+        {
+            constexpr u8 weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+            auto const m  = vandq_u8( v, vld1q_u8( weights ));
+            auto const lo = static_cast<mask_t>( vaddv_u8( vget_low_u8 ( m )));
+            auto const hi = static_cast<mask_t>( vaddv_u8( vget_high_u8( m )));
+            return lo | ( hi << 8 );
+        }
+    }
+    #endif
+
+    // --- byte compare ------------------------------------------------------------
+    // Every kernel reads exactly `lanes` bytes from each pointer (unaligned-safe).
+
+    // Bit i set when p[i] == v.
+    [[nodiscard]] STX_FORCE_INLINE
+    mask_t eq_mask( const u8* p, u8 v ) noexcept
+    {
+        #if LBYTE_STX_SIMD_AVX2
+            auto const x = _mm256_loadu_si256( rcast<const __m256i*>( p ));
+            auto const e = _mm256_cmpeq_epi8( x, _mm256_set1_epi8( scast<char>( v )));
+            return scast<mask_t>( _mm256_movemask_epi8( e ));
+        #elif LBYTE_STX_SIMD_SSE2
+            auto const x = _mm_loadu_si128( rcast<const __m128i*>( p ));
+            auto const e = _mm_cmpeq_epi8( x, _mm_set1_epi8( scast<char>( v )));
+            return scast<mask_t>( _mm_movemask_epi8( e ));
+        #elif LBYTE_STX_SIMD_NEON
+            return details::movemask( vceqq_u8( vld1q_u8( p ), vdupq_n_u8( v )));
+        #else
+            mask_t m = 0;
+            for ( usize i = 0; i < lanes; ++i )
+                m |= scast<mask_t>( p[i] == v ) << i;
+            return m;
+        #endif
+    }
+
+    // Bit i set when p0[i] == a and p1[i] == b (two-anchor candidate filter).
+    [[nodiscard]] STX_FORCE_INLINE
+    mask_t eq2_mask( const u8* p0, u8 a, const u8* p1, u8 b ) noexcept
+    {
+        #if LBYTE_STX_SIMD_AVX2
+            auto const x = _mm256_loadu_si256( rcast<const __m256i*>( p0 ));
+            auto const y = _mm256_loadu_si256( rcast<const __m256i*>( p1 ));
+            auto const e = _mm256_and_si256(
+                _mm256_cmpeq_epi8( x, _mm256_set1_epi8( scast<char>( a ))),
+                _mm256_cmpeq_epi8( y, _mm256_set1_epi8( scast<char>( b )))
+            );
+            return scast<mask_t>( _mm256_movemask_epi8( e ));
+        #elif LBYTE_STX_SIMD_SSE2
+            auto const x = _mm_loadu_si128( rcast<const __m128i*>( p0 ));
+            auto const y = _mm_loadu_si128( rcast<const __m128i*>( p1 ));
+            auto const e = _mm_and_si128(
+                _mm_cmpeq_epi8( x, _mm_set1_epi8( scast<char>( a ))),
+                _mm_cmpeq_epi8( y, _mm_set1_epi8( scast<char>( b )))
+            );
+            return scast<mask_t>( _mm_movemask_epi8( e ));
+        #elif LBYTE_STX_SIMD_NEON
+            auto const e = vandq_u8(
+                vceqq_u8( vld1q_u8( p0 ), vdupq_n_u8( a )),
+                vceqq_u8( vld1q_u8( p1 ), vdupq_n_u8( b ))
+            );
+            return details::movemask( e );
+        #else
+            mask_t m = 0;
+            for ( usize i = 0; i < lanes; ++i )
+                m |= scast<mask_t>( p0[i] == a && p1[i] == b ) << i;
+            return m;
+        #endif
+    }
+
+    // Bit i set when lo <= p[i] <= hi (unsigned).
+    [[nodiscard]] STX_FORCE_INLINE
+    mask_t range_mask( const u8* p, u8 lo, u8 hi ) noexcept
+    {
+        #if LBYTE_STX_SIMD_AVX2
+            auto const x = _mm256_loadu_si256( rcast<const __m256i*>( p ));
+            auto const c = _mm256_min_epu8( _mm256_max_epu8( x, _mm256_set1_epi8( scast<char>( lo ))),
+                                            _mm256_set1_epi8( scast<char>( hi )));
+            return scast<mask_t>( _mm256_movemask_epi8( _mm256_cmpeq_epi8( c, x )));
+        #elif LBYTE_STX_SIMD_SSE2
+            auto const x = _mm_loadu_si128( rcast<const __m128i*>( p ));
+            auto const c = _mm_min_epu8( _mm_max_epu8( x, _mm_set1_epi8( scast<char>( lo ))),
+                                         _mm_set1_epi8( scast<char>( hi )));
+            return scast<mask_t>( _mm_movemask_epi8( _mm_cmpeq_epi8( c, x )));
+        #elif LBYTE_STX_SIMD_NEON
+            auto const x = vld1q_u8( p );
+            return details::movemask( vandq_u8( vcgeq_u8( x, vdupq_n_u8( lo )), vcleq_u8( x, vdupq_n_u8( hi ))));
+        #else
+            mask_t m = 0;
+            for ( usize i = 0; i < lanes; ++i )
+                m |= scast<mask_t>( p[i] >= lo && p[i] <= hi ) << i;
+            return m;
+        #endif
+    }
+
+    // Full mask for a block of `lanes` bytes.
+    inline constexpr mask_t all_lanes = lanes >= 32 ? ~mask_t{ 0 } : ( mask_t{ 1 } << lanes ) - 1;
+
+    // --- fixed-width equality ----------------------------------------------------
+    // equal<N>(a, b) reads exactly N bytes from each pointer; the load width
+    // and unroll come from N. Below 8 bytes: two overlapping u16 / u32 words.
+    // From 8 up: the widest block that fits (u64, 16-byte SSE2 / NEON, 32-byte
+    // AVX2), one per step plus an overlapping tail, folded into one test.
+
+    namespace details
+    {
+        template<typename W>
+        STX_FORCE_INLINE W load_word( const u8* p ) noexcept
+        {
+            W w;
+            std::memcpy( &w, p, sizeof( W ));
+            return w;
+        }
+
+        // step(acc, a, b) folds one block into acc; same(acc) tests them all
+        struct word_block
+        {
+            using acc_t = u64;
+            static constexpr usize width = 8;
+
+            STX_FORCE_INLINE static acc_t first( const u8* a, const u8* b ) noexcept
+            {
+                return load_word<u64>( a ) ^ load_word<u64>( b );
+            }
+            STX_FORCE_INLINE static acc_t step( acc_t acc, const u8* a, const u8* b ) noexcept
+            {
+                return acc | first( a, b );
+            }
+            STX_FORCE_INLINE static bool same( acc_t acc ) noexcept { return acc == 0; }
+        };
+
+        #if LBYTE_STX_SIMD_SSE2
+        struct vec16_block
+        {
+            using acc_t = __m128i;
+            static constexpr usize width = 16;
+
+            STX_FORCE_INLINE static acc_t first( const u8* a, const u8* b ) noexcept
+            {
+                return _mm_cmpeq_epi8( _mm_loadu_si128( rcast<const __m128i*>( a )),
+                                       _mm_loadu_si128( rcast<const __m128i*>( b )));
+            }
+            STX_FORCE_INLINE static acc_t step( acc_t acc, const u8* a, const u8* b ) noexcept
+            {
+                return _mm_and_si128( acc, first( a, b ));
+            }
+            STX_FORCE_INLINE static bool same( acc_t acc ) noexcept { return _mm_movemask_epi8( acc ) == 0xFFFF; }
+        };
+        #elif LBYTE_STX_SIMD_NEON
+        struct vec16_block
+        {
+            using acc_t = uint8x16_t;
+            static constexpr usize width = 16;
+
+            STX_FORCE_INLINE static acc_t first( const u8* a, const u8* b ) noexcept
+            {
+                return vceqq_u8( vld1q_u8( a ), vld1q_u8( b ));
+            }
+            STX_FORCE_INLINE static acc_t step( acc_t acc, const u8* a, const u8* b ) noexcept
+            {
+                return vandq_u8( acc, first( a, b ));
+            }
+            STX_FORCE_INLINE static bool same( acc_t acc ) noexcept { return vminvq_u8( acc ) == 0xFF; }
+        };
+        #endif
+
+        #if LBYTE_STX_SIMD_AVX2
+        struct vec32_block
+        {
+            using acc_t = __m256i;
+            static constexpr usize width = 32;
+
+            STX_FORCE_INLINE static acc_t first( const u8* a, const u8* b ) noexcept
+            {
+                return _mm256_cmpeq_epi8( _mm256_loadu_si256( rcast<const __m256i*>( a )),
+                                          _mm256_loadu_si256( rcast<const __m256i*>( b )));
+            }
+            STX_FORCE_INLINE static acc_t step( acc_t acc, const u8* a, const u8* b ) noexcept
+            {
+                return _mm256_and_si256( acc, first( a, b ));
+            }
+            STX_FORCE_INLINE static bool same( acc_t acc ) noexcept { return _mm256_movemask_epi8( acc ) == -1; }
+        };
+        #endif
+
+        // N >= B::width: whole blocks, then one overlapping block for the tail
+        template<typename B, usize N>
+        STX_FORCE_INLINE bool equal_blocks( const u8* a, const u8* b ) noexcept
+        {
+            auto acc = B::first( a, b );
+            [&]<usize... I>( std::index_sequence<I...> ) {
+                (( acc = B::step( acc, a + ( I + 1 ) * B::width, b + ( I + 1 ) * B::width )), ... );
+            }( std::make_index_sequence<N / B::width - 1>{} );
+            if constexpr ( N % B::width != 0 )
+                acc = B::step( acc, a + N - B::width, b + N - B::width );
+            return B::same( acc );
+        }
+
+        template<usize N>
+        consteval auto pick_block() noexcept
+        {
+            #if LBYTE_STX_SIMD_AVX2
+                if constexpr ( N >= 32 ) return vec32_block{};
+                else
+            #endif
+            #if LBYTE_STX_SIMD_SSE2 || LBYTE_STX_SIMD_NEON
+                if constexpr ( N >= 16 ) return vec16_block{};
+                else
+            #endif
+                return word_block{};
+        }
+    }
+
+    template<usize N>
+    [[nodiscard]] STX_FORCE_INLINE
+    bool equal( const u8* a, const u8* b ) noexcept
+    {
+        if constexpr ( N == 0 ) {
+            return true;
+        } else if constexpr ( N == 1 ) {
+            return a[0] == b[0];
+        } else if constexpr ( N < 8 ) {
+            using W = std::conditional_t<( N < 4 ), u16, u32>;
+            if constexpr ( N == sizeof( W ))
+                return details::load_word<W>( a ) == details::load_word<W>( b );
+            else
+                return (( details::load_word<W>( a ) ^ details::load_word<W>( b ))
+                      | ( details::load_word<W>( a + N - sizeof( W )) ^ details::load_word<W>( b + N - sizeof( W )))) == 0;
+        } else {
+            return details::equal_blocks<decltype( details::pick_block<N>() ), N>( a, b );
+        }
+    }
+
+    // --- byte swap ---------------------------------------------------------------
+    // Reverses the bytes of every W-byte element in one `lanes`-byte block.
+    // src and dst may be the same block.
+
+    namespace details
+    {
+        template<usize W>
+        consteval auto bswap_shuffle() noexcept
+        {
+            std::array<u8, 32> m{};
+            for (usize i = 0; i < m.size(); ++i)
+                m[i] = scast<u8>(( i % 16 ) / W * W + ( W - 1 - i % W ));
+            return m;
+        }
+
+        template<usize W>
+        inline constexpr auto bswap_shuffle_v = bswap_shuffle<W>();
+    }
+
+    template<usize W>
+        requires ( W == 2 || W == 4 || W == 8 )
+    STX_FORCE_INLINE
+    void bswap( const u8* src, u8* dst ) noexcept
+    {
+        #if LBYTE_STX_SIMD_AVX2
+            auto const x = _mm256_loadu_si256( rcast<const __m256i*>( src ));
+            auto const m = _mm256_loadu_si256( rcast<const __m256i*>( details::bswap_shuffle_v<W>.data() ));
+            _mm256_storeu_si256( rcast<__m256i*>( dst ), _mm256_shuffle_epi8( x, m ));
+        #elif LBYTE_STX_SIMD_SSE2 && defined(__SSSE3__)
+            auto const x = _mm_loadu_si128( rcast<const __m128i*>( src ));
+            auto const m = _mm_loadu_si128( rcast<const __m128i*>( details::bswap_shuffle_v<W>.data() ));
+            _mm_storeu_si128( rcast<__m128i*>( dst ), _mm_shuffle_epi8( x, m ));
+        #elif LBYTE_STX_SIMD_SSE2
+            // no pshufb: reorder 16-bit words, then swap the bytes inside each word
+            auto x = _mm_loadu_si128( rcast<const __m128i*>( src ));
+            if constexpr ( W == 4 ) {
+                x = _mm_shufflelo_epi16( x, _MM_SHUFFLE( 2, 3, 0, 1 ));
+                x = _mm_shufflehi_epi16( x, _MM_SHUFFLE( 2, 3, 0, 1 ));
+            } else if constexpr ( W == 8 ) {
+                x = _mm_shufflelo_epi16( x, _MM_SHUFFLE( 0, 1, 2, 3 ));
+                x = _mm_shufflehi_epi16( x, _MM_SHUFFLE( 0, 1, 2, 3 ));
+            }
+            x = _mm_or_si128( _mm_slli_epi16( x, 8 ), _mm_srli_epi16( x, 8 ));
+            _mm_storeu_si128( rcast<__m128i*>( dst ), x );
+        #elif LBYTE_STX_SIMD_NEON
+            auto const x = vld1q_u8( src );
+            if constexpr ( W == 2 )      vst1q_u8( dst, vrev16q_u8( x ));
+            else if constexpr ( W == 4 ) vst1q_u8( dst, vrev32q_u8( x ));
+            else                         vst1q_u8( dst, vrev64q_u8( x ));
+        #else
+            u8 tmp[lanes];
+            for ( usize i = 0; i < lanes; ++i )
+                tmp[i] = src[( i / W ) * W + ( W - 1 - i % W )];
+            for ( usize i = 0; i < lanes; ++i )
+                dst[i] = tmp[i];
+        #endif
+    }
+
+    // Index of the lowest set lane; `m` must be non-zero.
+    [[nodiscard]] STX_FORCE_INLINE
+    constexpr usize first_lane( mask_t m ) noexcept
+    {
+        return scast<usize>( std::countr_zero( m ));
+    }
+}
+
+#undef STX_FORCE_INLINE
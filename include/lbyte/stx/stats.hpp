@@ -0,0 +1,261 @@
+#pragma once
+#include "core.hpp"
+#include "ct.hpp"
+#include "time.hpp"
+
+#include <array>
+#include <string_view>
+
+// --- build switch ----------------------------------------------------------------
+// LBYTE_STX_ENABLE_STATS=1 turns the io / map_file counters on. At 0 (default)
+// every hook is an empty inline function and capture() returns zeros, so
+// exporters compile unchanged either way.
+
+#if !defined(LBYTE_STX_ENABLE_STATS)
+    #define LBYTE_STX_ENABLE_STATS 0
+#endif
+
+#if LBYTE_STX_ENABLE_STATS
+    #include "probe.hpp"
+    #include <atomic>
+    #include <mutex>
+    #include <new>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx::stats
+{
+    inline constexpr bool enabled = LBYTE_STX_ENABLE_STATS != 0;
+
+    // --- counters ----------------------------------------------------------------
+
+    enum class counter : u8
+    {
+        map_opens       ,   // map_file::open / create
+        map_failures    ,
+        bytes_mapped    ,
+        unmaps          ,
+        bytes_unmapped  ,
+        flushes         ,   // map_file::flush (msync / FlushViewOfFile)
+        flush_failures  ,
+        flush_ns        ,   // total time spent in flush
+        reads           ,   // io::read over istream, io::file::read_at
+        read_failures   ,
+        short_reads     ,   // fewer bytes than asked (end of file, truncated stream)
+        bytes_read      ,
+        writes          ,   // io::write over ostream / map_file, io::file::write_at
+        write_failures  ,
+        bytes_written   ,
+        bounds_failures ,   // io::read / io::write offset past a map_file or span
+        cursor_clamps   ,   // memcur::seek / advance target outside the buffer
+
+        count_
+    };
+
+    inline constexpr usize counter_count = scast<usize>( counter::count_ );
+
+    [[nodiscard]] constexpr std::string_view name( counter c ) noexcept
+    {
+        constexpr std::array<std::string_view, counter_count> names{
+            "map_opens", "map_failures", "bytes_mapped", "unmaps", "bytes_unmapped",
+            "flushes", "flush_failures", "flush_ns",
+            "reads", "read_failures", "short_reads", "bytes_read",
+            "writes", "write_failures", "bytes_written",
+            "bounds_failures", "cursor_clamps",
+        };
+        return scast<usize>( c ) < counter_count ? names[scast<usize>( c )] : std::string_view{};
+    }
+
+    // --- snapshot ----------------------------------------------------------------
+
+    struct snapshot
+    {
+        std::array<u64, counter_count> values{};
+
+        [[nodiscard]] constexpr u64 operator[]( counter c ) const noexcept { return values[scast<usize>( c )]; }
+
+        // growth since `earlier`, for rate-based exporters
+        [[nodiscard]] constexpr snapshot operator-( const snapshot& earlier ) const noexcept
+        {
+            snapshot d;
+            for ( usize i = 0; i < counter_count; ++i )
+                d.values[i] = values[i] - earlier.values[i];
+            return d;
+        }
+
+        // fn(std::string_view name, u64 value) for every counter
+        template<typename Fn>
+        constexpr void for_each( Fn&& fn ) const
+        {
+            for ( usize i = 0; i < counter_count; ++i )
+                fn( name( scast<counter>( i )), values[i] );
+        }
+    };
+
+#if LBYTE_STX_ENABLE_STATS
+
+    namespace details
+    {
+        // one block per thread; the owning thread is the only writer
+        struct block
+        {
+            std::array<std::atomic<u64>, counter_count> v{};
+            block* prev = nullptr;
+            block* next = nullptr;
+        };
+
+        struct registry
+        {
+            std::mutex                                  mtx;
+            block*                                      head = nullptr;
+            std::array<std::atomic<u64>, counter_count> retired{};   // exited threads
+        };
+
+        // never destroyed: threads may still exit after static destructors run.
+        // nullptr if the allocation failed; counting then becomes a no-op.
+        inline registry* global() noexcept
+        {
+            static auto* r = new ( std::nothrow ) registry;
+            return r;
+        }
+
+        // registered on a thread's first add(), which is noexcept: a failed
+        // registration leaves the block unlinked, so that thread's counts are
+        // dropped instead of terminating the process
+        struct local
+        {
+            block b;
+            bool  linked = false;
+
+            local() noexcept
+            {
+                auto* r = global();
+                if ( !r ) return;
+                try {
+                    std::lock_guard lock{ r->mtx };
+                    b.next = r->head;
+                    if ( r->head ) r->head->prev = &b;
+                    r->head = &b;
+                    linked = true;
+                } catch ( ... ) {}   // std::system_error from the lock
+            }
+
+            ~local()
+            {
+                if ( !linked ) return;
+                auto& r = *global();
+                std::lock_guard lock{ r.mtx };
+                for ( usize i = 0; i < counter_count; ++i )
+                    r.retired[i].fetch_add( b.v[i].load( std::memory_order_relaxed ), std::memory_order_relaxed );
+                if ( b.prev ) b.prev->next = b.next; else r.head = b.next;
+                if ( b.next ) b.next->prev = b.prev;
+            }
+        };
+
+        STX_FORCE_INLINE block& mine() noexcept
+        {
+            thread_local local l;
+            return l.b;
+        }
+    }
+
+    STX_FORCE_INLINE void add( counter c, u64 n = 1 ) noexcept
+    {
+        auto& slot = details::mine().v[scast<usize>( c )];
+        slot.store( slot.load( std::memory_order_relaxed ) + n, std::memory_order_relaxed );
+    }
+
+    // totals over every live and exited thread
+    [[nodiscard]] inline snapshot capture()
+    {
+        snapshot s;
+        auto* g = details::global();
+        if ( !g ) return s;
+
+        auto& r = *g;
+        std::lock_guard lock{ r.mtx };
+        for ( usize i = 0; i < counter_count; ++i )
+            s.values[i] = r.retired[i].load( std::memory_order_relaxed );
+        for ( auto* b = r.head; b; b = b->next )
+            for ( usize i = 0; i < counter_count; ++i )
+                s.values[i] += b->v[i].load( std::memory_order_relaxed );
+        return s;
+    }
+
+    // zero every counter; increments racing with the reset may survive
+    inline void reset()
+    {
+        auto* g = details::global();
+        if ( !g ) return;
+
+        auto& r = *g;
+        std::lock_guard lock{ r.mtx };
+        for ( auto& v : r.retired )
+            v.store( 0, std::memory_order_relaxed );
+        for ( auto* b = r.head; b; b = b->next )
+            for ( auto& v : b->v )
+                v.store( 0, std::memory_order_relaxed );
+    }
+
+    // adds the scope's duration to counter C (ns) and to time::probe<Probe>
+    template<counter C, ct::fixed_string Probe>
+    class [[nodiscard]] timer
+    {
+        u64 start_ = time::cycles();
+
+    public:
+        timer() noexcept = default;
+        timer( const timer& ) = delete;
+        auto operator=( const timer& ) -> timer& = delete;
+
+        ~timer()
+        {
+            auto const ticks = time::cycles() - start_;
+            add( C, scast<u64>( time::cycles_to<std::chrono::nanoseconds>( ticks ).count() ));
+            time::probe<Probe>::record( ticks );
+        }
+    };
+
+#else
+
+    STX_FORCE_INLINE void add( counter, u64 = 1 ) noexcept {}
+
+    [[nodiscard]] inline snapshot capture() noexcept { return {}; }
+
+    inline void reset() noexcept {}
+
+    template<counter C, ct::fixed_string Probe>
+    class [[nodiscard]] timer
+    {
+    public:
+        timer() noexcept = default;
+        timer( const timer& ) = delete;
+        auto operator=( const timer& ) -> timer& = delete;
+    };
+
+#endif
+
+    // --- hooks used by io / map_file ---------------------------------------------
+
+    STX_FORCE_INLINE void on_read( usize asked, usize got, bool failed ) noexcept
+    {
+        add( counter::reads );
+        add( counter::bytes_read, got );
+        if ( got < asked ) add( counter::short_reads );
+        if ( failed )      add( counter::read_failures );
+    }
+
+    STX_FORCE_INLINE void on_write( usize asked, usize put, bool failed ) noexcept
+    {
+        add( counter::writes );
+        add( counter::bytes_written, put );
+        if ( failed || put < asked ) add( counter::write_failures );
+    }
+}
+
+#undef STX_FORCE_INLINE
@@ -0,0 +1,632 @@
+#pragma once
+#include "./core.hpp"
+#include "./io.hpp"
+#include "./file.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <concepts>
+#include <condition_variable>
+#include <cstring>
+#include <expected>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+    #include <sys/stat.h>
+    #include <unistd.h>
+#else
+    #if !defined(NOMINMAX)
+        #define NOMINMAX
+    #endif
+    #if !defined(WIN32_LEAN_AND_MEAN)
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx
+{
+    namespace io
+    {
+        // --- sources -------------------------------------------------------------
+        // read() fills a prefix of `out` and returns its length; 0 means end of
+        // stream. Seekable sources can also reposition and report their size.
+
+        template<typename S>
+        concept byte_source = requires(S& s, std::span<std::byte> out) {
+            { s.read(out) } -> std::same_as<std::expected<usize, std::errc>>;
+        };
+
+        template<typename S>
+        concept seekable_source = byte_source<S> && requires(S& s, u64 pos) {
+            { s.seek(pos) } -> std::same_as<std::expected<void, std::errc>>;
+            { s.size()    } -> std::same_as<std::expected<usize, std::errc>>;
+        };
+
+        // io::file; positional on regular files, sequential on pipes / FIFOs
+        class file_source
+        {
+            const file* f_;
+            u64         pos_  = 0;
+            bool        disk_ = true;
+
+        public:
+            explicit file_source(const file& f, u64 pos = 0) noexcept
+                : f_(&f), pos_(pos)
+            {
+                #if defined(_WIN32)
+                    disk_ = GetFileType(f.native_handle()) == FILE_TYPE_DISK;
+                #else
+                    struct stat st;
+                    disk_ = ::fstat(f.native_handle(), &st) == 0 && S_ISREG(st.st_mode);
+                #endif
+            }
+
+            auto read(std::span<std::byte> out) noexcept -> std::expected<usize, std::errc>
+            {
+                if (!disk_) {
+                    #if defined(_WIN32)
+                        return f_->read_at(off_s{ scast<off_s::value_type>(pos_) }, out)
+                            .transform([&](usize n) { pos_ += n; return n; });
+                    #else
+                        for (;;) {
+                            auto const n = ::read(f_->native_handle(), out.data(), std::min(out.size(), details::max_xfer));
+                            if (n >= 0) { pos_ += scast<u64>(n); return scast<usize>(n); }
+                            if (errno != EINTR) return std::unexpected(static_cast<std::errc>(errno));
+                        }
+                    #endif
+                }
+                auto n = f_->read_at(off_s{ scast<off_s::value_type>(pos_) }, out);
+                if (n) pos_ += *n;
+                return n;
+            }
+
+            auto seek(u64 pos) noexcept -> std::expected<void, std::errc>
+            {
+                if (!disk_) return std::unexpected(std::errc::invalid_seek);
+                pos_ = pos;
+                return {};
+            }
+
+            auto size() const noexcept -> std::expected<usize, std::errc>
+            {
+                if (!disk_) return std::unexpected(std::errc::invalid_seek);
+                return f_->size();
+            }
+        };
+
+        // any std::istream; seek/size fail at runtime when the stream cannot seek
+        class istream_source
+        {
+            std::istream* is_;
+
+        public:
+            explicit istream_source(std::istream& is) noexcept : is_(&is) {}
+
+            auto read(std::span<std::byte> out) noexcept -> std::expected<usize, std::errc>
+            {
+                is_->read(rcast<char*>(out.data()), scast<std::streamsize>(out.size()));
+                auto const got = scast<usize>(is_->gcount());
+                if (is_->bad()) [[unlikely]]
+                    return std::unexpected(std::errc::io_error);
+                if (is_->eof()) is_->clear();
+                return got;
+            }
+
+            auto seek(u64 pos) noexcept -> std::expected<void, std::errc>
+            {
+                is_->clear();
+                is_->seekg(scast<std::streamoff>(pos), std::ios_base::beg);
+                if (is_->fail()) {
+                    is_->clear();
+                    return std::unexpected(std::errc::invalid_seek);
+                }
+                return {};
+            }
+
+            auto size() const noexcept -> std::expected<usize, std::errc>
+            {
+                auto const here = is_->tellg();
+                if (here < 0) {
+                    is_->clear();
+                    return std::unexpected(std::errc::invalid_seek);
+                }
+                is_->seekg(0, std::ios_base::end);
+                auto const end = is_->tellg();
+                is_->seekg(here, std::ios_base::beg);
+                if (end < 0 || is_->fail()) {
+                    is_->clear();
+                    return std::unexpected(std::errc::invalid_seek);
+                }
+                return scast<usize>(end);
+            }
+        };
+
+        // bytes already in memory (a resource, an overlay, a test vector)
+        class span_source
+        {
+            std::span<const std::byte> data_;
+            u64                        pos_ = 0;
+
+        public:
+            explicit span_source(std::span<const std::byte> data) noexcept : data_(data) {}
+
+            auto read(std::span<std::byte> out) noexcept -> std::expected<usize, std::errc>
+            {
+                auto const n = std::min<u64>(out.size(), data_.size() - pos_);
+                if (n != 0) std::memcpy(out.data(), data_.data() + pos_, scast<usize>(n));
+                pos_ += n;
+                return scast<usize>(n);
+            }
+
+            auto seek(u64 pos) noexcept -> std::expected<void, std::errc>
+            {
+                pos_ = std::min<u64>(pos, data_.size());
+                return {};
+            }
+
+            auto size() const noexcept -> std::expected<usize, std::errc> { return data_.size(); }
+        };
+
+        // --- readahead_source<Source> ----------------------------------------------
+        // Runs `Source` on a background thread, `depth` blocks of `block` bytes
+        // ahead of the reader, so producing the bytes (a disk read, a decode)
+        // overlaps with parsing them. Memory is depth * block. Not seekable:
+        // stream_cur serves forward seeks by reading and discarding. Errors reach
+        // the reader after the bytes produced before them.
+
+        template<byte_source Source>
+        class readahead_source
+        {
+            struct shared
+            {
+                Source                                    src;
+                usize                                     block;
+                std::vector<std::unique_ptr<std::byte[]>> bufs;
+                std::vector<usize>                        lens;
+                std::mutex                                mtx;
+                std::condition_variable                   cv;
+                u64                                       head = 0;  // blocks released by the reader
+                u64                                       tail = 0;  // blocks published by the producer
+                bool                                      done = false;
+                bool                                      stop = false;
+                std::errc                                 err{};
+
+                shared(Source s, usize blk, usize depth)
+                    : src(std::move(s)), block(blk), lens(depth)
+                {
+                    bufs.reserve(depth);
+                    for (usize i = 0; i < depth; ++i)
+                        bufs.push_back(std::make_unique_for_overwrite<std::byte[]>(blk));
+                }
+            };
+
+            std::unique_ptr<shared> sh_;
+            std::thread             worker_;
+            const std::byte*        cur_  = nullptr;  // block being read, owned until released
+            usize                   pos_  = 0;
+            usize                   len_  = 0;
+
+            static void produce(shared& s) noexcept
+            {
+                auto const depth = s.bufs.size();
+                for (;;) {
+                    std::byte* buf = nullptr;
+                    {
+                        std::unique_lock lk{ s.mtx };
+                        s.cv.wait(lk, [&] { return s.stop || s.tail - s.head < depth; });
+                        if (s.stop) return;
+                        buf = s.bufs[scast<usize>(s.tail % depth)].get();
+                    }
+
+                    // whole blocks, so the reader wakes once per block
+                    usize     got = 0;
+                    bool      eof = false;
+                    std::errc err{};
+                    while (got < s.block) {
+                        auto n = s.src.read(std::span<std::byte>{ buf + got, s.block - got });
+                        if (!n) [[unlikely]] { err = n.error(); break; }
+                        if (*n == 0) { eof = true; break; }
+                        got += *n;
+                    }
+
+                    std::scoped_lock lk{ s.mtx };
+                    if (got != 0) s.lens[scast<usize>(s.tail++ % depth)] = got;
+                    if (err != std::errc{}) s.err = err;
+                    if (eof || err != std::errc{}) s.done = true;
+                    s.cv.notify_all();
+                    if (s.done) return;
+                }
+            }
+
+            void shutdown() noexcept
+            {
+                if (!worker_.joinable()) return;
+                {
+                    std::scoped_lock lk{ sh_->mtx };
+                    sh_->stop = true;
+                }
+                sh_->cv.notify_all();
+                worker_.join();
+            }
+
+        public:
+            static constexpr usize default_block = usize{ 1 } << 20;
+
+            explicit readahead_source(Source src, usize block = default_block, usize depth = 2)
+                : sh_(std::make_unique<shared>(std::move(src), std::max<usize>(block, 64), std::max<usize>(depth, 1)))
+                , worker_([s = sh_.get()] { produce(*s); })
+            {}
+
+            readahead_source(readahead_source&& other) noexcept
+                : sh_(std::move(other.sh_))
+                , worker_(std::move(other.worker_))
+                , cur_(std::exchange(other.cur_, nullptr))
+                , pos_(std::exchange(other.pos_, 0))
+                , len_(std::exchange(other.len_, 0))
+            {}
+
+            readahead_source& operator=(readahead_source&& other) noexcept
+            {
+                if (this != &other) {
+                    shutdown();
+                    sh_     = std::move(other.sh_);
+                    worker_ = std::move(other.worker_);
+                    cur_    = std::exchange(other.cur_, nullptr);
+                    pos_    = std::exchange(other.pos_, 0);
+                    len_    = std::exchange(other.len_, 0);
+                }
+                return *this;
+            }
+
+            ~readahead_source() { shutdown(); }
+
+            auto read(std::span<std::byte> out) noexcept -> std::expected<usize, std::errc>
+            {
+                if (!sh_ || out.empty()) return usize{ 0 };
+                for (;;) {
+                    if (pos_ < len_) {
+                        auto const n = std::min(out.size(), len_ - pos_);
+                        std::memcpy(out.data(), cur_ + pos_, n);
+                        pos_ += n;
+                        return n;
+                    }
+
+                    auto& s = *sh_;
+                    std::unique_lock lk{ s.mtx };
+                    if (cur_) {
+                        ++s.head;
+                        cur_ = nullptr;
+                        pos_ = len_ = 0;
+                        s.cv.notify_all();
+                    }
+                    s.cv.wait(lk, [&] { return s.tail > s.head || s.done; });
+                    if (s.tail == s.head) {
+                        if (s.err != std::errc{}) return std::unexpected(s.err);
+                        return usize{ 0 };
+                    }
+                    auto const slot = scast<usize>(s.head % s.bufs.size());
+                    cur_ = s.bufs[slot].get();
+                    len_ = s.lens[slot];
+                }
+            }
+        };
+    }
+
+    // --- stream_cur<Source> (memcur surface over a byte stream) -----------------
+    // Bounded sliding window over `Source`. Refills read as much as the window
+    // holds (read-ahead), so fields are served from memory and the source sees
+    // only large reads. Memory use is the window size, whatever the stream size.
+    //
+    // Errors are sticky: a failed pop returns a value-initialized T and every
+    // later pop is a no-op until clear(). Check status() once after a parse.
+    // Views and string_views point into the window and stay valid only until the
+    // next call that may refill it.
+
+    template<io::byte_source Source>
+    class stream_cur
+    {
+        Source                       src_;
+        std::unique_ptr<std::byte[]> buf_;
+        usize                        cap_  = 0;
+        usize                        beg_  = 0;     // cursor index into buf_
+        usize                        end_  = 0;     // valid bytes in buf_
+        u64                          base_ = 0;     // stream offset of buf_[0]
+        std::optional<usize>         size_;
+        std::errc                    err_{};
+        bool                         eof_  = false;
+
+        STX_FORCE_INLINE usize avail() const noexcept { return end_ - beg_; }
+
+        void fail(std::errc e) noexcept
+        {
+            if (err_ == std::errc{}) err_ = e;
+        }
+
+        // make at least `need` (<= cap_) bytes available unless the stream ends first
+        void fill(usize need) noexcept
+        {
+            if (avail() >= need || eof_ || err_ != std::errc{})
+                return;
+
+            if (beg_ != 0) {
+                std::memmove(buf_.get(), buf_.get() + beg_, avail());
+                base_ += beg_;
+                end_  -= beg_;
+                beg_   = 0;
+            }
+
+            while (end_ < need) {
+                auto n = src_.read(std::span<std::byte>{ buf_.get() + end_, cap_ - end_ });
+                if (!n) [[unlikely]] { fail(n.error()); return; }
+                if (*n == 0) { eof_ = true; return; }
+                end_ += *n;
+            }
+        }
+
+        // drop the window and continue reading at stream offset `pos`
+        void restart(u64 pos) noexcept
+        {
+            base_ = pos;
+            beg_ = end_ = 0;
+            eof_ = false;
+        }
+
+        void take(void* dst, usize n) noexcept
+        {
+            auto* out = static_cast<std::byte*>(dst);
+
+            // window first, then large tails straight from the source
+            auto const head = std::min(n, avail());
+            if (head != 0) std::memcpy(out, buf_.get() + beg_, head);
+            beg_ += head;
+            out  += head;
+            n    -= head;
+
+            if (n >= cap_ / 2) {
+                restart(base_ + end_);
+                while (n != 0) {
+                    auto got = src_.read(std::span<std::byte>{ out, n });
+                    if (!got) [[unlikely]] { fail(got.error()); return; }
+                    if (*got == 0) { eof_ = true; fail(std::errc::argument_out_of_domain); return; }
+                    base_ += *got;
+                    out   += *got;
+                    n     -= *got;
+                }
+                return;
+            }
+
+            if (n != 0) {
+                fill(n);
+                if (avail() < n) [[unlikely]] { fail(std::errc::argument_out_of_domain); return; }
+                std::memcpy(out, buf_.get() + beg_, n);
+                beg_ += n;
+            }
+        }
+
+        void skip(u64 n) noexcept
+        {
+            while (n != 0 && err_ == std::errc{}) {
+                if (avail() == 0) {
+                    fill(1);
+                    if (avail() == 0) { fail(std::errc::argument_out_of_domain); return; }
+                }
+                auto const k = scast<usize>(std::min<u64>(n, avail()));
+                beg_ += k;
+                n    -= k;
+            }
+        }
+
+    public:
+        static constexpr usize default_window = usize{ 256 } << 10;
+
+        explicit stream_cur(Source src, usize window = default_window)
+            : src_(std::move(src))
+            , buf_(std::make_unique_for_overwrite<std::byte[]>(std::max<usize>(window, 64)))
+            , cap_(std::max<usize>(window, 64))
+        {
+            if constexpr (io::seekable_source<Source>) {
+                if (auto sz = src_.size()) size_ = *sz;
+            }
+        }
+
+        stream_cur(stream_cur&&) noexcept = default;
+        stream_cur& operator=(stream_cur&&) noexcept = default;
+
+        // --- state ---------------------------------------------------------
+
+        explicit operator bool() const noexcept { return err_ == std::errc{}; }
+
+        auto status() const noexcept -> std::expected<void, std::errc>
+        {
+            if (err_ != std::errc{}) return std::unexpected(err_);
+            return {};
+        }
+
+        void clear() noexcept { err_ = std::errc{}; }
+
+        // total stream size; known for seekable sources only
+        bool  sized() const noexcept { return size_.has_value(); }
+        usize size() const noexcept { return size_.value_or(0); }
+        usize window() const noexcept { return cap_; }
+
+        off_s tell() const noexcept { return off_s{ scast<off_s::value_type>(base_ + beg_) }; }
+
+        // exact when sized(); otherwise a lower bound (buffered bytes, 0 only at end)
+        off_s remaining() noexcept
+        {
+            if (size_) {
+                auto const pos = base_ + beg_;
+                return off_s{ scast<off_s::value_type>(pos < *size_ ? *size_ - pos : 0) };
+            }
+            fill(1);
+            return off_s{ scast<off_s::value_type>(avail()) };
+        }
+
+        // Inside the window: pointer move. Otherwise seekable sources reposition;
+        // forward seeks on pipes read and discard. Backward seeks outside the
+        // window on a non-seekable source fail with errc::invalid_seek.
+        void seek(off_s off, origin dir = origin::begin) noexcept
+        {
+            off_s::value_type target = 0;
+            switch (dir) {
+                case origin::begin:   target = off.get(); break;
+                case origin::current: target = tell().get() + off.get(); break;
+                case origin::end:
+                    if (!size_) { fail(std::errc::invalid_seek); return; }
+                    target = scast<off_s::value_type>(*size_) + off.get();
+                    break;
+            }
+            if (target < 0) target = 0;
+            if (size_ && target > scast<off_s::value_type>(*size_))
+                target = scast<off_s::value_type>(*size_);
+
+            auto const pos = scast<u64>(target);
+            if (pos >= base_ && pos <= base_ + end_) {
+                beg_ = scast<usize>(pos - base_);
+                return;
+            }
+
+            if constexpr (io::seekable_source<Source>) {
+                if (src_.seek(pos)) {
+                    restart(pos);
+                    return;
+                }
+            }
+
+            if (pos > base_ + end_) {
+                beg_ = end_;
+                skip(pos - (base_ + end_));
+                return;
+            }
+            fail(std::errc::invalid_seek);
+        }
+
+        void advance(const off_s offset) noexcept { seek(offset, origin::current); }
+
+        // --- pop (read + advance) ------------------------------------------
+
+        template<binary_readable T>
+        T pop() noexcept
+        {
+            T value{};
+            if (avail() >= sizeof(T)) [[likely]] {
+                std::memcpy(&value, buf_.get() + beg_, sizeof(T));
+                beg_ += sizeof(T);
+                return value;
+            }
+            if (err_ == std::errc{})
+                take(&value, sizeof(T));
+            return value;
+        }
+
+        template<bounded_array U>
+        details::bounded_array_t<U> pop() noexcept
+        {
+            details::bounded_array_t<U> value{};
+            if (err_ == std::errc{})
+                take(&value, sizeof(value));
+            return value;
+        }
+
+        // --- zero-copy view (no advance, valid until next refill) ----------
+
+        template<binary_readable T>
+        std::span<const T> as_view(usize count) noexcept
+        {
+            auto const bytes = count * sizeof(T);
+            if (bytes > cap_) { fail(std::errc::value_too_large); return {}; }
+            fill(bytes);
+            if (avail() < bytes) { fail(std::errc::argument_out_of_domain); return {}; }
+            return std::span<const T>(rcast<const T*>(buf_.get() + beg_), count);
+        }
+
+        // --- read into (no advance) / pop into (advance) -------------------
+
+        template<writable_buffer R>
+        void read_into(R&& buf) noexcept
+        {
+            auto const bytes = std::size(buf) * sizeof(*std::data(buf));
+            if (bytes > cap_) { fail(std::errc::value_too_large); return; }
+            fill(bytes);
+            if (avail() < bytes) { fail(std::errc::argument_out_of_domain); return; }
+            std::memcpy(rcast<std::byte*>(std::data(buf)), buf_.get() + beg_, bytes);
+        }
+
+        template<writable_buffer R>
+        auto& pop_into(R&& buf) noexcept
+        {
+            auto const bytes = std::size(buf) * sizeof(*std::data(buf));
+            if (err_ == std::errc{})
+                take(rcast<std::byte*>(std::data(buf)), bytes);
+            return *this;
+        }
+
+        template<endian::order Order, byte_swappable T>
+        auto& pop_into(std::span<T> out) noexcept
+        {
+            if (err_ == std::errc{} && !out.empty()) {
+                take(out.data(), out.size_bytes());
+                endian::to_native<Order>(out);
+            }
+            return *this;
+        }
+
+        // NUL-terminated string, at most `max` bytes (capped at the window size)
+        std::string_view read_strvw() noexcept { return read_strvw(cap_); }
+
+        std::string_view read_strvw(usize max) noexcept
+        {
+            max = std::min(max, cap_);
+            usize scanned = 0;
+            for (;;) {
+                auto const lim  = std::min(avail(), max);
+                auto const* at  = buf_.get() + beg_;
+                auto const* nul = static_cast<const std::byte*>(std::memchr(at + scanned, 0, lim - scanned));
+                if (nul) {
+                    auto const len = scast<usize>(nul - at);
+                    beg_ += len + 1;
+                    return { rcast<const char*>(at), len };
+                }
+                scanned = lim;
+                if (lim == max || (fill(lim + 1), avail() <= lim)) {
+                    at = buf_.get() + beg_;
+                    beg_ += lim;
+                    return { rcast<const char*>(at), lim };
+                }
+            }
+        }
+
+        // --- raw window --------------------------------------------------
+
+        // buffered bytes from the cursor; refills when empty
+        [[nodiscard]] std::span<const std::byte> bytes() noexcept
+        {
+            fill(1);
+            return { buf_.get() + beg_, avail() };
+        }
+    };
+
+    template<io::byte_source S>
+    stream_cur(S) -> stream_cur<S>;
+
+    template<io::byte_source S>
+    stream_cur(S, usize) -> stream_cur<S>;
+}
+
+#undef STX_FORCE_INLINE
@@ -0,0 +1,182 @@
+#pragma once
+#include "core.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx::strtab
+{
+    // --- options -----------------------------------------------------------------
+
+    enum class charset : u8
+    {
+        any      ,   // every non-NUL byte belongs to a string (string tables)
+        printable,   // 0x20..0x7E and '\t'; anything else ends the run (strings(1))
+    };
+
+    struct options
+    {
+        usize   min_len     = 1;               // shorter strings are dropped (0 keeps empty ones)
+        charset set         = charset::any;
+        bool    require_nul = true;            // false: any terminator (or the region end) counts
+
+        // strings(1) defaults
+        [[nodiscard]] static constexpr options strings( usize min_len = 4 ) noexcept
+        {
+            return { .min_len = min_len, .set = charset::printable, .require_nul = false };
+        }
+    };
+
+    // offset / length into the indexed region (regions up to 4 GiB)
+    struct entry
+    {
+        u32 offset;
+        u32 length;
+
+        [[nodiscard]] std::string_view view( std::span<const std::byte> region ) const noexcept
+        {
+            return { rcast<const char*>( region.data() ) + offset, length };
+        }
+
+        friend bool operator==( const entry&, const entry& ) = default;
+    };
+
+    namespace details
+    {
+        // bit i set when byte i ends a run
+        template<charset Set>
+        STX_FORCE_INLINE simd::mask_t stop_mask( const u8* p ) noexcept
+        {
+            if constexpr ( Set == charset::any )
+                return simd::eq_mask( p, 0 );
+            else
+                return ~( simd::range_mask( p, 0x20, 0x7E ) | simd::eq_mask( p, '\t' )) & simd::all_lanes;
+        }
+
+        // fn(offset, length) for every accepted run
+        template<charset Set, typename Fn>
+        void walk( const u8* data, usize n, const options& opt, Fn&& fn )
+        {
+            usize start = 0;
+
+            auto stop = [&]( usize at ) {
+                auto const len = at - start;
+                if ( len >= opt.min_len && ( !opt.require_nul || data[at] == 0 ))
+                    fn( start, len );
+                start = at + 1;
+            };
+
+            usize i = 0;
+            for ( ; i + simd::lanes <= n; i += simd::lanes ) {
+                for ( auto m = stop_mask<Set>( data + i ); m != 0; m &= m - 1 )
+                    stop( i + simd::first_lane( m ));
+            }
+
+            if ( i < n ) {
+                // tail: pad with non-terminators and mask off the padding
+                alignas( 32 ) u8 block[simd::lanes];
+                std::memset( block, 'a', sizeof( block ));
+                std::memcpy( block, data + i, n - i );
+                auto m = stop_mask<Set>( block ) & (( simd::mask_t{ 1 } << ( n - i )) - 1 );
+                for ( ; m != 0; m &= m - 1 )
+                    stop( i + simd::first_lane( m ));
+            }
+
+            // unterminated run at the end of the region
+            if ( !opt.require_nul && n > start && n - start >= opt.min_len )
+                fn( start, n - start );
+        }
+
+        // initial capacity for index / views: one string per 16 bytes (or per
+        // min_len + 1, whichever is fewer); push_back grows past it
+        inline usize reserve_hint( usize bytes, const options& opt ) noexcept
+        {
+            return bytes / std::max<usize>( 16, opt.min_len + 1 );
+        }
+
+        template<typename Fn>
+        void dispatch( std::span<const std::byte> region, const options& opt, Fn&& fn )
+        {
+            auto const* p = rcast<const u8*>( region.data() );
+            if ( opt.set == charset::any )
+                walk<charset::any>( p, region.size(), opt, fn );
+            else
+                walk<charset::printable>( p, region.size(), opt, fn );
+        }
+    }
+
+    // --- API ---------------------------------------------------------------------
+    // One pass over the region, `simd::lanes` bytes at a time; only terminator
+    // positions are visited, so long strings cost a compare per block.
+
+    // fn(off_s offset, std::string_view str) for every string in `region`
+    template<typename Fn>
+    void for_each( std::span<const std::byte> region, Fn&& fn, const options& opt = {} )
+    {
+        auto const* base = rcast<const char*>( region.data() );
+        details::dispatch( region, opt, [&]( usize off, usize len ) {
+            fn( off_s{ scast<off_s::value_type>( off ) }, std::string_view{ base + off, len } );
+        });
+    }
+
+    // number of strings `index` / `views` would return
+    [[nodiscard]] inline usize count( std::span<const std::byte> region, const options& opt = {} )
+    {
+        usize n = 0;
+        details::dispatch( region, opt, [&]( usize, usize ) { ++n; } );
+        return n;
+    }
+
+    // compact (offset, length) index; value_too_large past 4 GiB
+    [[nodiscard]] inline auto index( std::span<const std::byte> region, const options& opt = {} )
+        -> std::expected<std::vector<entry>, std::errc>
+    {
+        if ( region.size() > std::numeric_limits<u32>::max() ) [[unlikely]]
+            return std::unexpected( std::errc::value_too_large );
+
+        std::vector<entry> out;
+        out.reserve( details::reserve_hint( region.size(), opt ));
+        details::dispatch( region, opt, [&]( usize off, usize len ) {
+            out.push_back({ scast<u32>( off ), scast<u32>( len ) });
+        });
+        return out;
+    }
+
+    [[nodiscard]] inline std::vector<std::string_view> views( std::span<const std::byte> region, const options& opt = {} )
+    {
+        std::vector<std::string_view> out;
+        out.reserve( details::reserve_hint( region.size(), opt ));
+        auto const* base = rcast<const char*>( region.data() );
+        details::dispatch( region, opt, [&]( usize off, usize len ) {
+            out.emplace_back( base + off, len );
+        });
+        return out;
+    }
+
+    // views() over the next `size` bytes at a byte_cursor (clamped to what is
+    // left); advances past them
+    template<byte_cursor C>
+    [[nodiscard]] std::vector<std::string_view> read_strings( C& cur, usize size, const options& opt = {} )
+    {
+        auto const all    = std::as_bytes( cur.bytes() );
+        auto const region = all.first( std::min( size, all.size() ));
+        auto out = views( region, opt );
+        cur.advance( off_s{ scast<off_s::value_type>( region.size() ) } );
+        return out;
+    }
+}
+
+#undef STX_FORCE_INLINE
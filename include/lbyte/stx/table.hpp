@@ -0,0 +1,251 @@
+#pragma once
+#include "core.hpp"
+#include "mem.hpp"
+#include "endian.hpp"
+
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
+
+namespace lbyte::stx
+{
+    // --- element decoding --------------------------------------------------------
+    // table_view<E> decodes each entry on access:
+    //   binary_readable T          -> T                  (unaligned memcpy)
+    //   endian::endian_value<T, O> -> T                  (load + swap)
+    //   layout::record<T, ...>     -> T                  (R::decode)
+
+    namespace details
+    {
+        template<typename R>
+        concept record_layout = requires( const std::byte* p ) {
+            typename R::value_type;
+            { R::size } -> std::convertible_to<usize>;
+            { R::decode( p ) } -> std::same_as<typename R::value_type>;
+        };
+
+        template<typename E>
+        struct table_elem
+        {
+            using value_type = E;
+            static constexpr usize size = sizeof( E );
+
+            STX_FORCE_INLINE static E load( const std::byte* p ) noexcept
+            {
+                E v;
+                std::memcpy( &v, p, sizeof( E ));
+                return v;
+            }
+        };
+
+        template<typename E> requires endian::is_endian_value_v<E>
+        struct table_elem<E>
+        {
+            using value_type = std::remove_cvref_t<decltype( std::declval<E>().get() )>;
+            static constexpr usize size = sizeof( E );
+
+            STX_FORCE_INLINE static value_type load( const std::byte* p ) noexcept
+            {
+                E v;
+                std::memcpy( &v, p, sizeof( E ));
+                return v.get();
+            }
+        };
+
+        template<record_layout R>
+        struct table_elem<R>
+        {
+            using value_type = typename R::value_type;
+            static constexpr usize size = R::size;
+
+            STX_FORCE_INLINE static value_type load( const std::byte* p ) noexcept { return R::decode( p ); }
+        };
+    }
+
+    template<typename E>
+    concept table_element = details::record_layout<E> || binary_readable<E>;
+
+    // --- record_view (one entry, decoded on demand) ------------------------------
+
+    template<table_element E>
+    class record_view
+    {
+        using traits = details::table_elem<E>;
+
+        const std::byte* p_ = nullptr;
+
+    public:
+        using value_type = typename traits::value_type;
+
+        constexpr record_view() noexcept = default;
+        constexpr explicit record_view( const std::byte* p ) noexcept : p_( p ) {}
+
+        [[nodiscard]] STX_FORCE_INLINE value_type get() const noexcept { return traits::load( p_ ); }
+        [[nodiscard]] STX_FORCE_INLINE operator value_type() const noexcept { return get(); }
+
+        // one member of a layout record, without decoding the rest
+        template<auto Member> requires details::record_layout<E> [[nodiscard]] STX_FORCE_INLINE
+        auto get() const noexcept
+        {
+            using item = typename E::template item<E::template index_of<Member>>;
+            value_type tmp;
+            item::load( tmp, p_ + E::offsets[E::template index_of<Member>] );
+            return item::ref( tmp );
+        }
+
+        [[nodiscard]] constexpr uptr addr() const noexcept { return rcast<uptr>( p_ ); }
+        [[nodiscard]] constexpr const std::byte* data() const noexcept { return p_; }
+    };
+
+    // --- table_view (lazy random-access range over a record array) ----------------
+    // Non-owning; nothing is copied up front. The stride may exceed the element
+    // size (padded entries, versioned headers whose tail is ignored).
+
+    template<table_element E>
+    class table_view : public std::ranges::view_interface<table_view<E>>
+    {
+        using traits = details::table_elem<E>;
+
+        const std::byte* base_   = nullptr;
+        usize            count_  = 0;
+        usize            stride_ = traits::size;
+
+    public:
+        using value_type = typename traits::value_type;
+
+        static constexpr usize element_size = traits::size;
+
+        class iterator
+        {
+            const std::byte* p_      = nullptr;
+            usize            stride_ = traits::size;
+
+        public:
+            // operator* yields a prvalue, so only a Cpp17 input iterator to
+            // legacy algorithms; C++20 ranges see the full random access
+            using iterator_concept  = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = typename traits::value_type;
+            using difference_type   = std::ptrdiff_t;
+            using reference         = value_type;
+
+            constexpr iterator() noexcept = default;
+            constexpr iterator( const std::byte* p, usize stride ) noexcept : p_( p ), stride_( stride ) {}
+
+            [[nodiscard]] STX_FORCE_INLINE value_type operator*() const noexcept { return traits::load( p_ ); }
+            [[nodiscard]] STX_FORCE_INLINE value_type operator[]( difference_type n ) const noexcept
+            {
+                return traits::load( p_ + n * scast<difference_type>( stride_ ));
+            }
+
+            [[nodiscard]] constexpr record_view<E> record() const noexcept { return record_view<E>{ p_ }; }
+
+            constexpr iterator& operator++() noexcept { p_ += stride_; return *this; }
+            constexpr iterator& operator--() noexcept { p_ -= stride_; return *this; }
+            constexpr iterator  operator++( int ) noexcept { auto t = *this; ++*this; return t; }
+            constexpr iterator  operator--( int ) noexcept { auto t = *this; --*this; return t; }
+
+            constexpr iterator& operator+=( difference_type n ) noexcept { p_ += n * scast<difference_type>( stride_ ); return *this; }
+            constexpr iterator& operator-=( difference_type n ) noexcept { p_ -= n * scast<difference_type>( stride_ ); return *this; }
+
+            [[nodiscard]] friend constexpr iterator operator+( iterator i, difference_type n ) noexcept { return i += n; }
+            [[nodiscard]] friend constexpr iterator operator+( difference_type n, iterator i ) noexcept { return i += n; }
+            [[nodiscard]] friend constexpr iterator operator-( iterator i, difference_type n ) noexcept { return i -= n; }
+
+            [[nodiscard]] friend constexpr difference_type operator-( const iterator& a, const iterator& b ) noexcept
+            {
+                return ( a.p_ - b.p_ ) / scast<difference_type>( a.stride_ );
+            }
+
+            [[nodiscard]] friend constexpr bool operator==( const iterator& a, const iterator& b ) noexcept { return a.p_ == b.p_; }
+            [[nodiscard]] friend constexpr auto operator<=>( const iterator& a, const iterator& b ) noexcept { return a.p_ <=> b.p_; }
+        };
+
+        constexpr table_view() noexcept = default;
+
+        // `count` entries starting at `base`, `stride` bytes apart (non-zero)
+        template<address_like Addr>
+        table_view( Addr base, usize count, usize stride = traits::size ) noexcept
+            : base_( rcast<const std::byte*>( normalize_addr( base )))
+            , count_( count )
+            , stride_( stride )
+        {
+            assert( stride != 0 && "table_view: stride must be non-zero" );
+        }
+
+        // every whole entry in `bytes`; stride 0 gives an empty view
+        explicit table_view( std::span<const std::byte> bytes, usize stride = traits::size ) noexcept
+            : base_( bytes.data() )
+            , count_( stride ? ( bytes.size() >= traits::size ? ( bytes.size() - traits::size ) / stride + 1 : 0 ) : 0 )
+            , stride_( stride ? stride : traits::size )   // keeps end() - begin() defined
+        {}
+
+        // `count` entries at the cursor of a memcur / map_file (no advance).
+        // Empty when they do not fit in the cursor's remaining bytes or stride
+        // is 0, so a count read from the file cannot run past the mapping.
+        template<typename Cur>
+            requires requires( Cur& c, usize n ) { c.template as_view<std::byte>( n ); c.remaining(); }
+        [[nodiscard]] static table_view from( Cur& cur, usize count, usize stride = traits::size ) noexcept
+        {
+            if ( count == 0 || stride == 0 )
+                return table_view{};
+
+            auto const rem  = cur.remaining().get();
+            auto const left = rem > 0 ? scast<usize>( rem ) : usize{ 0 };
+            // (count - 1) * stride + size <= left, without the multiply
+            if ( left < traits::size || count - 1 > ( left - traits::size ) / stride )
+                return table_view{};
+
+            auto const bytes = ( count - 1 ) * stride + traits::size;
+            return table_view{ cur.template as_view<std::byte>( bytes ).data(), count, stride };
+        }
+
+        [[nodiscard]] constexpr iterator begin() const noexcept { return iterator{ base_, stride_ }; }
+        [[nodiscard]] constexpr iterator end()   const noexcept { return iterator{ base_ + count_ * stride_, stride_ }; }
+
+        [[nodiscard]] constexpr usize size()   const noexcept { return count_; }
+        [[nodiscard]] constexpr usize stride() const noexcept { return stride_; }
+
+        // bytes spanned, from the first entry to the end of the last
+        [[nodiscard]] constexpr usize size_bytes() const noexcept
+        {
+            return count_ == 0 ? 0 : ( count_ - 1 ) * stride_ + traits::size;
+        }
+
+        [[nodiscard]] STX_FORCE_INLINE value_type operator[]( usize i ) const noexcept
+        {
+            return traits::load( base_ + i * stride_ );
+        }
+
+        [[nodiscard]] constexpr record_view<E> record( usize i ) const noexcept
+        {
+            return record_view<E>{ base_ + i * stride_ };
+        }
+
+        // entries [first, first + n)
+        [[nodiscard]] constexpr table_view subview( usize first, usize n ) const noexcept
+        {
+            table_view v;
+            v.base_   = base_ + first * stride_;
+            v.count_  = n;
+            v.stride_ = stride_;
+            return v;
+        }
+    };
+}
+
+template<typename E>
+inline constexpr bool std::ranges::enable_borrowed_range<lbyte::stx::table_view<E>> = true;
+
+#undef STX_FORCE_INLINE
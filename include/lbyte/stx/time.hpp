@@ -1,7 +1,22 @@
 #pragma once
 
 #include "../stx/core.hpp"
+#include "../stx/simd.hpp"
+
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <span>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STX_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+    #define STX_FORCE_INLINE inline
+#endif
 
 namespace lbyte::stx::time
 {
@@ -69,6 +84,105 @@ namespace lbyte::stx::time
         }
     };
 
+    // CYCLE COUNTER -------------------------------------------------------------
+    // rdtsc (x86) / cntvct_el0 (aarch64): one register read, against ~20 ns for
+    // steady_clock::now(). Assumes an invariant TSC (constant rate, synchronized
+    // across cores), true of x86 parts since ~2008. Elsewhere the counter is
+    // steady_clock in nanoseconds. Not serializing: it brackets loops, not
+    // single instructions.
+    [[nodiscard]] STX_FORCE_INLINE u64 cycles() noexcept
+    {
+    #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+    #elif defined(__x86_64__) || defined(__i386__)
+        return __builtin_ia32_rdtsc();
+    #elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+        u64 v;
+        asm volatile( "mrs %0, cntvct_el0" : "=r"( v ));
+        return v;
+    #else
+        return static_cast<u64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>( steady_clock::now().time_since_epoch() ).count()
+        );
+    #endif
+    }
+
+    namespace details
+    {
+        inline double calibrate_cycles() noexcept
+        {
+        #if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+            u64 freq;
+            asm volatile( "mrs %0, cntfrq_el0" : "=r"( freq ));
+            if ( freq != 0 )
+                return 1e9 / static_cast<double>( freq );
+        #elif !defined(__x86_64__) && !defined(__i386__) && !defined(_M_X64) && !defined(_M_IX86)
+            return 1.0;
+        #endif
+            // spin ~5 ms against steady_clock; the error is a few ppm
+            auto const t0 = steady_clock::now();
+            auto const c0 = cycles();
+            auto t1 = t0;
+            while ( t1 - t0 < std::chrono::milliseconds{ 5 } )
+                t1 = steady_clock::now();
+            auto const c1 = cycles();
+
+            auto const ns = std::chrono::duration<double, std::nano>( t1 - t0 ).count();
+            return c1 > c0 ? ns / static_cast<double>( c1 - c0 ) : 1.0;
+        }
+    }
+
+    // nanoseconds per cycles() tick, measured once on first use
+    [[nodiscard]] inline double ns_per_cycle() noexcept
+    {
+        static double const rate = details::calibrate_cycles();
+        return rate;
+    }
+
+    template<class Duration = std::chrono::nanoseconds> [[nodiscard]]
+    inline Duration cycles_to( u64 ticks ) noexcept
+    {
+        return std::chrono::duration_cast<Duration>(
+            std::chrono::duration<double, std::nano>{ static_cast<double>( ticks ) * ns_per_cycle() }
+        );
+    }
+
+    // --- cycle_stopwatch -------------------------------------------------------
+    // stopwatch over cycles(); ticks() / lap_ticks() skip the conversion.
+    struct cycle_stopwatch
+    {
+        u64 start_{ cycles() };
+
+        [[nodiscard]] STX_FORCE_INLINE u64 ticks() const noexcept
+        {
+            return cycles() - start_;
+        }
+
+        STX_FORCE_INLINE u64 lap_ticks() noexcept
+        {
+            auto prev = start_;
+            start_ = cycles();
+            return start_ - prev;
+        }
+
+        template<class Duration = std::chrono::nanoseconds>
+        [[nodiscard]] Duration elapsed() const noexcept
+        {
+            return cycles_to<Duration>( ticks() );
+        }
+
+        template<class Duration = std::chrono::nanoseconds>
+        [[nodiscard]] Duration lap() noexcept
+        {
+            return cycles_to<Duration>( lap_ticks() );
+        }
+
+        void reset() noexcept
+        {
+            start_ = cycles();
+        }
+    };
+
     // PORTABLE BINARY FORMAT CONVERTERS ----------------------------------------
 
     // --- FILETIME (Windows) ----------------------------------------------------
@@ -154,4 +268,142 @@ namespace lbyte::stx::time
         auto sec = std::chrono::duration_cast<std::chrono::seconds>(dur).count();
         return static_cast<u32>(static_cast<u64>(sec + static_cast<i64>(epoch_ntp)));
     }
+
+    // BATCH CONVERTERS ----------------------------------------------------------
+    // Span in, span out: Unix seconds (u64) into a preallocated buffer, the
+    // scalar converters' value for every element (0 where they return the
+    // epoch). Each converts min(in.size(), out.size()) elements and returns
+    // the count.
+
+    namespace details
+    {
+        // DOS (year - 1980) << 4 | month -> days from 1970-01-01 to the first
+        // of that month; 0 for months 0 and 13..15 (no valid month starts on
+        // the epoch). 8 KiB, built at compile time.
+        inline constexpr auto dos_months = [] {
+            using namespace std::chrono;
+            std::array<u32, 2048> t{};
+            for (int y = 0; y < 128; ++y)
+                for (unsigned m = 1; m <= 12; ++m)
+                    t[scast<usize>(y << 4) | m] = static_cast<u32>(
+                        sys_days{ year{ 1980 + y } / month{ m } / day{ 1 } }.time_since_epoch().count());
+            return t;
+        }();
+
+        // same result as to_unix(from_dos(dos)), without the civil calendar:
+        // a day past the end of the month rolls into the next one, like
+        // sys_days does for the scalar form
+        [[nodiscard]] STX_FORCE_INLINE u64 dos_unix(u32 dos) noexcept
+        {
+            u32 const first = dos_months[dos >> 21];
+            u32 const d     = (dos >> 16) & 0x1F;
+            u32 const hh    = (dos >> 11) & 0x1F;
+            u32 const mm    = (dos >> 5)  & 0x3F;
+            u32 const s2    =  dos        & 0x1F;
+
+            bool const ok = first != 0 && d != 0 && hh < 24 && mm < 60 && s2 < 30;
+            u64  const t  = static_cast<u64>(first + d - 1) * 86'400 + hh * 3'600 + mm * 60 + s2 * 2;
+            return ok ? t : 0;
+        }
+
+    #if LBYTE_STX_SIMD_AVX2
+        // eight per step: month starts by gather, fields and checks in u32
+        // lanes, day seconds widened to u64 by mul_epu32
+        inline usize dos_unix_avx2(const u32* in, u64* out, usize n) noexcept
+        {
+            auto const m5  = _mm256_set1_epi32(0x1F);
+            auto const m6  = _mm256_set1_epi32(0x3F);
+            auto const spd = _mm256_set1_epi64x(86'400);
+            auto const* tab = rcast<const int*>(dos_months.data());
+
+            usize i = 0;
+            for (; i + 8 <= n; i += 8) {
+                auto const v  = _mm256_loadu_si256(rcast<const __m256i*>(in + i));
+                auto const fm = _mm256_i32gather_epi32(tab, _mm256_srli_epi32(v, 21), 4);
+                auto const d  = _mm256_and_si256(_mm256_srli_epi32(v, 16), m5);
+                auto const hh = _mm256_and_si256(_mm256_srli_epi32(v, 11), m5);
+                auto const mm = _mm256_and_si256(_mm256_srli_epi32(v, 5),  m6);
+                auto const s2 = _mm256_and_si256(v, m5);
+
+                // bad: no such month, day 0, or a field out of range
+                auto const zero = _mm256_setzero_si256();
+                auto bad = _mm256_or_si256(_mm256_cmpeq_epi32(fm, zero), _mm256_cmpeq_epi32(d, zero));
+                bad = _mm256_or_si256(bad, _mm256_cmpgt_epi32(hh, _mm256_set1_epi32(23)));
+                bad = _mm256_or_si256(bad, _mm256_cmpgt_epi32(mm, _mm256_set1_epi32(59)));
+                bad = _mm256_or_si256(bad, _mm256_cmpgt_epi32(s2, _mm256_set1_epi32(29)));
+
+                auto const days = _mm256_andnot_si256(bad, _mm256_sub_epi32(_mm256_add_epi32(fm, d), _mm256_set1_epi32(1)));
+                auto const tod  = _mm256_andnot_si256(bad, _mm256_add_epi32(
+                    _mm256_add_epi32(_mm256_mullo_epi32(hh, _mm256_set1_epi32(3'600)), _mm256_mullo_epi32(mm, _mm256_set1_epi32(60))),
+                    _mm256_add_epi32(s2, s2)));
+
+                auto const lo = _mm256_add_epi64(
+                    _mm256_mul_epu32(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(days)), spd),
+                    _mm256_cvtepu32_epi64(_mm256_castsi256_si128(tod)));
+                auto const hi = _mm256_add_epi64(
+                    _mm256_mul_epu32(_mm256_cvtepu32_epi64(_mm256_extracti128_si256(days, 1)), spd),
+                    _mm256_cvtepu32_epi64(_mm256_extracti128_si256(tod, 1)));
+
+                _mm256_storeu_si256(rcast<__m256i*>(out + i),     lo);
+                _mm256_storeu_si256(rcast<__m256i*>(out + i + 4), hi);
+            }
+            return i;
+        }
+    #endif
+    }
+
+    // --- FILETIME ---------------------------------------------------------------
+    // one multiply-high per element (the compiler's division by 10^7)
+    inline usize from_filetime(std::span<const u64> in, std::span<u64> out) noexcept
+    {
+        constexpr u64 epoch_ft = 116'444'736'000'000'000ULL;
+        auto const n = std::min(in.size(), out.size());
+        for (usize i = 0; i < n; ++i) {
+            u64 const ft = in[i];
+            out[i] = ft >= epoch_ft ? (ft - epoch_ft) / 10'000'000 : 0;
+        }
+        return n;
+    }
+
+    // --- DOS date/time ------------------------------------------------------------
+    // month-start table instead of the civil calendar; AVX2 gathers it eight
+    // elements at a time
+    inline usize from_dos(std::span<const u32> in, std::span<u64> out) noexcept
+    {
+        auto const n = std::min(in.size(), out.size());
+        usize i = 0;
+    #if LBYTE_STX_SIMD_AVX2
+        i = details::dos_unix_avx2(in.data(), out.data(), n);
+    #endif
+        for (; i < n; ++i)
+            out[i] = details::dos_unix(in[i]);
+        return n;
+    }
+
+    // --- NTP ------------------------------------------------------------------------
+    // subtract and clamp; the loops vectorize as written
+    inline usize from_ntp(std::span<const u32> in, std::span<u64> out) noexcept
+    {
+        constexpr u32 epoch_ntp = 2'208'988'800U;
+        auto const n = std::min(in.size(), out.size());
+        for (usize i = 0; i < n; ++i) {
+            u32 const s = in[i];
+            out[i] = s >= epoch_ntp ? s - epoch_ntp : 0;
+        }
+        return n;
+    }
+
+    // 64-bit timestamps; the fraction is discarded
+    inline usize from_ntp(std::span<const u64> in, std::span<u64> out) noexcept
+    {
+        constexpr u32 epoch_ntp = 2'208'988'800U;
+        auto const n = std::min(in.size(), out.size());
+        for (usize i = 0; i < n; ++i) {
+            u32 const s = static_cast<u32>(in[i] >> 32);
+            out[i] = s >= epoch_ntp ? s - epoch_ntp : 0;
+        }
+        return n;
+    }
 }
+
+#undef STX_FORCE_INLINE
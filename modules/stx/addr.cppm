@@ -0,0 +1,17 @@
+module;
+
+#include "lbyte/stx/addr.hpp"
+
+export module lbyte.stx.addr;
+
+import lbyte.stx.core;
+
+export namespace lbyte::stx::addr
+{
+    using ::lbyte::stx::addr::npos;
+    using ::lbyte::stx::addr::region;
+    using ::lbyte::stx::addr::map;
+
+    using ::lbyte::stx::addr::seek;
+    using ::lbyte::stx::addr::tell;
+}
@@ -0,0 +1,13 @@
+module;
+
+#include "lbyte/stx/arena.hpp"
+
+export module lbyte.stx.arena;
+
+import lbyte.stx.core;
+
+export namespace lbyte::stx::mem
+{
+    using ::lbyte::stx::mem::arena;
+    using ::lbyte::stx::mem::arena_allocator;
+}
@@ -4,6 +4,9 @@ module;
 
 export module lbyte.stx.bit;
 
+import lbyte.stx.core;
+import lbyte.stx.simd;
+
 export namespace lbyte::stx
 {
     using ::lbyte::stx::bit_extract;
@@ -18,5 +21,11 @@ export namespace lbyte::stx
     using ::lbyte::stx::byte_insert;
     using ::lbyte::stx::byte_mask;
     using ::lbyte::stx::byte_swap;
+
+    using ::lbyte::stx::unpack_bits;
+    using ::lbyte::stx::pack_bits;
+    using ::lbyte::stx::pop_bits;
+    using ::lbyte::stx::push_bits;
+    using ::lbyte::stx::bit_reader;
 }
 
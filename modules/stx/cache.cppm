@@ -0,0 +1,15 @@
+module;
+
+#include "lbyte/stx/cache.hpp"
+
+export module lbyte.stx.cache;
+
+import lbyte.stx.core;
+import lbyte.stx.io;
+
+export namespace lbyte::stx
+{
+    using ::lbyte::stx::file_key;
+    using ::lbyte::stx::map_view;
+    using ::lbyte::stx::map_cache;
+}
@@ -0,0 +1,22 @@
+module;
+
+#include "lbyte/stx/codec.hpp"
+
+export module lbyte.stx.codec;
+
+import lbyte.stx.core;
+import lbyte.stx.stream;
+
+export namespace lbyte::stx::codec
+{
+    using ::lbyte::stx::codec::input;
+    using ::lbyte::stx::codec::decoder;
+    using ::lbyte::stx::codec::lz4_frame;
+    using ::lbyte::stx::codec::wrapper;
+    using ::lbyte::stx::codec::inflate;
+}
+
+export namespace lbyte::stx::io
+{
+    using ::lbyte::stx::io::decode_source;
+}
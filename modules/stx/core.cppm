@@ -54,6 +54,9 @@ export namespace lbyte::stx
     using ::lbyte::stx::writable_buffer;
     using ::lbyte::stx::bounded_array;
     using ::lbyte::stx::buffer_type;
+    using ::lbyte::stx::byte_cursor;
+
+    using ::lbyte::stx::origin;
 
 
     using ::lbyte::stx::defer;
@@ -61,3 +64,7 @@ export namespace lbyte::stx
     using ::lbyte::stx::null;
 }
 
+export namespace lbyte::stx::io
+{
+    using ::lbyte::stx::io::origin;
+}
@@ -0,0 +1,17 @@
+module;
+
+#include "lbyte/stx/ct_fmt.hpp"
+
+export module lbyte.stx.ct.fmt;
+
+import lbyte.stx.core;
+import lbyte.stx.ct;
+
+export namespace lbyte::stx::ct
+{
+    using ::lbyte::stx::ct::fmt;
+    using ::lbyte::stx::ct::str_type;
+    using ::lbyte::stx::ct::str;
+    using ::lbyte::stx::ct::args;
+    using ::lbyte::stx::ct::formatter;
+}
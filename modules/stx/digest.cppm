@@ -0,0 +1,33 @@
+module;
+
+#include "lbyte/stx/digest.hpp"
+
+export module lbyte.stx.digest;
+
+import lbyte.stx.core;
+import lbyte.stx.io;
+import lbyte.stx.hash;
+import lbyte.stx.par;
+import lbyte.stx.simd;
+import lbyte.stx.stream;
+
+export namespace lbyte::stx::digest
+{
+    using ::lbyte::stx::digest::hw_sha256;
+    using ::lbyte::stx::digest::hw_adler32;
+    using ::lbyte::stx::digest::engine;
+    using ::lbyte::stx::digest::mergeable;
+
+    using ::lbyte::stx::digest::crc32;
+    using ::lbyte::stx::digest::crc32c;
+    using ::lbyte::stx::digest::adler32;
+    using ::lbyte::stx::digest::pe_checksum;
+    using ::lbyte::stx::digest::sha256;
+
+    using ::lbyte::stx::digest::parallel;
+    using ::lbyte::stx::digest::compute;
+    using ::lbyte::stx::digest::tree;
+    using ::lbyte::stx::digest::feed;
+    using ::lbyte::stx::digest::pe_checksum_of;
+    using ::lbyte::stx::digest::to_hex;
+}
@@ -4,6 +4,9 @@ module;
 
 export module lbyte.stx.endian;
 
+import lbyte.stx.core;
+import lbyte.stx.simd;
+
 export namespace lbyte::stx::endian
 {
     using ::lbyte::stx::endian::order;
@@ -12,4 +15,9 @@ export namespace lbyte::stx::endian
     using ::lbyte::stx::endian::le;
     using ::lbyte::stx::endian::be;
     using ::lbyte::stx::endian::is_endian_value_v;
+
+    using ::lbyte::stx::endian::convert_endian;
+    using ::lbyte::stx::endian::to_native;
+    using ::lbyte::stx::endian::decode;
+    using ::lbyte::stx::endian::encode;
 }
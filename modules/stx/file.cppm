@@ -0,0 +1,22 @@
+module;
+
+#include "lbyte/stx/file.hpp"
+
+export module lbyte.stx.file;
+
+import lbyte.stx.core;
+import lbyte.stx.io;
+
+export namespace lbyte::stx::io
+{
+    using ::lbyte::stx::io::file_mode;
+    using ::lbyte::stx::io::file;
+
+    using ::lbyte::stx::io::read_req;
+    using ::lbyte::stx::io::read_result;
+    using ::lbyte::stx::io::batch_depth;
+    using ::lbyte::stx::io::write_req;
+
+    using ::lbyte::stx::io::read;
+    using ::lbyte::stx::io::write;
+}
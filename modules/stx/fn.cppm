@@ -11,5 +11,7 @@ export namespace lbyte::stx
 {
     using ::lbyte::stx::caller_t;
     using ::lbyte::stx::caller;
+    using ::lbyte::stx::caller_table;
+    using ::lbyte::stx::caller_switch;
 }
 
@@ -0,0 +1,29 @@
+module;
+
+#include "lbyte/stx/hash.hpp"
+
+export module lbyte.stx.hash;
+
+import lbyte.stx.core;
+import lbyte.stx.ct;
+import lbyte.stx.simd;
+
+export namespace lbyte::stx::hash
+{
+    using ::lbyte::stx::hash::hw_crc32c;
+    using ::lbyte::stx::hash::hw_crc32;
+    using ::lbyte::stx::hash::byte_range;
+
+    using ::lbyte::stx::hash::fnv1a32;
+    using ::lbyte::stx::hash::fnv1a64;
+    using ::lbyte::stx::hash::xxh32;
+    using ::lbyte::stx::hash::xxh64;
+    using ::lbyte::stx::hash::crc32;
+    using ::lbyte::stx::hash::crc32c;
+    using ::lbyte::stx::hash::crc32_combine;
+    using ::lbyte::stx::hash::crc32c_combine;
+
+    using ::lbyte::stx::hash::algo;
+    using ::lbyte::stx::hash::of;
+    using ::lbyte::stx::hash::value;
+}
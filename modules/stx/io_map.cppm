@@ -0,0 +1,23 @@
+module;
+
+#include "lbyte/stx/map_file.hpp"
+
+export module lbyte.stx.io.map;
+
+import lbyte.stx.core;
+import lbyte.stx.stats;
+import lbyte.stx.io.stream;
+import lbyte.stx.io.memcur;
+
+export namespace lbyte::stx
+{
+    using ::lbyte::stx::map_flag;
+    using ::lbyte::stx::map_advice;
+    using ::lbyte::stx::map_file;
+}
+
+export namespace lbyte::stx::io
+{
+    using ::lbyte::stx::io::read;
+    using ::lbyte::stx::io::write;
+}
@@ -0,0 +1,14 @@
+module;
+
+#include "lbyte/stx/memcur.hpp"
+
+export module lbyte.stx.io.memcur;
+
+import lbyte.stx.core;
+import lbyte.stx.ct;
+import lbyte.stx.mem;
+
+export namespace lbyte::stx
+{
+    using ::lbyte::stx::memcur;
+}
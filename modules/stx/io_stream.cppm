@@ -0,0 +1,26 @@
+module;
+
+#include "lbyte/stx/io_stream.hpp"
+
+export module lbyte.stx.io.stream;
+
+import lbyte.stx.core;
+import lbyte.stx.stats;
+
+export namespace lbyte::stx
+{
+    using ::lbyte::stx::origin;
+}
+
+export namespace lbyte::stx::io
+{
+    using ::lbyte::stx::io::dirty_vector;
+    namespace pmr { using ::lbyte::stx::io::pmr::dirty_vector; }
+    using ::lbyte::stx::io::origin;
+
+    using ::lbyte::stx::io::setpos;
+    using ::lbyte::stx::io::read;
+    using ::lbyte::stx::io::advance;
+
+    using ::lbyte::stx::io::write;
+}
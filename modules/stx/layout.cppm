@@ -0,0 +1,20 @@
+module;
+
+#include "lbyte/stx/layout.hpp"
+
+export module lbyte.stx.layout;
+
+import lbyte.stx.core;
+import lbyte.stx.mem;
+import lbyte.stx.endian;
+
+export namespace lbyte::stx::layout
+{
+    using ::lbyte::stx::layout::field;
+    using ::lbyte::stx::layout::field_at;
+    using ::lbyte::stx::layout::skip;
+    using ::lbyte::stx::layout::basic_record;
+    using ::lbyte::stx::layout::record;
+    using ::lbyte::stx::layout::natural_record;
+    using ::lbyte::stx::layout::soa;
+}
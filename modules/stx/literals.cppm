@@ -7,6 +7,8 @@ export module lbyte.stx.literals;
 import lbyte.stx.core;
 import lbyte.stx.mem;
 import lbyte.stx.endian;
+import lbyte.stx.ct;
+import lbyte.stx.hash;
 
 export namespace lbyte::stx::literals
 {
@@ -35,6 +37,9 @@ export namespace lbyte::stx::literals
     using ::lbyte::stx::literals::operator""_mb;
     using ::lbyte::stx::literals::operator""_gb;
 
+    using ::lbyte::stx::literals::operator""_hash;
+    using ::lbyte::stx::literals::operator""_hash32;
+
     using ::lbyte::stx::literals::operator""_le;
     using ::lbyte::stx::literals::operator""_be;
 }
@@ -5,6 +5,8 @@ module;
 export module lbyte.stx.mem;
 
 import lbyte.stx.core;
+import lbyte.stx.ct;
+import lbyte.stx.endian;
 
 export namespace lbyte::stx
 {
@@ -17,6 +19,8 @@ export namespace lbyte::stx::mem
     using ::lbyte::stx::mem::read_raw;
     using ::lbyte::stx::mem::read_le;
     using ::lbyte::stx::mem::read_be;
+    using ::lbyte::stx::mem::read_le_n;
+    using ::lbyte::stx::mem::read_be_n;
 
     using ::lbyte::stx::mem::write;
     using ::lbyte::stx::mem::write_raw;
@@ -0,0 +1,15 @@
+module;
+
+#include "lbyte/stx/par.hpp"
+
+export module lbyte.stx.par;
+
+import lbyte.stx.core;
+import lbyte.stx.range;
+
+export namespace lbyte::stx::par
+{
+    using ::lbyte::stx::par::pool;
+    using ::lbyte::stx::par::for_options;
+    using ::lbyte::stx::par::parallel_for;
+}
@@ -0,0 +1,21 @@
+module;
+
+#include "lbyte/stx/patch.hpp"
+
+export module lbyte.stx.patch;
+
+import lbyte.stx.core;
+import lbyte.stx.io;
+import lbyte.stx.file;
+
+export namespace lbyte::stx::patch
+{
+    using ::lbyte::stx::patch::overlay;
+    using ::lbyte::stx::patch::cursor;
+}
+
+export namespace lbyte::stx::io
+{
+    using ::lbyte::stx::io::read;
+    using ::lbyte::stx::io::write;
+}
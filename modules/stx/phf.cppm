@@ -0,0 +1,18 @@
+module;
+
+#include "lbyte/stx/phf.hpp"
+
+export module lbyte.stx.phf;
+
+import lbyte.stx.core;
+import lbyte.stx.ct;
+
+export namespace lbyte::stx::ct
+{
+    using ::lbyte::stx::ct::phf_set;
+    using ::lbyte::stx::ct::phf;
+    using ::lbyte::stx::ct::phf_int_set;
+    using ::lbyte::stx::ct::phf_int;
+    using ::lbyte::stx::ct::phf_tag_set;
+    using ::lbyte::stx::ct::phf_tag;
+}
@@ -0,0 +1,23 @@
+module;
+
+#include "lbyte/stx/probe.hpp"
+
+export module lbyte.stx.probe;
+
+import lbyte.stx.core;
+import lbyte.stx.ct;
+import lbyte.stx.time;
+
+export namespace lbyte::stx::time
+{
+    using ::lbyte::stx::time::histogram;
+    using ::lbyte::stx::time::probe_site;
+    using ::lbyte::stx::time::probe;
+    using ::lbyte::stx::time::probe_summary;
+
+    using ::lbyte::stx::time::for_each_probe;
+    using ::lbyte::stx::time::summarize;
+    using ::lbyte::stx::time::probe_report;
+    using ::lbyte::stx::time::dump_probes;
+    using ::lbyte::stx::time::reset_probes;
+}
@@ -0,0 +1,14 @@
+module;
+
+#include "lbyte/stx/ring.hpp"
+
+export module lbyte.stx.ring;
+
+import lbyte.stx.core;
+
+export namespace lbyte::stx::ring
+{
+    using ::lbyte::stx::ring::kind;
+    using ::lbyte::stx::ring::spsc;
+    using ::lbyte::stx::ring::mpsc;
+}
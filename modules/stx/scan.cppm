@@ -0,0 +1,27 @@
+module;
+
+#include "lbyte/stx/scan.hpp"
+
+export module lbyte.stx.scan;
+
+import lbyte.stx.core;
+import lbyte.stx.ct;
+import lbyte.stx.par;
+
+export namespace lbyte::stx::scan
+{
+    using ::lbyte::stx::scan::npos;
+    using ::lbyte::stx::scan::signature;
+    using ::lbyte::stx::scan::pattern;
+    using ::lbyte::stx::scan::fixed_pattern;
+    using ::lbyte::stx::scan::sig;
+
+    using ::lbyte::stx::scan::find;
+    using ::lbyte::stx::scan::find_all;
+    using ::lbyte::stx::scan::for_each;
+
+    using ::lbyte::stx::scan::match;
+    using ::lbyte::stx::scan::matcher;
+
+    using ::lbyte::stx::scan::parallel;
+}
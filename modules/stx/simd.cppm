@@ -0,0 +1,23 @@
+module;
+
+#include "lbyte/stx/simd.hpp"
+
+export module lbyte.stx.simd;
+
+import lbyte.stx.core;
+
+export namespace lbyte::stx::simd
+{
+    using ::lbyte::stx::simd::isa;
+    using ::lbyte::stx::simd::native;
+    using ::lbyte::stx::simd::lanes;
+    using ::lbyte::stx::simd::mask_t;
+
+    using ::lbyte::stx::simd::eq_mask;
+    using ::lbyte::stx::simd::eq2_mask;
+    using ::lbyte::stx::simd::range_mask;
+    using ::lbyte::stx::simd::all_lanes;
+    using ::lbyte::stx::simd::first_lane;
+    using ::lbyte::stx::simd::bswap;
+    using ::lbyte::stx::simd::equal;
+}
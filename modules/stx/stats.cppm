@@ -0,0 +1,26 @@
+module;
+
+#include "lbyte/stx/stats.hpp"
+
+export module lbyte.stx.stats;
+
+import lbyte.stx.core;
+import lbyte.stx.ct;
+import lbyte.stx.time;
+import lbyte.stx.probe;
+
+export namespace lbyte::stx::stats
+{
+    using ::lbyte::stx::stats::enabled;
+    using ::lbyte::stx::stats::counter;
+    using ::lbyte::stx::stats::counter_count;
+    using ::lbyte::stx::stats::name;
+    using ::lbyte::stx::stats::snapshot;
+
+    using ::lbyte::stx::stats::add;
+    using ::lbyte::stx::stats::capture;
+    using ::lbyte::stx::stats::reset;
+    using ::lbyte::stx::stats::timer;
+    using ::lbyte::stx::stats::on_read;
+    using ::lbyte::stx::stats::on_write;
+}
@@ -0,0 +1,24 @@
+module;
+
+#include "lbyte/stx/stream.hpp"
+
+export module lbyte.stx.stream;
+
+import lbyte.stx.core;
+import lbyte.stx.io;
+import lbyte.stx.file;
+
+export namespace lbyte::stx
+{
+    using ::lbyte::stx::stream_cur;
+}
+
+export namespace lbyte::stx::io
+{
+    using ::lbyte::stx::io::byte_source;
+    using ::lbyte::stx::io::seekable_source;
+    using ::lbyte::stx::io::file_source;
+    using ::lbyte::stx::io::istream_source;
+    using ::lbyte::stx::io::span_source;
+    using ::lbyte::stx::io::readahead_source;
+}
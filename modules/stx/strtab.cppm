@@ -0,0 +1,21 @@
+module;
+
+#include "lbyte/stx/strtab.hpp"
+
+export module lbyte.stx.strtab;
+
+import lbyte.stx.core;
+import lbyte.stx.simd;
+
+export namespace lbyte::stx::strtab
+{
+    using ::lbyte::stx::strtab::charset;
+    using ::lbyte::stx::strtab::options;
+    using ::lbyte::stx::strtab::entry;
+
+    using ::lbyte::stx::strtab::for_each;
+    using ::lbyte::stx::strtab::count;
+    using ::lbyte::stx::strtab::index;
+    using ::lbyte::stx::strtab::views;
+    using ::lbyte::stx::strtab::read_strings;
+}
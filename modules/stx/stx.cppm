@@ -2,13 +2,33 @@ export module lbyte.stx;
 
 export import lbyte.stx.core;
 export import lbyte.stx.mem;
+export import lbyte.stx.arena;
 export import lbyte.stx.fn;
 export import lbyte.stx.bit;
 export import lbyte.stx.endian;
+export import lbyte.stx.layout;
+export import lbyte.stx.table;
 export import lbyte.stx.io;
+export import lbyte.stx.file;
+export import lbyte.stx.stream;
+export import lbyte.stx.cache;
 export import lbyte.stx.literals;
 export import lbyte.stx.ct;
+export import lbyte.stx.ct.fmt;
+export import lbyte.stx.phf;
+export import lbyte.stx.hash;
 export import lbyte.stx.time;
+export import lbyte.stx.probe;
+export import lbyte.stx.stats;
 export import lbyte.stx.range;
+export import lbyte.stx.simd;
+export import lbyte.stx.par;
+export import lbyte.stx.scan;
+export import lbyte.stx.strtab;
+export import lbyte.stx.digest;
+export import lbyte.stx.addr;
+export import lbyte.stx.patch;
+export import lbyte.stx.codec;
+export import lbyte.stx.ring;
 
 export namespace lbyte::stx {}
@@ -0,0 +1,16 @@
+module;
+
+#include "lbyte/stx/table.hpp"
+
+export module lbyte.stx.table;
+
+import lbyte.stx.core;
+import lbyte.stx.mem;
+import lbyte.stx.endian;
+
+export namespace lbyte::stx
+{
+    using ::lbyte::stx::table_element;
+    using ::lbyte::stx::record_view;
+    using ::lbyte::stx::table_view;
+}
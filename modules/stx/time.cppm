@@ -5,6 +5,7 @@ module;
 export module lbyte.stx.time;
 
 import lbyte.stx.core;
+import lbyte.stx.simd;
 
 export namespace lbyte::stx::time
 {
@@ -20,6 +21,11 @@ export namespace lbyte::stx::time
 
     using ::lbyte::stx::time::stopwatch;
 
+    using ::lbyte::stx::time::cycles;
+    using ::lbyte::stx::time::ns_per_cycle;
+    using ::lbyte::stx::time::cycles_to;
+    using ::lbyte::stx::time::cycle_stopwatch;
+
     using ::lbyte::stx::time::from_filetime;
     using ::lbyte::stx::time::to_filetime;
     using ::lbyte::stx::time::from_dos;
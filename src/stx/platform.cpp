@@ -0,0 +1,8 @@
+// Out-of-line OS backends for map_file, io::file and map_cache. Built into
+// the stx library when LBYTE_STX_USE_MODULES is on; header-only builds
+// include the same code inline from map_file.hpp / file.hpp / cache.hpp.
+#define LBYTE_STX_PLATFORM_INLINE
+
+#include "lbyte/stx/map_file_platform.hpp"
+#include "lbyte/stx/file_platform.hpp"
+#include "lbyte/stx/cache_platform.hpp"
@@ -10,6 +10,14 @@ option( "use_modules" )
     set_default ( false )
     set_showmenu( true  )
 
+option( "bench" )
+    set_default ( false )
+    set_showmenu( true  )
+
+option( "stats" )
+    set_default ( false )
+    set_showmenu( true  )
+
 -- ═══════════════════════════════════════════════════════════════════════════════
 -- STX — all modules
 -- ═══════════════════════════════════════════════════════════════════════════════
@@ -20,12 +28,18 @@ target("stx")
     add_headerfiles( "include/(lbyte/stx/*.hpp)" )
     add_headerfiles( "include/(lbyte/stx.hpp)"   )
 
+    if has_config( "stats" ) then
+        add_defines( "LBYTE_STX_ENABLE_STATS=1", { public = true })
+    end
+
     if has_config( "use_modules" ) then
         set_kind( "static" )
         set_policy( "build.c++.modules", true )
         add_cxflags( "-U_FORTIFY_SOURCE" )
 
         add_files( "modules/stx/*.cppm", { public = true })
+        add_files( "src/stx/*.cpp" )
+        add_defines( "LBYTE_STX_COMPILED=1", { public = true })
     else
         set_kind("headeronly")
     end
@@ -36,3 +50,15 @@ target("stx")
             target:add( "cxxmodules", "modules/stx/*.cppm" )
         end
     end)
+
+-- ═══════════════════════════════════════════════════════════════════════════════
+-- Benchmarks
+-- ═══════════════════════════════════════════════════════════════════════════════
+
+if has_config( "bench" ) then
+    target("stx_bench")
+        set_kind     ( "binary" )
+        set_languages( "cxx23"  )
+        add_deps     ( "stx"    )
+        add_files    ( "bench/stx_bench.cpp" )
+end